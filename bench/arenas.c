@@ -0,0 +1,114 @@
+/**
+ * @file Arenas.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Benchmarks traversal throughput of a buffer allocated from a
+ * huge-page-backed arena against the same buffer allocated with malloc.
+ * Both buffers are filled with one random cycle and then walked, both
+ * sequentially and by chasing the cycle, which is where TLB misses show.
+ * Usage: bench_arenas [buffer size in megabytes, default 256].
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include <diagnostic/time.h>   // Precise timing
+#include <stdio.h>             // Standard I/O functionality
+#include <stdlib.h>            // Malloc, strtoul
+#include <utilities/arenas.h>  // Huge page arenas
+#include <utilities/memory.h>  // Tracked allocations
+
+/**
+ * @brief The amount of hops taken through the random cycle per run.
+ */
+#define CHASE_HOPS (16u * 1024u * 1024u)
+
+/**
+ * @brief The state of the benchmark's random number generator.
+ */
+static uint64_t random_state = 0x9E3779B97F4A7C15ull;
+
+/**
+ * @brief Get the next random number. This is xorshift64, which is plenty
+ * for shuffling.
+ */
+static uint64_t NextRandom_(void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+/**
+ * @brief Fill a buffer with a single random cycle over all of its slots
+ * (Sattolo's algorithm), so following it touches every page in a random
+ * order.
+ */
+static void BuildCycle_(uint64_t* buffer, size_t count)
+{
+    for (size_t i = 0; i < count; i++) buffer[i] = i;
+    for (size_t i = count - 1; i > 0; i--)
+    {
+        const size_t j = (size_t)(NextRandom_() % i);
+        const uint64_t temporary = buffer[i];
+        buffer[i] = buffer[j];
+        buffer[j] = temporary;
+    }
+}
+
+/**
+ * @brief Time a sequential sum and a dependent random walk over a buffer,
+ * printing both.
+ */
+static void Traverse_(const char* label, const uint64_t* buffer,
+                      size_t count)
+{
+    uint64_t start = LetoGetTimeNs(), sum = 0;
+    for (size_t i = 0; i < count; i++) sum += buffer[i];
+    const uint64_t sequential = LetoGetTimeNs() - start;
+
+    start = LetoGetTimeNs();
+    uint64_t position = 0;
+    for (size_t i = 0; i < CHASE_HOPS; i++) position = buffer[position];
+    const uint64_t chase = LetoGetTimeNs() - start;
+
+    printf("%-8s sequential %7.2f GB/s   random chase %6.2f ns/hop  "
+           "(checksum %llx)\n",
+           label, (double)(count * sizeof(uint64_t)) / (double)sequential,
+           (double)chase / CHASE_HOPS,
+           (unsigned long long)(sum ^ position));
+}
+
+int main(int argc, char** argv)
+{
+    const size_t megabytes = argc > 1 ? strtoul(argv[1], NULL, 10) : 256;
+    const size_t size = megabytes * 1024 * 1024,
+                 count = size / sizeof(uint64_t);
+
+    uint64_t* heap_buffer = LetoMalloc(memory_general, size);
+    BuildCycle_(heap_buffer, count);
+    Traverse_("malloc", heap_buffer, count);
+    LetoFree(heap_buffer);
+
+    random_state = 0x9E3779B97F4A7C15ull;
+    arena_t* arena = LetoCreateArena(memory_general, size);
+    uint64_t* arena_buffer = LetoArenaAllocate(arena, size, 64);
+    BuildCycle_(arena_buffer, count);
+    Traverse_("arena", arena_buffer, count);
+
+    arena_stats_t stats;
+    LetoGetArenaStats(arena, &stats);
+    printf("arena: %zu MB committed, %zu MB backed by huge pages\n",
+           stats.committed / (1024 * 1024),
+           stats.huge_backed / (1024 * 1024));
+    LetoDestroyArena(arena);
+
+    return 0;
+}
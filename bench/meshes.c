@@ -0,0 +1,224 @@
+/**
+ * @file Meshes.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Benchmarks the Wavefront OBJ importer on a generated,
+ * Blender-style terrain grid. Parsing and welding are timed with one to
+ * eight threads; the file is built in memory so nothing else is. Each
+ * stage of the rest of the import pipeline is then timed on its own,
+ * and the mesh is exported to a container that must load back the same.
+ * Usage: bench_meshes [triangle count in millions, default 1] [path to
+ * also write the generated file to].
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include <diagnostic/time.h>      // Precise timing
+#include <io/files.h>             // Writing the generated file
+#include <math.h>                 // Sine, cosine, square root
+#include <resources/bounds.h>     // Bounding volumes
+#include <resources/meshes.h>     // The parser being measured
+#include <resources/meshlets.h>   // Meshlet partitioning
+#include <resources/models.h>     // Model containers
+#include <resources/optimizer.h>  // Triangle and vertex reordering
+#include <resources/simplifier.h> // LOD chain generation
+#include <resources/tangents.h>   // Tangent generation
+#include <stdio.h>                // Standard I/O, remove
+#include <stdlib.h>               // Strtod
+#include <utilities/memory.h>     // Tracked allocations
+
+/**
+ * @brief The amount of times the file is parsed. The best run is kept.
+ */
+#define BENCHMARK_RUNS 5
+
+/**
+ * @brief The most threads the parse is measured with. Each run doubles
+ * the thread count, starting at one.
+ */
+#define MAX_THREADS 8
+
+/**
+ * @brief The most bytes a single generated line can take.
+ */
+#define MAX_LINE_LENGTH 64
+
+/**
+ * @brief The stages of the import pipeline run after parsing, in the
+ * order @ref LetoProcessMesh runs them.
+ */
+typedef enum
+{
+    stage_tangents,
+    stage_optimize,
+    stage_lods,
+    stage_meshlets,
+    stage_bounds,
+    stage_count
+} stage_t;
+
+/**
+ * @brief The name of each stage, for the report.
+ */
+static const char* const stage_names[stage_count] = {
+    "tangents", "optimize", "lods", "meshlets", "bounds"};
+
+/**
+ * @brief Where the round-tripped container is written, and removed from
+ * afterward.
+ */
+#define CONTAINER_PATH "bench_meshes.lmsh"
+
+/**
+ * @brief The format of a generated triangle.
+ */
+#define FACE_FORMAT "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n"
+
+/**
+ * @brief Build an OBJ file describing a rolling terrain grid with the
+ * requested amount of triangles, formatted like Blender's exporter.
+ */
+static char* GenerateGrid_(size_t triangles, size_t* size)
+{
+    const size_t side = (size_t)sqrt((double)triangles / 2.0) + 1,
+                 cells = (side - 1) * (side - 1);
+    const size_t capacity =
+        (side * side * 3 + cells * 2) * MAX_LINE_LENGTH;
+    char* buffer = LetoMalloc(memory_general, capacity);
+    char* cursor = buffer;
+
+    for (size_t z = 0; z < side; z++)
+        for (size_t x = 0; x < side; x++)
+            cursor += sprintf(cursor, "v %f %f %f\n", (double)x * 0.5,
+                              sin((double)x * 0.1) * cos((double)z * 0.1),
+                              (double)z * -0.5);
+    for (size_t z = 0; z < side; z++)
+        for (size_t x = 0; x < side; x++)
+            cursor += sprintf(cursor, "vn %.4f %.4f %.4f\n",
+                              -0.1 * cos((double)x * 0.1), 0.9899,
+                              0.1 * sin((double)z * 0.1));
+    for (size_t z = 0; z < side; z++)
+        for (size_t x = 0; x < side; x++)
+            cursor += sprintf(cursor, "vt %f %f\n",
+                              (double)x / (double)(side - 1),
+                              (double)z / (double)(side - 1));
+
+    for (size_t z = 0; z + 1 < side; z++)
+    {
+        for (size_t x = 0; x + 1 < side; x++)
+        {
+            const size_t a = z * side + x + 1, b = a + 1, c = a + side,
+                         d = c + 1;
+            cursor +=
+                sprintf(cursor, FACE_FORMAT, a, a, a, c, c, c, b, b, b);
+            cursor +=
+                sprintf(cursor, FACE_FORMAT, b, b, b, c, c, c, d, d, d);
+        }
+    }
+
+    *size = (size_t)(cursor - buffer);
+    return buffer;
+}
+
+int main(int argc, char** argv)
+{
+    const double millions = argc > 1 ? strtod(argv[1], NULL) : 1.0;
+    size_t size;
+    char* buffer = GenerateGrid_((size_t)(millions * 1e6), &size);
+
+    if (argc > 2)
+    {
+        file_t* file = LetoOpenFile(w, argv[2]);
+        LetoWriteFile(file, (uint8_t*)buffer, size);
+        LetoCloseFile(file);
+    }
+
+    for (size_t threads = 1; threads <= MAX_THREADS; threads *= 2)
+    {
+        uint64_t best = UINT64_MAX;
+        size_t faces = 0;
+        for (int i = 0; i < BENCHMARK_RUNS; i++)
+        {
+            const uint64_t start = LetoGetTimeNs();
+            mesh_t* mesh = LetoParseMesh("grid", buffer, size, threads);
+            const uint64_t elapsed = LetoGetTimeNs() - start;
+
+            if (mesh == NULL) return 1;
+            faces = LetoGetDetailIndexCount(mesh) / 3;
+            LetoUnloadMesh(mesh);
+            if (elapsed < best) best = elapsed;
+        }
+
+        printf("%zu thread(s): parsed %.1f MB, %zu triangles in %.2f "
+               "ms: %.0f MB/s\n",
+               threads, (double)size / 1e6, faces, (double)best / 1e6,
+               (double)size * 1e3 / (double)best);
+    }
+
+    // Every stage changes the mesh, so each run starts from a fresh
+    // parse, which isn't timed.
+    uint64_t stages[stage_count];
+    for (size_t i = 0; i < stage_count; i++) stages[i] = UINT64_MAX;
+    for (int i = 0; i < BENCHMARK_RUNS; i++)
+    {
+        mesh_t* mesh = LetoParseMesh("grid", buffer, size, 0);
+        if (mesh == NULL) return 1;
+
+        for (size_t stage = 0; stage < stage_count; stage++)
+        {
+            const uint64_t start = LetoGetTimeNs();
+            switch (stage)
+            {
+                case stage_tangents: LetoGenerateTangents(mesh); break;
+                case stage_optimize: LetoOptimizeMesh(mesh, NULL); break;
+                case stage_lods:
+                    LetoGenerateLODs(mesh, MESH_LOD_LEVELS,
+                                     MESH_LOD_RATIO);
+                    break;
+                case stage_meshlets: LetoBuildMeshlets(mesh); break;
+                default:             LetoComputeBounds(mesh); break;
+            }
+            const uint64_t elapsed = LetoGetTimeNs() - start;
+            if (elapsed < stages[stage]) stages[stage] = elapsed;
+        }
+        LetoUnloadMesh(mesh);
+    }
+
+    for (size_t i = 0; i < stage_count; i++)
+        printf("%-8s %10.2f ms\n", stage_names[i],
+               (double)stages[i] / 1e6);
+
+    // The container written at import has to load back as the mesh it
+    // was written from.
+    mesh_t* mesh = LetoParseMesh("grid", buffer, size, 0);
+    if (mesh == NULL) return 1;
+    mesh_optimization_t report;
+    LetoProcessMesh(mesh, &report);
+    printf("ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+           (double)report.before.acmr, (double)report.after.acmr,
+           (double)report.before.atvr, (double)report.after.atvr);
+
+    const uint64_t start = LetoGetTimeNs();
+    const bool exported = LetoExportModel(mesh, CONTAINER_PATH);
+    const uint64_t elapsed = LetoGetTimeNs() - start;
+    const bool verified =
+        exported && LetoVerifyModel(mesh, CONTAINER_PATH);
+    printf("export   %10.2f ms, %s container %s\n",
+           (double)elapsed / 1e6,
+           LetoPickVertexFormat(mesh) == model_vertex_quantized
+               ? "quantized"
+               : "float",
+           verified ? "matches" : "DOES NOT MATCH");
+    (void)remove(CONTAINER_PATH);
+    LetoUnloadMesh(mesh);
+
+    LetoFree(buffer);
+    return verified ? 0 : 1;
+}
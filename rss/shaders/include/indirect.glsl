@@ -0,0 +1,15 @@
+// The per-draw data of indirect draws, laid out as indirect_draw_t. A
+// multi-draw binds every draw's data at once, and each draw finds its own
+// by gl_DrawID, its index within the multi-draw.
+struct IndirectDraw
+{
+    mat4 transform;
+    vec4 minimum;
+    vec4 maximum;
+    uint material;
+};
+
+layout (std430, binding = 0) readonly buffer IndirectDraws
+{
+    IndirectDraw indirect_draws[];
+};
@@ -0,0 +1,27 @@
+// The keywords of a shader permutation as booleans, so one source serves
+// both ways a shader is built. Compiled from GLSL, each is a constant
+// folded from the define the preprocessor gives set keywords. Precompiled
+// to SPIR-V, each is a specialization constant whose ID is the bit index
+// of its keyword, set when the stage is specialized. Sources branch on
+// these with plain ifs, which compile away either way.
+#ifdef GL_SPIRV
+layout(constant_id = 0) const bool KEYWORD_SKINNED = false;
+layout(constant_id = 1) const bool KEYWORD_FOG = false;
+layout(constant_id = 2) const bool KEYWORD_INSTANCED = false;
+#else
+    #ifdef SKINNED
+const bool KEYWORD_SKINNED = true;
+    #else
+const bool KEYWORD_SKINNED = false;
+    #endif
+    #ifdef FOG
+const bool KEYWORD_FOG = true;
+    #else
+const bool KEYWORD_FOG = false;
+    #endif
+    #ifdef INSTANCED
+const bool KEYWORD_INSTANCED = true;
+    #else
+const bool KEYWORD_INSTANCED = false;
+    #endif
+#endif
@@ -0,0 +1,11 @@
+// Unfolds a normal stored as a point on an octahedron that's been
+// flattened into the unit square, as models.c encodes them.
+vec3 DecodeOctahedral(vec2 encoded)
+{
+    vec3 decoded =
+        vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float fold = max(-decoded.z, 0.0);
+    decoded.x += decoded.x >= 0.0 ? -fold : fold;
+    decoded.y += decoded.y >= 0.0 ? -fold : fold;
+    return normalize(decoded);
+}
@@ -0,0 +1,12 @@
+#version 460 core
+out vec4 FragColor;
+
+in vec3 normal;
+in vec2 texture_coordinate;
+in vec4 tangent;
+flat in uint material;
+
+void main()
+{
+    FragColor = vec4(normalize(normal) * 0.5 + 0.5, 1.0);
+}
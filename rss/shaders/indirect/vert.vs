@@ -0,0 +1,33 @@
+#version 460 core
+// Offline SPIR-V builds resolve includes in glslang, which wants them
+// asked for; at runtime Leto's own preprocessor resolves them instead.
+#ifdef GL_SPIRV
+#extension GL_GOOGLE_include_directive : require
+#endif
+// Draws model_quantized_vertex_t vertices packed into a mega-buffer by
+// multi-draw. What the quantized shader takes as uniforms, each draw
+// reads from its own IndirectDraw instead.
+layout (location = 0) in vec3 vertex_position;
+layout (location = 1) in vec2 vertex_normal;
+layout (location = 2) in vec2 vertex_texture;
+layout (location = 3) in vec4 vertex_tangent;
+
+out vec3 normal;
+out vec2 texture_coordinate;
+out vec4 tangent;
+flat out uint material;
+
+#include "indirect.glsl"
+#include "octahedral.glsl"
+
+void main()
+{
+    IndirectDraw draw = indirect_draws[gl_DrawID];
+    vec3 position = mix(draw.minimum.xyz, draw.maximum.xyz, vertex_position);
+    gl_Position = draw.transform * vec4(position, 1.0);
+
+    normal = DecodeOctahedral(vertex_normal);
+    texture_coordinate = vertex_texture;
+    tangent = vertex_tangent;
+    material = draw.material;
+}
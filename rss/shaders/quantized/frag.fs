@@ -0,0 +1,11 @@
+#version 430 core
+out vec4 FragColor;
+
+in vec3 normal;
+in vec2 texture_coordinate;
+in vec4 tangent;
+
+void main()
+{
+    FragColor = vec4(normalize(normal) * 0.5 + 0.5, 1.0);
+}
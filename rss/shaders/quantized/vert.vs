@@ -0,0 +1,34 @@
+#version 430 core
+// Offline SPIR-V builds resolve includes in glslang, which wants them
+// asked for; at runtime Leto's own preprocessor resolves them instead.
+#ifdef GL_SPIRV
+#extension GL_GOOGLE_include_directive : require
+#endif
+// Decodes model_quantized_vertex_t vertices. The vertex format already
+// turns every attribute into floats; positions still need scaling back
+// out of the model's bounds, and normals unfolding off the octahedron.
+layout (location = 0) in vec3 vertex_position;
+layout (location = 1) in vec2 vertex_normal;
+layout (location = 2) in vec2 vertex_texture;
+layout (location = 3) in vec4 vertex_tangent;
+
+// Set by location, as SPIR-V builds needn't keep uniform names; these
+// match MODEL_MINIMUM_LOCATION and MODEL_MAXIMUM_LOCATION.
+layout (location = 0) uniform vec3 model_minimum;
+layout (location = 1) uniform vec3 model_maximum;
+
+out vec3 normal;
+out vec2 texture_coordinate;
+out vec4 tangent;
+
+#include "octahedral.glsl"
+
+void main()
+{
+    vec3 position = mix(model_minimum, model_maximum, vertex_position);
+    gl_Position = vec4(position, 1.0);
+
+    normal = DecodeOctahedral(vertex_normal);
+    texture_coordinate = vertex_texture;
+    tangent = vertex_tangent;
+}
@@ -43,6 +43,23 @@ void LetoGetTimeRaw(uint64_t* ms)
 #endif
 }
 
+uint64_t LetoGetTimeNs(void)
+{
+#if defined(__LETO__LINUX__)
+    struct timespec retrieved_time;
+    if (clock_gettime(CLOCK_MONOTONIC, &retrieved_time) == -1)
+        LetoReport(time_error);
+    return (uint64_t)retrieved_time.tv_sec * 1000000000ull +
+           (uint64_t)retrieved_time.tv_nsec;
+#elif defined(__LETO__WINDOWS__)
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (uint64_t)((double)counter.QuadPart * 1e9 /
+                      (double)frequency.QuadPart);
+#endif
+}
+
 static void FormatTimeString_(timestamp_t* storage)
 {
     if (storage == NULL) return;
@@ -35,6 +35,12 @@ typedef struct
     (timestamp_t) { NULL, full, 0, 0, 0 }
 
 void LetoGetTimeRaw(uint64_t* ms);
+
+/**
+ * @brief Get a monotonic timestamp in nanoseconds. The starting point is
+ * arbitrary, so this is only good for measuring intervals.
+ */
+uint64_t LetoGetTimeNs(void);
 void LetoGetTimestamp(timestamp_t* storage, timestamp_format_t format);
 
 #endif // __LETO__TIME__
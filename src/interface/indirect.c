@@ -0,0 +1,282 @@
+/**
+ * @file Indirect.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Indirect.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "indirect.h"         // Public interface parent
+#include "state.h"            // OpenGL state shadow
+#include <gl.h>               // OpenGL function pointers
+#include <io/reporter.h>      // Error / warning reporter
+#include <string.h>           // Memcpy
+#include <utilities/memory.h> // Tracked allocations
+
+// OpenGL reads commands straight out of the buffer, and shaders read the
+// stock per-draw data as std430, so neither layout may drift.
+_Static_assert(sizeof(indirect_command_t) == 20,
+               "indirect command layout");
+_Static_assert(sizeof(indirect_draw_t) == 112, "indirect draw layout");
+
+/**
+ * @brief Get the size in bytes of an index of an OpenGL index type.
+ */
+static size_t IndexSize_(unsigned int index_type)
+{
+    return index_type == GL_UNSIGNED_SHORT ? sizeof(uint16_t)
+                                           : sizeof(uint32_t);
+}
+
+/**
+ * @brief Claim room for streams within a mega-buffer, reporting whether
+ * there was any.
+ */
+static bool Claim_(mega_buffer_t* geometry, size_t vertex_count,
+                   size_t index_count, mega_range_t* range)
+{
+    const size_t vertex_room =
+        geometry->vertex_capacity - geometry->vertex_count;
+    const size_t index_room =
+        geometry->index_capacity - geometry->index_count;
+    if (vertex_count > vertex_room || index_count > index_room)
+    {
+        LetoReport(array_full);
+        return false;
+    }
+
+    range->first_index = (uint32_t)geometry->index_count;
+    range->base_vertex = (int32_t)geometry->vertex_count;
+    geometry->vertex_count += vertex_count;
+    geometry->index_count += index_count;
+    return true;
+}
+
+mega_buffer_t* LetoCreateMegaBuffer(model_vertex_format_t vertex_format,
+                                    unsigned int index_type,
+                                    size_t vertex_capacity,
+                                    size_t index_capacity)
+{
+    mega_buffer_t* geometry =
+        LetoCalloc(memory_renderer, 1, sizeof(mega_buffer_t));
+    geometry->vertex_format = vertex_format;
+    geometry->index_type = index_type;
+    geometry->vertex_capacity = vertex_capacity;
+    geometry->index_capacity = index_capacity;
+
+    // Models are copied in on the GPU, which immutable storage takes
+    // without flags; packing from memory needs dynamic storage.
+    const size_t stride = LetoGetVertexStride(vertex_format);
+    glCreateBuffers(1, &geometry->vertex_buffer);
+    glNamedBufferStorage(geometry->vertex_buffer,
+                         (GLsizeiptr)(vertex_capacity * stride), NULL,
+                         GL_DYNAMIC_STORAGE_BIT);
+    glCreateBuffers(1, &geometry->index_buffer);
+    glNamedBufferStorage(
+        geometry->index_buffer,
+        (GLsizeiptr)(index_capacity * IndexSize_(index_type)), NULL,
+        GL_DYNAMIC_STORAGE_BIT);
+
+    glCreateVertexArrays(1, &geometry->vertex_array);
+    glVertexArrayVertexBuffer(geometry->vertex_array, 0,
+                              geometry->vertex_buffer, 0, (GLsizei)stride);
+    glVertexArrayElementBuffer(geometry->vertex_array,
+                               geometry->index_buffer);
+    (void)LetoDescribeModelVertices(geometry->vertex_array, vertex_format,
+                                    0);
+    return geometry;
+}
+
+void LetoDestroyMegaBuffer(mega_buffer_t* geometry)
+{
+    if (geometry == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    LetoForgetGLObject(gl_state_vertex_array, geometry->vertex_array);
+    LetoForgetGLObject(gl_state_buffer, geometry->vertex_buffer);
+    LetoForgetGLObject(gl_state_buffer, geometry->index_buffer);
+    glDeleteVertexArrays(1, &geometry->vertex_array);
+    glDeleteBuffers(1, &geometry->vertex_buffer);
+    glDeleteBuffers(1, &geometry->index_buffer);
+    LetoFree(geometry);
+}
+
+bool LetoPackModel(mega_buffer_t* geometry, const model_t* model,
+                   mega_range_t* range)
+{
+    if (geometry == NULL || model == NULL || range == NULL)
+    {
+        LetoReport(null_param);
+        return false;
+    }
+    if (model->vertex_format != geometry->vertex_format ||
+        model->index_type != geometry->index_type)
+    {
+        LetoReport(invalid_param);
+        return false;
+    }
+
+    const size_t stride = LetoGetVertexStride(geometry->vertex_format);
+    const size_t index_size = IndexSize_(geometry->index_type);
+    if (!Claim_(geometry, model->vertex_count, model->index_count, range))
+        return false;
+
+    glCopyNamedBufferSubData(
+        model->vertex_buffer, geometry->vertex_buffer, 0,
+        (GLintptr)((size_t)range->base_vertex * stride),
+        (GLsizeiptr)(model->vertex_count * stride));
+    glCopyNamedBufferSubData(
+        model->index_buffer, geometry->index_buffer, 0,
+        (GLintptr)(range->first_index * index_size),
+        (GLsizeiptr)(model->index_count * index_size));
+    return true;
+}
+
+bool LetoPackVertices(mega_buffer_t* geometry, const void* vertices,
+                      size_t vertex_count, const void* indices,
+                      size_t index_count, mega_range_t* range)
+{
+    if (geometry == NULL || vertices == NULL || indices == NULL ||
+        range == NULL)
+    {
+        LetoReport(null_param);
+        return false;
+    }
+
+    const size_t stride = LetoGetVertexStride(geometry->vertex_format);
+    const size_t index_size = IndexSize_(geometry->index_type);
+    if (!Claim_(geometry, vertex_count, index_count, range)) return false;
+
+    glNamedBufferSubData(geometry->vertex_buffer,
+                         (GLintptr)((size_t)range->base_vertex * stride),
+                         (GLsizeiptr)(vertex_count * stride), vertices);
+    glNamedBufferSubData(geometry->index_buffer,
+                         (GLintptr)(range->first_index * index_size),
+                         (GLsizeiptr)(index_count * index_size), indices);
+    return true;
+}
+
+indirect_bucket_t* LetoCreateIndirectBucket(uint32_t pass,
+                                            shader_t* shader,
+                                            const mega_buffer_t* geometry,
+                                            size_t draw_size)
+{
+    if (shader == NULL || geometry == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+
+    indirect_bucket_t* bucket =
+        LetoCalloc(memory_renderer, 1, sizeof(indirect_bucket_t));
+    bucket->pass = pass;
+    bucket->shader = shader;
+    bucket->geometry = geometry;
+    bucket->draw_size = draw_size;
+    return bucket;
+}
+
+void LetoDestroyIndirectBucket(indirect_bucket_t* bucket)
+{
+    if (bucket == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    LetoFree(bucket->commands);
+    LetoFree(bucket->draws);
+    LetoFree(bucket);
+}
+
+void LetoSubmitIndirect(indirect_bucket_t* bucket,
+                        const indirect_command_t* command,
+                        const void* draw)
+{
+    if (bucket == NULL || command == NULL ||
+        (draw == NULL && bucket->draw_size != 0))
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    if (bucket->count == bucket->capacity)
+    {
+        bucket->capacity = bucket->capacity == 0 ? INDIRECT_MINIMUM
+                                                 : bucket->capacity * 2;
+        const size_t size = bucket->capacity * sizeof(indirect_command_t);
+        bucket->commands = bucket->commands == NULL
+                               ? LetoMalloc(memory_renderer, size)
+                               : LetoRealloc(bucket->commands, size);
+        if (bucket->draw_size != 0)
+        {
+            const size_t draws_size = bucket->capacity * bucket->draw_size;
+            bucket->draws = bucket->draws == NULL
+                                ? LetoMalloc(memory_renderer, draws_size)
+                                : LetoRealloc(bucket->draws, draws_size);
+        }
+    }
+
+    bucket->commands[bucket->count] = *command;
+    if (bucket->draw_size != 0)
+        (void)memcpy(bucket->draws + bucket->count * bucket->draw_size,
+                     draw, bucket->draw_size);
+    bucket->count++;
+}
+
+void LetoExecuteIndirectBucket(const indirect_bucket_t* bucket,
+                               ring_buffer_t* ring)
+{
+    if (bucket == NULL || ring == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+    if (bucket->count == 0) return;
+
+    // Indirect offsets need only be a multiple of four.
+    ring_allocation_t commands, draws = {0};
+    if (!LetoUploadRing(ring, bucket->commands,
+                        bucket->count * sizeof(indirect_command_t),
+                        sizeof(uint32_t), &commands))
+        return;
+    if (bucket->draw_size != 0 &&
+        !LetoUploadRing(ring, bucket->draws,
+                        bucket->count * bucket->draw_size, 0, &draws))
+        return;
+
+    LetoUseShader(bucket->shader);
+    LetoBindVertexArray(bucket->geometry->vertex_array);
+    LetoBindBuffer(GL_DRAW_INDIRECT_BUFFER, commands.buffer);
+    if (bucket->draw_size != 0)
+        LetoBindBufferRange(GL_SHADER_STORAGE_BUFFER,
+                            INDIRECT_DRAW_BINDING, draws.buffer,
+                            draws.offset, draws.size);
+
+    glMultiDrawElementsIndirect(
+        GL_TRIANGLES, bucket->geometry->index_type,
+        (const void*)(uintptr_t)commands.offset, (GLsizei)bucket->count,
+        sizeof(indirect_command_t));
+}
+
+void LetoClearIndirectBucket(indirect_bucket_t* bucket)
+{
+    if (bucket == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+    bucket->count = 0;
+}
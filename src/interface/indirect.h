@@ -0,0 +1,375 @@
+/**
+ * @file Indirect.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides Leto's GPU-driven rendering path, for drawing thousands
+ * of objects without a draw call each. Models are packed into shared
+ * vertex and index mega-buffers, one for each vertex layout and index
+ * type, so every object packed into one draws from the same vertex
+ * array. Draws are gathered into buckets of the same pass, shader and
+ * mega-buffer; each frame a bucket's DrawElementsIndirectCommand records
+ * and per-draw data are copied into the renderer's ring buffer, and the
+ * whole bucket goes out as a single glMultiDrawElementsIndirect. Shaders
+ * read a draw's data from the storage buffer at @ref
+ * INDIRECT_DRAW_BINDING by gl_DrawID, see
+ * rss/shaders/include/indirect.glsl.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__INDIRECT__
+#define __LETO__INDIRECT__
+
+// The boolean type as described by the C standard.
+#include <stdbool.h>
+// Standard macro definitions, like size_t.
+#include <stddef.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+// The ring buffer draws are uploaded through.
+#include <interface/ring.h>
+// CGLM's matrix and vector types.
+#include <mat4.h>
+#include <vec4.h>
+// Models, and the vertex layouts mega-buffers hold.
+#include <resources/models.h>
+// Shaders, which buckets draw with.
+#include <resources/shaders.h>
+
+/**
+ * @brief The storage buffer binding a bucket's per-draw data is bound to.
+ */
+#define INDIRECT_DRAW_BINDING 0
+
+/**
+ * @brief The smallest amount of draws a bucket has room for, once it has
+ * any.
+ */
+#define INDIRECT_MINIMUM 64
+
+/**
+ * @brief A draw as glMultiDrawElementsIndirect reads it, the layout of
+ * OpenGL's DrawElementsIndirectCommand.
+ */
+typedef struct
+{
+    uint32_t index_count;
+    uint32_t instance_count;
+    /**
+     * @brief The first index of the draw within the mega-buffer.
+     */
+    uint32_t first_index;
+    int32_t base_vertex;
+    uint32_t base_instance;
+} indirect_command_t;
+
+/**
+ * @brief The per-draw data of the stock indirect shader,
+ * rss/shaders/indirect, laid out as its IndirectDraw block in std430.
+ */
+typedef struct
+{
+    /**
+     * @brief The column-major matrix taking the model's positions into
+     * clip space.
+     */
+    mat4 transform;
+    /**
+     * @brief The model's bounds, which its quantized positions are
+     * scaled back out of. The fourth component is unused.
+     */
+    vec4 minimum;
+    vec4 maximum;
+    /**
+     * @brief The library index of the draw's material.
+     */
+    uint32_t material;
+    uint32_t reserved[3];
+} indirect_draw_t;
+
+/**
+ * @brief Vertex and index buffers shared by every model packed into them.
+ */
+typedef struct
+{
+    /**
+     * @brief The OpenGL vertex array reading both buffers.
+     */
+    unsigned int vertex_array;
+    unsigned int vertex_buffer;
+    unsigned int index_buffer;
+    /**
+     * @brief The layout of every vertex packed, and the OpenGL type of
+     * every index.
+     */
+    model_vertex_format_t vertex_format;
+    unsigned int index_type;
+    /**
+     * @brief The amount of vertices and indices packed, and the most of
+     * each the buffers have room for.
+     */
+    size_t vertex_count;
+    size_t vertex_capacity;
+    size_t index_count;
+    size_t index_capacity;
+} mega_buffer_t;
+
+/**
+ * @brief Where a model's streams landed within a mega-buffer. A run of
+ * its indices, like a submesh or LOD level, is drawn from first_index
+ * plus the run's own first index, with base_vertex.
+ */
+typedef struct
+{
+    uint32_t first_index;
+    int32_t base_vertex;
+} mega_range_t;
+
+/**
+ * @brief The draws of a pass made with the same shader from the same
+ * mega-buffer, which go out as one multi-draw.
+ */
+typedef struct
+{
+    uint32_t pass;
+    shader_t* shader;
+    const mega_buffer_t* geometry;
+    /**
+     * @brief The size of each draw's data in bytes, like
+     * sizeof(indirect_draw_t), or 0 for draws without any.
+     */
+    size_t draw_size;
+    indirect_command_t* commands;
+    uint8_t* draws;
+    size_t count;
+    size_t capacity;
+} indirect_bucket_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Create a mega-buffer. Its storage is allocated up front, and
+ * never grows, so that ranges handed out stay valid. A GL context must be
+ * current.
+ *
+ * PARAMETERS
+ *
+ * @param vertex_format The layout of the vertices it holds.
+ * @param index_type The type of the indices it holds, GL_UNSIGNED_SHORT
+ * or GL_UNSIGNED_INT.
+ * @param vertex_capacity The most vertices it can hold.
+ * @param index_capacity The most indices it can hold.
+ *
+ * RETURN VALUE
+ *
+ * @return The mega-buffer, to be freed with @ref LetoDestroyMegaBuffer.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+mega_buffer_t* LetoCreateMegaBuffer(model_vertex_format_t vertex_format,
+                                    unsigned int index_type,
+                                    size_t vertex_capacity,
+                                    size_t index_capacity);
+
+/**
+ * @brief Free a mega-buffer. Nothing may draw from it anymore.
+ */
+void LetoDestroyMegaBuffer(mega_buffer_t* geometry);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Pack a loaded model's streams into a mega-buffer. They're
+ * copied from buffer to buffer on the GPU, so the model can be unloaded
+ * afterward. A separate tangent stream, which only full-precision models
+ * have, isn't packed; quantized models carry theirs in their vertices.
+ *
+ * PARAMETERS
+ *
+ * @param geometry The mega-buffer.
+ * @param model The model, of the mega-buffer's vertex layout and index
+ * type.
+ * @param range Where the model's streams landed.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the model was packed.
+ *
+ * WARNINGS
+ *
+ * Three warnings can be thrown by this function.
+ * @warning null_param -- If any parameter is NULL, this warning is thrown
+ * and false is returned.
+ * @warning invalid_param -- If the model's layout or index type differs
+ * from the mega-buffer's, this warning is thrown and false is returned.
+ * @warning array_full -- If the mega-buffer hasn't room for the model,
+ * this warning is thrown and false is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+bool LetoPackModel(mega_buffer_t* geometry, const model_t* model,
+                   mega_range_t* range);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Pack vertices and indices from memory into a mega-buffer, like
+ * @ref LetoPackModel does a model's.
+ *
+ * PARAMETERS
+ *
+ * @param geometry The mega-buffer.
+ * @param vertices The vertices, in the mega-buffer's layout.
+ * @param vertex_count The amount of vertices.
+ * @param indices The indices, of the mega-buffer's index type.
+ * @param index_count The amount of indices.
+ * @param range Where the streams landed.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the streams were packed.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If any pointer is NULL, this warning is thrown
+ * and false is returned.
+ * @warning array_full -- If the mega-buffer hasn't room for the streams,
+ * this warning is thrown and false is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+bool LetoPackVertices(mega_buffer_t* geometry, const void* vertices,
+                      size_t vertex_count, const void* indices,
+                      size_t index_count, mega_range_t* range);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Create a bucket of indirect draws.
+ *
+ * PARAMETERS
+ *
+ * @param pass The pass the draws belong to.
+ * @param shader The shader the draws are made with.
+ * @param geometry The mega-buffer the draws are made from.
+ * @param draw_size The size of each draw's data in bytes, or 0.
+ *
+ * RETURN VALUE
+ *
+ * @return The bucket, to be freed with @ref LetoDestroyIndirectBucket,
+ * or NULL if something went wrong.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the shader or mega-buffer is NULL, this
+ * warning is thrown and NULL is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+indirect_bucket_t* LetoCreateIndirectBucket(uint32_t pass,
+                                            shader_t* shader,
+                                            const mega_buffer_t* geometry,
+                                            size_t draw_size);
+
+/**
+ * @brief Free a bucket and the draws within it.
+ */
+void LetoDestroyIndirectBucket(indirect_bucket_t* bucket);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Add a draw to a bucket. Both the command and the data are
+ * copied, so neither need outlive the call.
+ *
+ * PARAMETERS
+ *
+ * @param bucket The bucket.
+ * @param command The draw, relative to the bucket's mega-buffer.
+ * @param draw The draw's data, @ref indirect_bucket_t.draw_size bytes,
+ * or NULL if the bucket's draws have none.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the bucket or command is NULL, or the draw is
+ * NULL when it should have data, this warning is thrown and nothing is
+ * done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoSubmitIndirect(indirect_bucket_t* bucket,
+                        const indirect_command_t* command,
+                        const void* draw);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Draw every draw in a bucket with one multi-draw. The commands
+ * and draw data are uploaded into the ring buffer's frame, so they cost
+ * a copy each and no GL calls; the GL calls made are the same however
+ * many draws there are.
+ *
+ * PARAMETERS
+ *
+ * @param bucket The bucket.
+ * @param ring The ring buffer, within a frame.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the bucket or ring is NULL, this warning is
+ * thrown and nothing is done.
+ * @note For warnings unhandled by this function, see @ref
+ * LetoAllocateRing; a bucket that doesn't fit isn't drawn.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoExecuteIndirectBucket(const indirect_bucket_t* bucket,
+                               ring_buffer_t* ring);
+
+/**
+ * @brief Empty a bucket for the next frame, keeping its storage.
+ */
+void LetoClearIndirectBucket(indirect_bucket_t* bucket);
+
+#endif // __LETO__INDIRECT__
@@ -0,0 +1,341 @@
+/**
+ * @file Queue.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Queue.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "queue.h"            // Public interface parent
+#include "state.h"            // OpenGL state shadow
+#include <gl.h>               // OpenGL function pointers
+#include <io/reporter.h>      // Error / warning reporter
+#include <string.h>           // Memcpy
+#include <utilities/memory.h> // Tracked allocations
+
+/**
+ * @brief The bits the radix sort takes from a key on each pass.
+ */
+#define RADIX_BITS 8
+
+/**
+ * @brief The amount of buckets of each radix sort pass.
+ */
+#define RADIX_BUCKETS (1u << RADIX_BITS)
+
+/**
+ * @brief The amount of radix sort passes a key takes.
+ */
+#define RADIX_PASSES (64 / RADIX_BITS)
+
+/**
+ * @brief Get a mask of the low bits of a field.
+ */
+#define KEY_MASK(bits) ((UINT64_C(1) << (bits)) - 1)
+
+uint64_t LetoMakeSortKey(uint32_t pass, bool translucent,
+                         const shader_t* shader, uint32_t material,
+                         float depth)
+{
+    if (pass >= RENDER_PASS_COUNT)
+    {
+        LetoReport(invalid_param);
+        pass = RENDER_PASS_COUNT - 1;
+    }
+
+    // NaN compares false both ways, and lands on the near plane.
+    if (!(depth > 0.0f)) depth = 0.0f;
+    if (depth > 1.0f) depth = 1.0f;
+    const uint64_t depth_mask = KEY_MASK(RENDER_KEY_DEPTH_BITS);
+    // The mask isn't exact as a float, and would round up past the
+    // field at a depth of 1, so the product is taken in double.
+    uint64_t quantized = (uint64_t)((double)depth * (double)depth_mask);
+    if (quantized > depth_mask) quantized = depth_mask;
+    if (translucent) quantized = depth_mask - quantized;
+
+    const uint64_t shader_index =
+        shader != NULL ? shader->pool_handle.index : 0;
+    const uint64_t state =
+        (shader_index & KEY_MASK(RENDER_KEY_SHADER_BITS))
+            << RENDER_KEY_MATERIAL_BITS |
+        (material & KEY_MASK(RENDER_KEY_MATERIAL_BITS));
+
+    uint64_t key = (uint64_t)pass << (64 - RENDER_KEY_PASS_BITS) |
+                   (uint64_t)translucent << (63 - RENDER_KEY_PASS_BITS);
+    if (translucent)
+        key |= quantized << (RENDER_KEY_SHADER_BITS +
+                             RENDER_KEY_MATERIAL_BITS) |
+               state;
+    else key |= state << RENDER_KEY_DEPTH_BITS | quantized;
+    return key;
+}
+
+render_queue_t* LetoCreateRenderQueue(size_t subqueue_count)
+{
+    if (subqueue_count == 0) subqueue_count = 1;
+
+    render_queue_t* queue =
+        LetoCalloc(memory_renderer, 1, sizeof(render_queue_t));
+    queue->subqueues = LetoCalloc(memory_renderer, subqueue_count,
+                                  sizeof(render_subqueue_t));
+    queue->subqueue_count = subqueue_count;
+    return queue;
+}
+
+void LetoDestroyRenderQueue(render_queue_t* queue)
+{
+    if (queue == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    for (size_t i = 0; i < queue->subqueue_count; i++)
+        LetoFree(queue->subqueues[i].packets);
+    LetoFree(queue->subqueues);
+    LetoFree(queue->packets);
+    LetoFree(queue->entries);
+    LetoFree(queue->scratch);
+    LetoFree(queue);
+}
+
+render_subqueue_t* LetoGetRenderSubqueue(render_queue_t* queue,
+                                         size_t index)
+{
+    if (queue == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+    if (index >= queue->subqueue_count)
+    {
+        LetoReport(invalid_param);
+        return NULL;
+    }
+    return &queue->subqueues[index];
+}
+
+void LetoSubmitPacket(render_subqueue_t* subqueue,
+                      const render_packet_t* packet)
+{
+    if (subqueue == NULL || packet == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    if (subqueue->count == subqueue->capacity)
+    {
+        subqueue->capacity = subqueue->capacity == 0
+                                 ? RENDER_QUEUE_MINIMUM
+                                 : subqueue->capacity * 2;
+        const size_t size = subqueue->capacity * sizeof(render_packet_t);
+        subqueue->packets =
+            subqueue->packets == NULL
+                ? LetoMalloc(memory_renderer, size)
+                : LetoRealloc(subqueue->packets, size);
+    }
+    subqueue->packets[subqueue->count++] = *packet;
+}
+
+void LetoSubmitModel(render_subqueue_t* subqueue, uint32_t pass,
+                     shader_t* shader, const model_t* model,
+                     float distance, float projection, float depth)
+{
+    if (subqueue == NULL || shader == NULL || model == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    const size_t level = LetoSelectModelLOD(model, distance, projection,
+                                            MODEL_LOD_THRESHOLD);
+    for (size_t i = 0; i < model->submesh_count; i++)
+    {
+        // Level 0 of a chain is the submeshes themselves.
+        const mesh_submesh_t* submesh = &model->submeshes[i];
+        size_t first_index = submesh->first_index,
+               index_count = submesh->index_count;
+        if (model->lods != NULL)
+        {
+            const model_lod_t* lod =
+                &model->lods[level * model->submesh_count + i];
+            first_index = (size_t)lod->first_index;
+            index_count = (size_t)lod->index_count;
+        }
+        if (index_count == 0) continue;
+
+        const render_packet_t packet = {
+            .key = LetoMakeSortKey(pass, false, shader, submesh->material,
+                                   depth),
+            .shader = shader,
+            .vertex_array = model->vertex_array,
+            .model = model,
+            .material = submesh->material,
+            .index_type = model->index_type,
+            .first_index = (uint32_t)first_index,
+            .index_count = (uint32_t)index_count,
+            .instance_count = 1};
+        LetoSubmitPacket(subqueue, &packet);
+    }
+}
+
+/**
+ * @brief Make sure a queue has room to merge a given amount of packets.
+ * What's already there needn't be kept.
+ */
+static void Reserve_(render_queue_t* queue, size_t count)
+{
+    if (count <= queue->capacity) return;
+
+    size_t capacity =
+        queue->capacity == 0 ? RENDER_QUEUE_MINIMUM : queue->capacity;
+    while (capacity < count) capacity *= 2;
+    LetoFree(queue->packets);
+    LetoFree(queue->entries);
+    LetoFree(queue->scratch);
+    queue->packets =
+        LetoMalloc(memory_renderer, capacity * sizeof(render_packet_t));
+    queue->entries =
+        LetoMalloc(memory_renderer, capacity * sizeof(render_entry_t));
+    queue->scratch =
+        LetoMalloc(memory_renderer, capacity * sizeof(render_entry_t));
+    queue->capacity = capacity;
+}
+
+void LetoSortRenderQueue(render_queue_t* queue)
+{
+    if (queue == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < queue->subqueue_count; i++)
+        count += queue->subqueues[i].count;
+    Reserve_(queue, count);
+
+    queue->count = 0;
+    for (size_t i = 0; i < queue->subqueue_count; i++)
+    {
+        const render_subqueue_t* subqueue = &queue->subqueues[i];
+        if (subqueue->count == 0) continue;
+        (void)memcpy(queue->packets + queue->count, subqueue->packets,
+                     subqueue->count * sizeof(render_packet_t));
+        queue->count += subqueue->count;
+    }
+    if (count == 0) return;
+
+    // Every pass's histogram is counted in one go over the keys.
+    size_t histograms[RADIX_PASSES][RADIX_BUCKETS] = {{0}};
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint64_t key = queue->packets[i].key;
+        queue->entries[i] = (render_entry_t){key, i};
+        for (size_t pass = 0; pass < RADIX_PASSES; pass++)
+            histograms[pass][(key >> (pass * RADIX_BITS)) &
+                             (RADIX_BUCKETS - 1)]++;
+    }
+
+    render_entry_t* source = queue->entries;
+    render_entry_t* target = queue->scratch;
+    for (size_t pass = 0; pass < RADIX_PASSES; pass++)
+    {
+        const size_t shift = pass * RADIX_BITS;
+        size_t* histogram = histograms[pass];
+        // A byte every key shares wouldn't move anything.
+        if (histogram[(source[0].key >> shift) & (RADIX_BUCKETS - 1)] ==
+            count)
+            continue;
+
+        size_t offset = 0;
+        for (size_t i = 0; i < RADIX_BUCKETS; i++)
+        {
+            const size_t bucket = histogram[i];
+            histogram[i] = offset;
+            offset += bucket;
+        }
+        for (size_t i = 0; i < count; i++)
+            target[histogram[(source[i].key >> shift) &
+                             (RADIX_BUCKETS - 1)]++] = source[i];
+
+        render_entry_t* swap = source;
+        source = target;
+        target = swap;
+    }
+
+    // Whichever buffer the last pass landed in becomes the sorted one.
+    queue->entries = source;
+    queue->scratch = target;
+}
+
+void LetoExecuteRenderQueue(const render_queue_t* queue,
+                            render_material_function_t bind_material)
+{
+    if (queue == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    shader_t* shader = NULL;
+    unsigned int vertex_array = 0;
+    const model_t* model = NULL;
+    uint32_t material = 0;
+    bool first = true;
+    for (size_t i = 0; i < queue->count; i++)
+    {
+        const render_packet_t* packet =
+            &queue->packets[queue->entries[i].packet];
+
+        // A material's bindings belong to the shader they were made for,
+        // so a new shader always rebinds its material.
+        const bool new_shader = first || packet->shader != shader;
+        if (new_shader) LetoUseShader(packet->shader);
+        if (first || packet->vertex_array != vertex_array)
+            LetoBindVertexArray(packet->vertex_array);
+        if (packet->model != NULL &&
+            (new_shader || packet->model != model))
+            LetoBindModel(packet->shader, packet->model);
+        if (bind_material != NULL &&
+            (new_shader || packet->material != material))
+            bind_material(packet->shader, packet->material);
+
+        shader = packet->shader;
+        vertex_array = packet->vertex_array;
+        model = packet->model;
+        material = packet->material;
+        first = false;
+
+        const size_t index_size =
+            packet->index_type == GL_UNSIGNED_SHORT ? sizeof(uint16_t)
+                                                    : sizeof(uint32_t);
+        glDrawElementsInstancedBaseVertex(
+            GL_TRIANGLES, (GLsizei)packet->index_count, packet->index_type,
+            (const void*)((uintptr_t)packet->first_index * index_size),
+            (GLsizei)packet->instance_count, packet->base_vertex);
+    }
+}
+
+void LetoClearRenderQueue(render_queue_t* queue)
+{
+    if (queue == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    for (size_t i = 0; i < queue->subqueue_count; i++)
+        queue->subqueues[i].count = 0;
+    queue->count = 0;
+}
@@ -0,0 +1,378 @@
+/**
+ * @file Queue.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides Leto's render queue. Rather than issuing GL calls as
+ * they go, systems submit compact draw packets, each tagged with a 64-bit
+ * sort key; once a frame the queue radix sorts them by key and executes
+ * them in that order, only changing state where neighbouring packets
+ * differ. Every thread submits to a sub-queue of its own, so building a
+ * frame needs no locks, and the sub-queues are merged when it's sorted.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__QUEUE__
+#define __LETO__QUEUE__
+
+// The boolean type as described by the C standard.
+#include <stdbool.h>
+// Standard macro definitions, like size_t.
+#include <stddef.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+// Models, which are submitted a packet per submesh.
+#include <resources/models.h>
+// Shaders, which packets are drawn with.
+#include <resources/shaders.h>
+
+/**
+ * @brief The bits of a sort key given to each of its fields. From the
+ * most significant down, a key holds the pass, whether the draw is
+ * translucent, and then the shader, material and depth of opaque draws,
+ * which go front to back, or the depth, shader and material of
+ * translucent ones, which go back to front.
+ */
+#define RENDER_KEY_PASS_BITS 4
+#define RENDER_KEY_SHADER_BITS 14
+#define RENDER_KEY_MATERIAL_BITS 20
+#define RENDER_KEY_DEPTH_BITS 25
+
+/**
+ * @brief The amount of passes a key can tell apart.
+ */
+#define RENDER_PASS_COUNT (1u << RENDER_KEY_PASS_BITS)
+
+/**
+ * @brief The smallest amount of packets a sub-queue has room for, once it
+ * has any.
+ */
+#define RENDER_QUEUE_MINIMUM 256
+
+/**
+ * @brief Bind whatever a material needs for a shader, like its textures
+ * and uniforms. This is called whenever either changes between packets.
+ */
+typedef void (*render_material_function_t)(shader_t* shader,
+                                           uint32_t material);
+
+/**
+ * @brief A single draw: an indexed, instanced draw from a vertex array,
+ * like a submesh of a @ref model_t.
+ */
+typedef struct
+{
+    /**
+     * @brief The packet's sort key, see @ref LetoMakeSortKey.
+     */
+    uint64_t key;
+    shader_t* shader;
+    /**
+     * @brief The OpenGL ID of the vertex array to draw from.
+     */
+    unsigned int vertex_array;
+    /**
+     * @brief The model the packet draws from, or NULL. Its uniforms are
+     * set with @ref LetoBindModel whenever it or the shader changes.
+     */
+    const model_t* model;
+    /**
+     * @brief The library index of the packet's material, or @ref
+     * MATERIAL_NONE.
+     */
+    uint32_t material;
+    /**
+     * @brief The OpenGL type of the indices, GL_UNSIGNED_SHORT or
+     * GL_UNSIGNED_INT.
+     */
+    unsigned int index_type;
+    uint32_t first_index;
+    uint32_t index_count;
+    int32_t base_vertex;
+    uint32_t instance_count;
+} render_packet_t;
+
+/**
+ * @brief The packets a single thread submitted this frame.
+ */
+typedef struct
+{
+    render_packet_t* packets;
+    size_t count;
+    size_t capacity;
+} render_subqueue_t;
+
+/**
+ * @brief A packet's place within the merged packets, by its key.
+ */
+typedef struct
+{
+    uint64_t key;
+    size_t packet;
+} render_entry_t;
+
+/**
+ * @brief A render queue, and the storage it sorts in, which is kept from
+ * frame to frame.
+ */
+typedef struct
+{
+    render_subqueue_t* subqueues;
+    size_t subqueue_count;
+    /**
+     * @brief Every sub-queue's packets, one after another, once sorted.
+     */
+    render_packet_t* packets;
+    /**
+     * @brief The merged packets in key order once sorted, and the scratch
+     * space the radix sort moves them through.
+     */
+    render_entry_t* entries;
+    render_entry_t* scratch;
+    size_t count;
+    size_t capacity;
+} render_queue_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Build a sort key. Opaque draws sort by shader, then material,
+ * then front to back, so that state changes least and early depth
+ * testing rejects the most; translucent draws sort back to front first,
+ * as blending needs, and by state only among draws at the same depth.
+ *
+ * PARAMETERS
+ *
+ * @param pass The pass the draw belongs to; lower passes go first.
+ * @param translucent Whether or not the draw blends, which puts it after
+ * every opaque draw of its pass.
+ * @param shader The shader, or NULL. Its pool index is what's sorted on.
+ * @param material The library index of the material.
+ * @param depth The draw's depth from 0, the near plane, to 1, the far
+ * plane. Depths outside that are clamped.
+ *
+ * RETURN VALUE
+ *
+ * @return The key. Shader and material indices too wide for their bits
+ * keep only their low bits, so draws of such may interleave.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning invalid_param -- If the pass is out of range, this warning is
+ * thrown and the last pass is used.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+uint64_t LetoMakeSortKey(uint32_t pass, bool translucent,
+                         const shader_t* shader, uint32_t material,
+                         float depth);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Create a render queue.
+ *
+ * PARAMETERS
+ *
+ * @param subqueue_count The amount of sub-queues, one for each thread
+ * that will submit packets. At least one is always made.
+ *
+ * RETURN VALUE
+ *
+ * @return The queue, to be freed with @ref LetoDestroyRenderQueue.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+render_queue_t* LetoCreateRenderQueue(size_t subqueue_count);
+
+/**
+ * @brief Free a render queue and every packet within it.
+ */
+void LetoDestroyRenderQueue(render_queue_t* queue);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Get one of a queue's sub-queues. A sub-queue may only be
+ * submitted to by one thread at a time, and not at all while its queue
+ * is being sorted or executed.
+ *
+ * PARAMETERS
+ *
+ * @param queue The queue.
+ * @param index The index of the sub-queue.
+ *
+ * RETURN VALUE
+ *
+ * @return The sub-queue, or NULL if there's no such sub-queue.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If the queue is NULL, this warning is thrown and
+ * NULL is returned.
+ * @warning invalid_param -- If the index is out of range, this warning is
+ * thrown and NULL is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+render_subqueue_t* LetoGetRenderSubqueue(render_queue_t* queue,
+                                         size_t index);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Submit a packet to a sub-queue. The packet is copied, so it
+ * needn't outlive the call.
+ *
+ * PARAMETERS
+ *
+ * @param subqueue The sub-queue.
+ * @param packet The packet.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the sub-queue or packet is NULL, this warning
+ * is thrown and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoSubmitPacket(render_subqueue_t* subqueue,
+                      const render_packet_t* packet);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Submit an opaque model to a sub-queue, one packet per submesh.
+ * The level of detail drawn is picked by @ref LetoSelectModelLOD with
+ * @ref MODEL_LOD_THRESHOLD, and each packet draws its submesh's run of
+ * that level. The shader must suit the model's vertex layout, like
+ * rss/shaders/quantized for quantized models.
+ *
+ * PARAMETERS
+ *
+ * @param subqueue The sub-queue.
+ * @param pass The pass the model belongs to.
+ * @param shader The shader to draw the model with.
+ * @param model The model.
+ * @param distance The distance from the camera to the model's bounds, in
+ * the model's object-space units.
+ * @param projection The height of the viewport in pixels, divided by
+ * twice the tangent of half the vertical field of view.
+ * @param depth The model's depth for sorting, see @ref LetoMakeSortKey.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the sub-queue, shader or model is NULL, this
+ * warning is thrown and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoSubmitModel(render_subqueue_t* subqueue, uint32_t pass,
+                     shader_t* shader, const model_t* model,
+                     float distance, float projection, float depth);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Merge every sub-queue's packets and sort them by key. The sort
+ * is a least-significant-digit radix sort over the keys' bytes, skipping
+ * any byte every key shares, and is stable, so packets with the same key
+ * keep the order they were submitted in, sub-queue by sub-queue.
+ *
+ * PARAMETERS
+ *
+ * @param queue The queue.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the queue is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoSortRenderQueue(render_queue_t* queue);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Execute a sorted queue's packets in order. Shaders, vertex
+ * arrays, models and materials are only bound when they differ from the
+ * packet before.
+ *
+ * PARAMETERS
+ *
+ * @param queue The sorted queue.
+ * @param bind_material The function binding materials, or NULL if the
+ * packets' materials need nothing bound.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the queue is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoExecuteRenderQueue(const render_queue_t* queue,
+                            render_material_function_t bind_material);
+
+/**
+ * @brief Empty a queue and its sub-queues for the next frame, keeping
+ * their storage.
+ */
+void LetoClearRenderQueue(render_queue_t* queue);
+
+#endif // __LETO__QUEUE__
@@ -3,39 +3,85 @@
 #include <gl.h>
 #include <glfw3.h>
 #include <io/reporter.h>
-#include <resources/meshes.h>
-#include <stdlib.h>
-#include <string.h>
+#include <math.h>
+#include <resources/models.h>
+#include <utilities/memory.h>
+#include <utilities/threads.h>
 
-static renderer_t application_renderer = {NULL, 0, 0};
+static renderer_t application_renderer = {
+    NULL, 0, 0, NULL, NULL, NULL, 0, 0};
 
-void LetoCreateRenderer(size_t shader_list_size)
+void LetoCreateRenderer(size_t shader_capacity)
 {
-    application_renderer.shader_list =
-        malloc(sizeof(shader_t) * shader_list_size);
-    application_renderer.shader_list_size = shader_list_size;
-    application_renderer.shader_list_occupied = 0;
+    if (shader_capacity == 0) shader_capacity = 1;
+    application_renderer.shaders =
+        LetoMalloc(memory_renderer, sizeof(pool_handle_t) * shader_capacity);
+    application_renderer.shader_capacity = shader_capacity;
+    application_renderer.shader_count = 0;
+    application_renderer.queue =
+        LetoCreateRenderQueue(LetoGetHardwareThreads());
+    application_renderer.ring = LetoCreateRingBuffer(RENDERER_RING_SIZE);
 }
 
 void LetoDestroyRenderer(void)
 {
-    for (size_t i = 0; i < application_renderer.shader_list_occupied; i++)
-        LetoUnloadShader(application_renderer.shader_list[i]);
-    free(application_renderer.shader_list);
+    for (size_t i = 0; i < application_renderer.shader_count; i++)
+        LetoUnloadShader(
+            LetoResolveShader(application_renderer.shaders[i]));
+    LetoFree(application_renderer.shaders);
+    if (application_renderer.queue != NULL)
+        LetoDestroyRenderQueue(application_renderer.queue);
+    if (application_renderer.ring != NULL)
+        LetoDestroyRingBuffer(application_renderer.ring);
+    for (size_t i = 0; i < application_renderer.bucket_count; i++)
+        LetoDestroyIndirectBucket(application_renderer.buckets[i]);
+    LetoFree(application_renderer.buckets);
+    application_renderer =
+        (renderer_t){NULL, 0, 0, NULL, NULL, NULL, 0, 0};
+    LetoFreeShaderRegistry();
 }
 
 void render(void)
 {
-    LetoUseShader(LetoGetShader("basic"));
-    // LetoLoadMesh("cube.obj");
+    model_t* cube = LetoLoadModel("cube.obj");
+    shader_t* shader = NULL;
+    if (cube != NULL)
+        shader = LetoGetShader(
+            cube->vertex_format == model_vertex_quantized ? "quantized"
+                                                          : "basic");
+    render_subqueue_t* subqueue =
+        LetoGetRenderSubqueue(application_renderer.queue, 0);
 
     while (LetoGetRunState())
     {
+        LetoBeginRingFrame(application_renderer.ring);
         glClear(GL_COLOR_BUFFER_BIT);
         glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+
+        // Nothing is transformed yet, so the cube fills clip space as if
+        // it were seen from its bounding radius away.
+        const float projection =
+            (float)LetoGetHeight() /
+            (2.0f * tanf(RENDERER_FIELD_OF_VIEW * 0.5f));
+        if (cube != NULL && shader != NULL)
+            LetoSubmitModel(subqueue, 0, shader, cube,
+                            cube->bounds.sphere[3], projection, 0.0f);
+
+        LetoSortRenderQueue(application_renderer.queue);
+        LetoExecuteRenderQueue(application_renderer.queue, NULL);
+        LetoClearRenderQueue(application_renderer.queue);
+        for (size_t i = 0; i < application_renderer.bucket_count; i++)
+        {
+            LetoExecuteIndirectBucket(application_renderer.buckets[i],
+                                      application_renderer.ring);
+            LetoClearIndirectBucket(application_renderer.buckets[i]);
+        }
+        LetoEndRingFrame(application_renderer.ring);
         LetoSwapBuffers();
         glfwPollEvents();
     }
+
+    if (cube != NULL) LetoUnloadModel(cube);
 }
 
 shader_t* LetoGetShader(const char* name)
@@ -43,38 +89,99 @@ shader_t* LetoGetShader(const char* name)
     if (name == NULL)
     {
         LetoReport(null_param);
-        return application_renderer.shader_list[0];
-    }
-
-    shader_t* current_shader = application_renderer.shader_list[0];
-    for (size_t i = 0; i < application_renderer.shader_list_size; i++)
-    {
-        if (current_shader == NULL) break;
-        if (strcmp(current_shader->name, name) == 0) return current_shader;
-        current_shader = application_renderer.shader_list[i];
+        return NULL;
     }
 
-    LetoReport(no_such_value);
-    return NULL;
+    shader_t* shader = LetoFindShader(name, 0);
+    if (shader == NULL) LetoReport(no_such_value);
+    return shader;
 }
 
 void LetoAddShader(const char* name)
 {
-    if (application_renderer.shader_list_size ==
-        application_renderer.shader_list_occupied)
+    if (name == NULL)
     {
-        LetoReport(array_full);
+        LetoReport(null_param);
         return;
     }
 
-    if (name == NULL)
+    LetoAddShaders(&name, 1);
+}
+
+void LetoAddShaders(const char* const* names, size_t count)
+{
+    if (names == NULL)
     {
         LetoReport(null_param);
         return;
     }
 
-    application_renderer
-        .shader_list[application_renderer.shader_list_occupied] =
-        LetoLoadShader(name);
-    application_renderer.shader_list_occupied += 1;
+    const size_t needed = application_renderer.shader_count + count;
+    if (needed > application_renderer.shader_capacity)
+    {
+        size_t capacity = application_renderer.shader_capacity;
+        while (capacity < needed) capacity *= 2;
+        application_renderer.shaders = LetoRealloc(
+            application_renderer.shaders, sizeof(pool_handle_t) * capacity);
+        application_renderer.shader_capacity = capacity;
+    }
+
+    // Every program is in flight before any is waited on.
+    shader_t** shaders =
+        LetoMalloc(memory_renderer, sizeof(shader_t*) * count);
+    LetoFinishShaders(LetoSubmitShaders(names, NULL, count, shaders));
+    for (size_t i = 0; i < count; i++)
+    {
+        if (shaders[i] == NULL) continue;
+        application_renderer.shaders[application_renderer.shader_count++] =
+            shaders[i]->pool_handle;
+    }
+    LetoFree(shaders);
+}
+
+render_queue_t* LetoGetRenderQueue(void)
+{
+    return application_renderer.queue;
+}
+
+ring_buffer_t* LetoGetRingBuffer(void)
+{
+    return application_renderer.ring;
+}
+
+indirect_bucket_t* LetoAddIndirectBucket(uint32_t pass, shader_t* shader,
+                                         const mega_buffer_t* geometry,
+                                         size_t draw_size)
+{
+    indirect_bucket_t* bucket =
+        LetoCreateIndirectBucket(pass, shader, geometry, draw_size);
+    if (bucket == NULL) return NULL;
+
+    if (application_renderer.bucket_count ==
+        application_renderer.bucket_capacity)
+    {
+        application_renderer.bucket_capacity =
+            application_renderer.bucket_capacity == 0
+                ? 8
+                : application_renderer.bucket_capacity * 2;
+        const size_t size = application_renderer.bucket_capacity *
+                            sizeof(indirect_bucket_t*);
+        application_renderer.buckets =
+            application_renderer.buckets == NULL
+                ? LetoMalloc(memory_renderer, size)
+                : LetoRealloc(application_renderer.buckets, size);
+    }
+
+    // Buckets are few and added up front, so an insertion keeps them in
+    // pass order for free every frame after.
+    size_t index = application_renderer.bucket_count++;
+    while (index > 0 &&
+           application_renderer.buckets[index - 1]->pass > pass)
+    {
+        application_renderer.buckets[index] =
+            application_renderer.buckets[index - 1];
+        index--;
+    }
+    application_renderer.buckets[index] = bucket;
+    return bucket;
 }
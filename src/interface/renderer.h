@@ -12,31 +12,67 @@
 #ifndef __LETO__RENDERER__
 #define __LETO__RENDERER__
 
+#include "indirect.h"
+#include "queue.h"
+#include "ring.h"
 #include <resources/shaders.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
+/**
+ * @brief The bytes of dynamic data, like uniforms, the renderer's ring
+ * buffer holds for each frame.
+ */
+#define RENDERER_RING_SIZE (4 << 20)
+
+/**
+ * @brief The vertical field of view, in radians, that levels of detail
+ * are picked for.
+ */
+#define RENDERER_FIELD_OF_VIEW 1.0471976f
+
 typedef struct
 {
-    shader_t** shader_list;
-    size_t shader_list_size;
-    size_t shader_list_occupied;
+    /**
+     * @brief The handle of every shader the renderer has loaded, which
+     * it unloads when it's destroyed. This grows as shaders are added.
+     */
+    pool_handle_t* shaders;
+    size_t shader_count;
+    size_t shader_capacity;
+    /**
+     * @brief The queue every frame's draws are submitted to, with a
+     * sub-queue for each hardware thread.
+     */
+    render_queue_t* queue;
+    /**
+     * @brief The ring buffer every frame's dynamic data is uploaded to.
+     */
+    ring_buffer_t* ring;
+    /**
+     * @brief The renderer's indirect buckets, in pass order, which are
+     * drawn after the queue every frame and freed with the renderer.
+     */
+    indirect_bucket_t** buckets;
+    size_t bucket_count;
+    size_t bucket_capacity;
 } renderer_t;
 
-void LetoCreateRenderer(size_t shader_list_size);
+void LetoCreateRenderer(size_t shader_capacity);
 void LetoDestroyRenderer(void);
 
 /**
  * DESCRIPTION
  *
- * @brief Grab the inner ID of the first shader whose name matches the one
- * provided.
+ * @brief Grab the shader with the given name, built without keywords.
+ * This is a hash lookup through @ref LetoFindShader; code that draws with
+ * a shader every frame should keep its handle instead, see @ref
+ * LetoResolveShader.
  *
  * PARAMETERS
  *
- * @param list The list to search through.
- * @param name The name to search nodes for.
+ * @param name The name to search for.
  *
  * RETURN VALUE
  *
@@ -45,12 +81,10 @@ void LetoDestroyRenderer(void);
  *
  * WARNINGS
  *
- * Three warnings can be thrown by this function.
- * @warning null_object -- If the list passed to the function is NULL, this
- * warning will be thrown and NULL is returned.
- * @warning null_string -- If the name passed to this function is NULL,
- * this warning will be thrown and the list head is returned.
- * @warning no_such_shader -- If no shader was found with the name @param
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If the name passed to this function is NULL,
+ * this warning will be thrown and NULL is returned.
+ * @warning no_such_value -- If no shader was found with the name @param
  * name, this warning is thrown and NULL is returned.
  *
  * ERRORS
@@ -62,6 +96,84 @@ shader_t* LetoGetShader(const char* name);
 
 void LetoAddShader(const char* name);
 
+/**
+ * DESCRIPTION
+ *
+ * @brief Load a set of shaders into the renderer as one
+ * batch, so the driver compiles and links all of them at once rather
+ * than one after another. See @ref LetoSubmitShaders.
+ *
+ * PARAMETERS
+ *
+ * @param names The name of each shader's folder.
+ * @param count The amount of shaders.
+ *
+ * RETURN VALUE
+ *
+ * Nothing to note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the names are NULL, this warning is thrown and
+ * nothing is done.
+ * @note For possible warnings unhandled by this function, see @ref
+ * LetoSubmitShaders.
+ *
+ * ERRORS
+ *
+ * Nothing to note.
+ *
+ */
+void LetoAddShaders(const char* const* names, size_t count);
+
+/**
+ * @brief Get the renderer's queue, which is sorted, executed and cleared
+ * once a frame.
+ */
+render_queue_t* LetoGetRenderQueue(void);
+
+/**
+ * @brief Get the renderer's ring buffer, whose frames begin and end with
+ * the renderer's.
+ */
+ring_buffer_t* LetoGetRingBuffer(void);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Create an indirect bucket the renderer draws every frame, and
+ * empties afterward. Buckets are drawn in pass order, and those of the
+ * same pass in the order they were added. See @ref
+ * LetoCreateIndirectBucket.
+ *
+ * PARAMETERS
+ *
+ * @param pass The pass the bucket's draws belong to.
+ * @param shader The shader the bucket's draws are made with.
+ * @param geometry The mega-buffer the bucket's draws are made from.
+ * @param draw_size The size of each draw's data in bytes, or 0.
+ *
+ * RETURN VALUE
+ *
+ * @return The bucket, which the renderer frees, or NULL if something
+ * went wrong.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ * @note For warnings unhandled by this function, see @ref
+ * LetoCreateIndirectBucket.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+indirect_bucket_t* LetoAddIndirectBucket(uint32_t pass, shader_t* shader,
+                                         const mega_buffer_t* geometry,
+                                         size_t draw_size);
+
 //! temp
 void render(void);
 
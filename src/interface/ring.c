@@ -0,0 +1,182 @@
+/**
+ * @file Ring.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Ring.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "ring.h"             // Public interface parent
+#include "state.h"            // OpenGL state shadow
+#include <gl.h>               // OpenGL function pointers
+#include <io/reporter.h>      // Error / warning reporter
+#include <string.h>           // Memcpy
+#include <utilities/memory.h> // Tracked allocations
+
+/**
+ * @brief The flags the ring's storage is made and mapped with. Coherent
+ * writes are seen by the GPU without flushing.
+ */
+#define RING_FLAGS                                                        \
+    (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT)
+
+/**
+ * @brief How long a single wait on a fence lasts in nanoseconds, before
+ * it's tried again.
+ */
+#define RING_WAIT_NS UINT64_C(1000000000)
+
+/**
+ * @brief Round a value up to a multiple of a power of two.
+ */
+#define ALIGN_UP(value, alignment)                                        \
+    (((value) + ((alignment) - 1)) & ~((alignment) - 1))
+
+/**
+ * @brief Wait for the GPU to finish with a region, and free its fence.
+ */
+static void WaitRegion_(ring_buffer_t* ring, size_t frame)
+{
+    GLsync fence = ring->fences[frame];
+    if (fence == NULL) return;
+
+    // Checking first, without flushing, costs nothing when the GPU is
+    // keeping up, which is what three regions are for.
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED)
+    {
+        ring->stalls++;
+        do status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                     RING_WAIT_NS);
+        while (status == GL_TIMEOUT_EXPIRED);
+    }
+    glDeleteSync(fence);
+    ring->fences[frame] = NULL;
+}
+
+ring_buffer_t* LetoCreateRingBuffer(size_t frame_size)
+{
+    GLint uniform_alignment = 0, storage_alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniform_alignment);
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT,
+                  &storage_alignment);
+
+    ring_buffer_t* ring =
+        LetoCalloc(memory_renderer, 1, sizeof(ring_buffer_t));
+    ring->alignment = 16;
+    if ((size_t)uniform_alignment > ring->alignment)
+        ring->alignment = (size_t)uniform_alignment;
+    if ((size_t)storage_alignment > ring->alignment)
+        ring->alignment = (size_t)storage_alignment;
+    // Every region starts aligned, so offsets within it stay so.
+    ring->frame_size = ALIGN_UP(frame_size, ring->alignment);
+    ring->frame = RING_FRAMES - 1;
+
+    const GLsizeiptr size = (GLsizeiptr)(ring->frame_size * RING_FRAMES);
+    glCreateBuffers(1, &ring->buffer);
+    glNamedBufferStorage(ring->buffer, size, NULL, RING_FLAGS);
+    ring->mapping =
+        glMapNamedBufferRange(ring->buffer, 0, size, RING_FLAGS);
+    if (ring->mapping == NULL) LetoReport(failed_buffer);
+    return ring;
+}
+
+void LetoDestroyRingBuffer(ring_buffer_t* ring)
+{
+    if (ring == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    for (size_t i = 0; i < RING_FRAMES; i++)
+        if (ring->fences[i] != NULL) glDeleteSync(ring->fences[i]);
+    glUnmapNamedBuffer(ring->buffer);
+    LetoForgetGLObject(gl_state_buffer, ring->buffer);
+    glDeleteBuffers(1, &ring->buffer);
+    LetoFree(ring);
+}
+
+void LetoBeginRingFrame(ring_buffer_t* ring)
+{
+    if (ring == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    ring->frame = (ring->frame + 1) % RING_FRAMES;
+    ring->offset = 0;
+    WaitRegion_(ring, ring->frame);
+}
+
+void LetoEndRingFrame(ring_buffer_t* ring)
+{
+    if (ring == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    if (ring->fences[ring->frame] != NULL)
+        glDeleteSync(ring->fences[ring->frame]);
+    ring->fences[ring->frame] =
+        glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+bool LetoAllocateRing(ring_buffer_t* ring, size_t size, size_t alignment,
+                      ring_allocation_t* allocation)
+{
+    if (ring == NULL || allocation == NULL)
+    {
+        LetoReport(null_param);
+        return false;
+    }
+    if (alignment == 0) alignment = ring->alignment;
+    if ((alignment & (alignment - 1)) != 0)
+    {
+        LetoReport(invalid_param);
+        return false;
+    }
+
+    // Alignment is of the offset within the whole buffer, which is what
+    // gets bound, and may be wider than the regions'.
+    const size_t base = ring->frame * ring->frame_size;
+    const size_t offset = ALIGN_UP(base + ring->offset, alignment) - base;
+    if (offset > ring->frame_size || size > ring->frame_size - offset)
+    {
+        LetoReport(array_full);
+        return false;
+    }
+    ring->offset = offset + size;
+    if (ring->offset > ring->peak) ring->peak = ring->offset;
+
+    allocation->buffer = ring->buffer;
+    allocation->offset = base + offset;
+    allocation->data = ring->mapping + allocation->offset;
+    allocation->size = size;
+    return true;
+}
+
+bool LetoUploadRing(ring_buffer_t* ring, const void* data, size_t size,
+                    size_t alignment, ring_allocation_t* allocation)
+{
+    if (data == NULL)
+    {
+        LetoReport(null_param);
+        return false;
+    }
+
+    if (!LetoAllocateRing(ring, size, alignment, allocation)) return false;
+    (void)memcpy(allocation->data, data, size);
+    return true;
+}
@@ -0,0 +1,213 @@
+/**
+ * @file Ring.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides ring buffers for data rewritten every frame, like
+ * uniforms and dynamic vertices. A ring is one buffer, mapped persistently
+ * and coherently for its whole life, split into a region for each of
+ * @ref RING_FRAMES frames in flight. Each frame bumps through its own
+ * region, so uploading is a plain memcpy into the mapping, and a fence
+ * placed as the frame ends keeps the region from being reused until the
+ * GPU has read it.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__RING__
+#define __LETO__RING__
+
+// The boolean type as described by the C standard.
+#include <stdbool.h>
+// Standard macro definitions, like size_t.
+#include <stddef.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+
+/**
+ * @brief The amount of frames a ring holds data for at once: one being
+ * written by the CPU, and the rest being read by the GPU.
+ */
+#define RING_FRAMES 3
+
+/**
+ * @brief A ring buffer.
+ */
+typedef struct
+{
+    /**
+     * @brief The OpenGL ID of the buffer.
+     */
+    unsigned int buffer;
+    /**
+     * @brief The persistent mapping of the whole buffer.
+     */
+    uint8_t* mapping;
+    /**
+     * @brief The size of each frame's region in bytes.
+     */
+    size_t frame_size;
+    /**
+     * @brief The alignment OpenGL asks of uniform and storage buffer
+     * ranges, which allocations default to.
+     */
+    size_t alignment;
+    /**
+     * @brief The index of the region being written.
+     */
+    size_t frame;
+    /**
+     * @brief The bump pointer within the region being written.
+     */
+    size_t offset;
+    /**
+     * @brief The most of a region any frame has used, for sizing rings.
+     */
+    size_t peak;
+    /**
+     * @brief The amount of frames that had to wait on the GPU before
+     * their region could be written.
+     */
+    uint64_t stalls;
+    /**
+     * @brief The GLsync fence of each region, or NULL if the GPU has
+     * nothing of it left to read. Kept opaque so that this header needn't
+     * include OpenGL.
+     */
+    void* fences[RING_FRAMES];
+} ring_buffer_t;
+
+/**
+ * @brief A range of a ring buffer, valid until the end of the frame it
+ * was allocated in.
+ */
+typedef struct
+{
+    /**
+     * @brief Where to write the range's data.
+     */
+    void* data;
+    /**
+     * @brief The OpenGL ID of the ring's buffer, and the offset of the
+     * range within it, for binding.
+     */
+    unsigned int buffer;
+    size_t offset;
+    size_t size;
+} ring_allocation_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Create a ring buffer, and map it. A GL context must be current.
+ *
+ * PARAMETERS
+ *
+ * @param frame_size The most bytes a single frame can allocate.
+ *
+ * RETURN VALUE
+ *
+ * @return The ring, to be freed with @ref LetoDestroyRingBuffer.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * One error can be thrown by this function.
+ * @exception failed_buffer -- If the buffer can't be mapped, this error
+ * is thrown and the process exits.
+ *
+ */
+ring_buffer_t* LetoCreateRingBuffer(size_t frame_size);
+
+/**
+ * @brief Unmap and free a ring buffer. The GPU mustn't be reading from it
+ * anymore.
+ */
+void LetoDestroyRingBuffer(ring_buffer_t* ring);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Start a frame, moving on to the next region. If the GPU hasn't
+ * finished reading that region, which it last held @ref RING_FRAMES
+ * frames ago, this waits until it has.
+ *
+ * PARAMETERS
+ *
+ * @param ring The ring.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the ring is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoBeginRingFrame(ring_buffer_t* ring);
+
+/**
+ * @brief End a frame, fencing its region once every command reading it
+ * has been issued. Call this after the frame's last draw.
+ */
+void LetoEndRingFrame(ring_buffer_t* ring);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Allocate a range of the frame's region.
+ *
+ * PARAMETERS
+ *
+ * @param ring The ring.
+ * @param size The size of the range in bytes.
+ * @param alignment The alignment of the range, a power of two, or 0 for
+ * @ref ring_buffer_t.alignment.
+ * @param allocation The range allocated.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the range fit in what's left of the region.
+ *
+ * WARNINGS
+ *
+ * Three warnings can be thrown by this function.
+ * @warning null_param -- If the ring or allocation is NULL, this warning
+ * is thrown and false is returned.
+ * @warning invalid_param -- If the alignment isn't a power of two, this
+ * warning is thrown and false is returned.
+ * @warning array_full -- If the range doesn't fit, this warning is thrown
+ * and false is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+bool LetoAllocateRing(ring_buffer_t* ring, size_t size, size_t alignment,
+                      ring_allocation_t* allocation);
+
+/**
+ * @brief Allocate a range of the frame's region and copy data into it.
+ * See @ref LetoAllocateRing.
+ */
+bool LetoUploadRing(ring_buffer_t* ring, const void* data, size_t size,
+                    size_t alignment, ring_allocation_t* allocation);
+
+#endif // __LETO__RING__
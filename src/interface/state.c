@@ -0,0 +1,320 @@
+/**
+ * @file State.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file State.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "state.h"               // Public interface parent
+#include <diagnostic/platform.h> // Build type macros
+#include <gl.h>                  // OpenGL function pointers
+#include <io/reporter.h>         // Error / warning reporter
+#include <stdio.h>               // Printf
+#include <string.h>              // Memcmp, memcpy, memset
+
+/**
+ * @brief The value of shadowed state that isn't known. No name, enum or
+ * size OpenGL takes is ever all ones, so the next change always differs.
+ */
+#define UNKNOWN UINT32_MAX
+
+/**
+ * @brief The buffer targets shadowed, in the order of @ref
+ * shadow.buffers.
+ */
+static const GLenum buffer_targets[] = {
+    GL_ARRAY_BUFFER,          GL_ELEMENT_ARRAY_BUFFER,
+    GL_UNIFORM_BUFFER,        GL_SHADER_STORAGE_BUFFER,
+    GL_DRAW_INDIRECT_BUFFER,  GL_DISPATCH_INDIRECT_BUFFER,
+    GL_PARAMETER_BUFFER,      GL_COPY_READ_BUFFER,
+    GL_COPY_WRITE_BUFFER,     GL_PIXEL_PACK_BUFFER,
+    GL_PIXEL_UNPACK_BUFFER,   GL_QUERY_BUFFER,
+    GL_TEXTURE_BUFFER,        GL_ATOMIC_COUNTER_BUFFER};
+
+/**
+ * @brief The amount of buffer targets shadowed.
+ */
+#define BUFFER_TARGET_COUNT                                               \
+    (sizeof(buffer_targets) / sizeof(buffer_targets[0]))
+
+/**
+ * @brief The name of each kind of state, for the report.
+ */
+static const char* const state_names[gl_state_count] = {
+    "program", "pipeline", "vertex", "buffer", "texture",
+    "blend",   "depth",    "cull",   "viewport"};
+
+/**
+ * @brief The shadowed state. Every field is a 32-bit value so that
+ * forgetting it all is filling it with @ref UNKNOWN.
+ */
+static struct
+{
+    uint32_t program;
+    uint32_t pipeline;
+    uint32_t vertex_array;
+    uint32_t buffers[BUFFER_TARGET_COUNT];
+    uint32_t textures[GL_STATE_TEXTURE_UNITS];
+    uint32_t blend;
+    uint32_t blend_source;
+    uint32_t blend_destination;
+    uint32_t depth_test;
+    uint32_t depth_write;
+    uint32_t depth_function;
+    uint32_t cull;
+    uint32_t cull_face;
+    uint32_t viewport[4];
+} shadow;
+
+/**
+ * @brief The changes made to each kind of state.
+ */
+static gl_state_stats_t state_stats[gl_state_count] = {0};
+
+/**
+ * @brief Shadow a value, counting whether the change is sent.
+ *
+ * @return Whether the value changed, and the GL call must be made.
+ */
+static bool Change_(gl_state_t kind, uint32_t* shadowed, uint32_t value)
+{
+    if (*shadowed == value)
+    {
+        state_stats[kind].filtered++;
+        return false;
+    }
+    *shadowed = value;
+    state_stats[kind].issued++;
+    return true;
+}
+
+/**
+ * @brief Enable or disable a capability if it's changed.
+ */
+static void Toggle_(gl_state_t kind, uint32_t* shadowed, bool enabled,
+                    GLenum capability)
+{
+    if (!Change_(kind, shadowed, enabled)) return;
+    if (enabled) glEnable(capability);
+    else glDisable(capability);
+}
+
+/**
+ * @brief Get the index of a buffer target's shadow, or @ref
+ * BUFFER_TARGET_COUNT if it has none.
+ */
+static size_t BufferTarget_(GLenum target)
+{
+    size_t index = 0;
+    while (index < BUFFER_TARGET_COUNT && buffer_targets[index] != target)
+        index++;
+    return index;
+}
+
+#ifdef __LETO__DEBUG__
+/**
+ * @brief Print a message the driver raised, reporting it if it's an
+ * error or undefined behaviour.
+ */
+static void GLAD_API_PTR DebugMessage_(GLenum source, GLenum type,
+                                       GLuint id, GLenum severity,
+                                       GLsizei length,
+                                       const GLchar* message,
+                                       const void* user)
+{
+    (void)source;
+    (void)length;
+    (void)user;
+
+    const char* severity_name = "low";
+    if (severity == GL_DEBUG_SEVERITY_HIGH) severity_name = "high";
+    else if (severity == GL_DEBUG_SEVERITY_MEDIUM)
+        severity_name = "medium";
+    printf("[gl] %s %#x: %s\n", severity_name, id, message);
+
+    if (type == GL_DEBUG_TYPE_ERROR ||
+        type == GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR)
+        LetoReport(gl_debug);
+}
+#endif
+
+void LetoInitializeGLState(void)
+{
+    LetoResetGLState();
+    (void)memset(state_stats, 0, sizeof(state_stats));
+
+#ifdef __LETO__DEBUG__
+    GLint flags = 0;
+    glGetIntegerv(GL_CONTEXT_FLAGS, &flags);
+    if (!(flags & GL_CONTEXT_FLAG_DEBUG_BIT)) return;
+
+    // Synchronous output raises a message within the call that caused
+    // it, so a debugger stopped on the report shows the culprit.
+    glEnable(GL_DEBUG_OUTPUT);
+    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+    glDebugMessageCallback(DebugMessage_, NULL);
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE,
+                          GL_DEBUG_SEVERITY_NOTIFICATION, 0, NULL,
+                          GL_FALSE);
+#endif
+}
+
+void LetoResetGLState(void)
+{
+    (void)memset(&shadow, 0xFF, sizeof(shadow));
+}
+
+void LetoForgetGLObject(gl_state_t kind, unsigned int id)
+{
+    switch (kind)
+    {
+        case gl_state_pipeline:
+            if (shadow.pipeline == id) shadow.pipeline = 0;
+            break;
+        case gl_state_vertex_array:
+            if (shadow.vertex_array == id) shadow.vertex_array = 0;
+            break;
+        case gl_state_buffer:
+            for (size_t i = 0; i < BUFFER_TARGET_COUNT; i++)
+                if (shadow.buffers[i] == id) shadow.buffers[i] = 0;
+            break;
+        case gl_state_texture:
+            for (size_t i = 0; i < GL_STATE_TEXTURE_UNITS; i++)
+                if (shadow.textures[i] == id) shadow.textures[i] = 0;
+            break;
+        default: break;
+    }
+}
+
+void LetoUseProgram(unsigned int program)
+{
+    if (Change_(gl_state_program, &shadow.program, program))
+        glUseProgram(program);
+}
+
+void LetoBindProgramPipeline(unsigned int pipeline)
+{
+    if (Change_(gl_state_pipeline, &shadow.pipeline, pipeline))
+        glBindProgramPipeline(pipeline);
+}
+
+void LetoBindVertexArray(unsigned int vertex_array)
+{
+    if (!Change_(gl_state_vertex_array, &shadow.vertex_array,
+                 vertex_array))
+        return;
+    glBindVertexArray(vertex_array);
+    shadow.buffers[BufferTarget_(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+}
+
+void LetoBindBuffer(unsigned int target, unsigned int buffer)
+{
+    const size_t index = BufferTarget_(target);
+    if (index == BUFFER_TARGET_COUNT)
+        state_stats[gl_state_buffer].issued++;
+    else if (!Change_(gl_state_buffer, &shadow.buffers[index], buffer))
+        return;
+    glBindBuffer(target, buffer);
+}
+
+void LetoBindBufferRange(unsigned int target, unsigned int index,
+                         unsigned int buffer, size_t offset, size_t size)
+{
+    const size_t shadowed = BufferTarget_(target);
+    if (shadowed != BUFFER_TARGET_COUNT) shadow.buffers[shadowed] = buffer;
+    state_stats[gl_state_buffer].issued++;
+    glBindBufferRange(target, index, buffer, (GLintptr)offset,
+                      (GLsizeiptr)size);
+}
+
+void LetoBindTextureUnit(unsigned int unit, unsigned int texture)
+{
+    if (unit >= GL_STATE_TEXTURE_UNITS)
+        state_stats[gl_state_texture].issued++;
+    else if (!Change_(gl_state_texture, &shadow.textures[unit], texture))
+        return;
+    glBindTextureUnit(unit, texture);
+}
+
+void LetoSetBlend(bool enabled, unsigned int source,
+                  unsigned int destination)
+{
+    Toggle_(gl_state_blend, &shadow.blend, enabled, GL_BLEND);
+    if (!enabled) return;
+
+    // Both factors go in one call, so it's counted once.
+    if (shadow.blend_source == source &&
+        shadow.blend_destination == destination)
+    {
+        state_stats[gl_state_blend].filtered++;
+        return;
+    }
+    shadow.blend_source = source;
+    shadow.blend_destination = destination;
+    state_stats[gl_state_blend].issued++;
+    glBlendFunc(source, destination);
+}
+
+void LetoSetDepth(bool test, bool write, unsigned int function)
+{
+    Toggle_(gl_state_depth, &shadow.depth_test, test, GL_DEPTH_TEST);
+    if (Change_(gl_state_depth, &shadow.depth_write, write))
+        glDepthMask(write ? GL_TRUE : GL_FALSE);
+    if (test && Change_(gl_state_depth, &shadow.depth_function, function))
+        glDepthFunc(function);
+}
+
+void LetoSetCull(bool enabled, unsigned int face)
+{
+    Toggle_(gl_state_cull, &shadow.cull, enabled, GL_CULL_FACE);
+    if (enabled && Change_(gl_state_cull, &shadow.cull_face, face))
+        glCullFace(face);
+}
+
+void LetoSetViewport(int32_t x, int32_t y, int32_t width, int32_t height)
+{
+    const uint32_t viewport[4] = {(uint32_t)x, (uint32_t)y,
+                                  (uint32_t)width, (uint32_t)height};
+    if (memcmp(shadow.viewport, viewport, sizeof(viewport)) == 0)
+    {
+        state_stats[gl_state_viewport].filtered++;
+        return;
+    }
+    (void)memcpy(shadow.viewport, viewport, sizeof(viewport));
+    state_stats[gl_state_viewport].issued++;
+    glViewport(x, y, width, height);
+}
+
+void LetoGetGLStateStats(gl_state_t kind, gl_state_stats_t* stats)
+{
+    if (stats == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+    if (kind >= gl_state_count)
+    {
+        LetoReport(invalid_param);
+        return;
+    }
+    *stats = state_stats[kind];
+}
+
+void LetoReportGLState(void)
+{
+    printf("\n%-10s %12s %12s\n", "state", "issued", "filtered");
+    for (size_t i = 0; i < gl_state_count; i++)
+        printf("%-10s %12llu %12llu\n", state_names[i],
+               (unsigned long long)state_stats[i].issued,
+               (unsigned long long)state_stats[i].filtered);
+}
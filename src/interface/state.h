@@ -0,0 +1,233 @@
+/**
+ * @file State.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides a shadow of the OpenGL state Leto changes most: the
+ * bound program, program pipeline, vertex array, buffers and textures,
+ * and the blend, depth, cull and viewport state. Every change goes
+ * through here, so one that would set what's already set is never sent
+ * to the driver, and is counted instead. The shadow only knows of changes
+ * made through it, so code calling OpenGL directly must call @ref
+ * LetoResetGLState afterward. It belongs to the thread whose context is
+ * current, and isn't locked.
+ *
+ * Errors aren't polled with glGetError, which can stall the pipeline;
+ * debug builds ask for a debug context, and the driver reports them
+ * through KHR_debug as they happen instead.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__STATE__
+#define __LETO__STATE__
+
+// The boolean type as described by the C standard.
+#include <stdbool.h>
+// Standard macro definitions, like size_t.
+#include <stddef.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+
+/**
+ * @brief The amount of texture units shadowed. Units past this are bound
+ * without checking.
+ */
+#define GL_STATE_TEXTURE_UNITS 32
+
+/**
+ * @brief The kinds of state shadowed, each counted on its own.
+ */
+typedef enum
+{
+    gl_state_program,
+    gl_state_pipeline,
+    gl_state_vertex_array,
+    gl_state_buffer,
+    gl_state_texture,
+    gl_state_blend,
+    gl_state_depth,
+    gl_state_cull,
+    gl_state_viewport,
+    gl_state_count
+} gl_state_t;
+
+/**
+ * @brief The changes made to a kind of state since the context was made.
+ */
+typedef struct
+{
+    /**
+     * @brief The amount of GL calls sent to the driver.
+     */
+    uint64_t issued;
+    /**
+     * @brief The amount of GL calls dropped, as they'd have set what was
+     * already set.
+     */
+    uint64_t filtered;
+} gl_state_stats_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Start shadowing a freshly made context, whose functions must
+ * have been loaded. In debug builds, this also hooks the driver's
+ * KHR_debug messages, reporting them as they're raised.
+ *
+ * PARAMETERS
+ *
+ * Nothing of note.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function, in debug builds.
+ * @warning gl_debug -- Whenever the driver raises an error or undefined
+ * behaviour message, this warning is thrown after the message is printed.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoInitializeGLState(void);
+
+/**
+ * @brief Forget everything shadowed, so every next change is sent. Call
+ * this after changing state without going through here.
+ */
+void LetoResetGLState(void);
+
+/**
+ * @brief Forget an object that's being deleted, whose bindings OpenGL
+ * reverts to 0. Its name may be reused, and a stale shadow would then
+ * drop the new object's binding. Programs needn't be forgotten, as their
+ * names aren't freed while they're in use.
+ */
+void LetoForgetGLObject(gl_state_t kind, unsigned int id);
+
+/**
+ * @brief Make a program current, as glUseProgram.
+ */
+void LetoUseProgram(unsigned int program);
+
+/**
+ * @brief Bind a program pipeline, as glBindProgramPipeline. A pipeline is
+ * only used while no program is current.
+ */
+void LetoBindProgramPipeline(unsigned int pipeline);
+
+/**
+ * @brief Bind a vertex array, as glBindVertexArray. Its element buffer
+ * comes with it, so that binding is forgotten.
+ */
+void LetoBindVertexArray(unsigned int vertex_array);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Bind a buffer to a target, as glBindBuffer.
+ *
+ * PARAMETERS
+ *
+ * @param target The target, like GL_ARRAY_BUFFER. Targets without a
+ * shadow, like GL_TRANSFORM_FEEDBACK_BUFFER, are bound without checking.
+ * @param buffer The buffer, or 0.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoBindBuffer(unsigned int target, unsigned int buffer);
+
+/**
+ * @brief Bind a range of a buffer to an indexed target, as
+ * glBindBufferRange. Ranges move every frame, so they're always sent, but
+ * the target's general binding they also set is shadowed.
+ */
+void LetoBindBufferRange(unsigned int target, unsigned int index,
+                         unsigned int buffer, size_t offset, size_t size);
+
+/**
+ * @brief Bind a texture to a unit, as glBindTextureUnit.
+ */
+void LetoBindTextureUnit(unsigned int unit, unsigned int texture);
+
+/**
+ * @brief Set whether blending is enabled, and if so, the factors it
+ * blends with, as glBlendFunc.
+ */
+void LetoSetBlend(bool enabled, unsigned int source,
+                  unsigned int destination);
+
+/**
+ * @brief Set whether depth is tested, whether it's written, as
+ * glDepthMask, and how it's compared, as glDepthFunc.
+ */
+void LetoSetDepth(bool test, bool write, unsigned int function);
+
+/**
+ * @brief Set whether faces are culled, and if so which, as glCullFace.
+ */
+void LetoSetCull(bool enabled, unsigned int face);
+
+/**
+ * @brief Set the viewport, as glViewport.
+ */
+void LetoSetViewport(int32_t x, int32_t y, int32_t width, int32_t height);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Get the changes made to a kind of state.
+ *
+ * PARAMETERS
+ *
+ * @param kind The kind of state.
+ * @param stats The structure to fill.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If the stats are NULL, this warning is thrown
+ * and nothing is done.
+ * @warning invalid_param -- If the kind is out of range, this warning is
+ * thrown and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoGetGLStateStats(gl_state_t kind, gl_state_stats_t* stats);
+
+/**
+ * @brief Print how many changes of each kind of state were sent and how
+ * many were filtered.
+ */
+void LetoReportGLState(void);
+
+#endif // __LETO__STATE__
@@ -17,6 +17,7 @@
  */
 
 #include "window.h"              // Public interface parent
+#include "state.h"               // OpenGL state shadow
 #include <diagnostic/platform.h> // Platform and version macros
 #include <gl.h>                  // GLAD2 OpenGL declarations
 #include <glfw3.h>               // GLFW3 public interface
@@ -110,6 +111,10 @@ void LetoCreateWindow(const char* title)
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#ifdef __LETO__DEBUG__
+    // Errors are reported through KHR_debug rather than polled.
+    glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, GLFW_TRUE);
+#endif
 
     application_window.title = LetoStringMalloc(127); // 127c + NUL
     LetoSetStringF(true, &application_window.title, 128,
@@ -134,6 +139,7 @@ void LetoCreateWindow(const char* title)
     // Make our window's OpenGL context current on this thread.
     glfwMakeContextCurrent(application_window._w);
     if (!gladLoadGL(glfwGetProcAddress)) LetoReport(gl_init);
+    LetoInitializeGLState();
 }
 
 void LetoDestroyWindow(void)
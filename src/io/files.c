@@ -18,11 +18,28 @@
 #include "files.h"               // Public interface parent
 #include <diagnostic/platform.h> // Platform macros
 #include <io/reporter.h>         // Error / warning reporter
-#include <stdlib.h>              // Malloc, calloc, etc.
 #include <string.h>              // Standard string utilities
 #include <utilities/macros.h>    // Macro utilities
+#include <utilities/memory.h>    // Tracked allocations
+#include <utilities/pools.h>     // Object pools
 #include <utilities/strings.h>   // String utilities
 
+#if defined(__LETO__LINUX__)
+    #include <fcntl.h>    // Open
+    #include <sys/mman.h> // Mmap
+    #include <sys/stat.h> // Fstat
+    #include <unistd.h>   // Close
+#elif defined(__LETO__WINDOWS__)
+    #define WIN32_LEAN_AND_MEAN
+    #include <Windows.h>
+#endif
+
+/**
+ * @brief The pool every file object is allocated from. This is created on
+ * the first open and destroyed once the last file is closed.
+ */
+static pool_t* file_pool = NULL;
+
 /**
  * DESCRIPTION
  *
@@ -132,10 +149,13 @@ file_t* LetoOpenFile(file_mode_t mode, const char* path)
         return NULL;
     }
 
-    file_t* opened_file = malloc(sizeof(file_t));
+    if (file_pool == NULL)
+        file_pool = LetoCreatePoolT(memory_files, file_t, 16);
+    pool_handle_t handle = LetoPoolAllocate(file_pool);
+    file_t* opened_file = LetoPoolGetT(file_t, file_pool, handle);
     if (opened_file == NULL) LetoReport(failed_buffer);
-    *opened_file =
-        (file_t){NULL, LetoStringMalloc(strlen(path)), 0, mode, NULL};
+    *opened_file = (file_t){NULL, LetoStringMalloc(strlen(path)), 0, mode,
+                            NULL, handle};
     strcpy((char*)opened_file->path, path);
 
     switch (mode)
@@ -161,12 +181,17 @@ void LetoCloseFile(file_t* file)
     }
 
     if (fclose(file->handle) == EOF) LetoReport(file_read);
-    if (file->contents != NULL) free(file->contents);
+    LetoFree(file->contents);
 
     char* temp_path_storage = (char*)file->path;
     LetoStringFree(&temp_path_storage);
 
-    free(file);
+    LetoPoolFree(file_pool, file->pool_handle);
+    if (file_pool->occupied == 0)
+    {
+        LetoDestroyPool(file_pool);
+        file_pool = NULL;
+    }
 }
 
 size_t LetoGetFilesize(file_t* file)
@@ -189,8 +214,7 @@ void LetoReadFile(file_t* file)
         return;
     }
 
-    file->contents = calloc(file->size, 1);
-    if (file->contents == NULL) LetoReport(failed_buffer);
+    file->contents = LetoCalloc(memory_files, file->size, 1);
 
     // Set our positioner to beginning of the file.
     if (fseek(file->handle, 0L, SEEK_SET) == -1)
@@ -212,8 +236,7 @@ uint8_t* LetoReadFileP(bool terminate, const char* path)
 {
     file_t* opened_file = LetoOpenFile(r, path);
     LetoReadFile(opened_file);
-    uint8_t* buffer = malloc(opened_file->size);
-    if (buffer == NULL) LetoReport(failed_buffer);
+    uint8_t* buffer = LetoMalloc(memory_files, opened_file->size);
 
     (void)memcpy(buffer, opened_file->contents, opened_file->size - 1);
     if (terminate) buffer[opened_file->size - 1] = 0;
@@ -231,8 +254,7 @@ uint8_t* LetoReadFilePV(bool terminate, const char* format, ...)
 
     file_t* opened_file = LetoOpenFile(r, new_path);
     LetoReadFile(opened_file);
-    uint8_t* buffer = malloc(opened_file->size);
-    if (buffer == NULL) LetoReport(failed_buffer);
+    uint8_t* buffer = LetoMalloc(memory_files, opened_file->size);
 
     (void)memcpy(buffer, opened_file->contents, opened_file->size - 1);
     if (terminate) buffer[opened_file->size - 1] = 0;
@@ -257,3 +279,121 @@ void LetoWriteFile(file_t* file, uint8_t* buffer, size_t buffer_size)
     if (fwrite(buffer, 1, buffer_size, file->handle) != buffer_size)
         LetoReport(file_write);
 }
+
+bool LetoFileExists(const char* path)
+{
+    if (path == NULL)
+    {
+        LetoReport(null_param);
+        return false;
+    }
+
+#if defined(__LETO__LINUX__)
+    struct stat status;
+    return stat(path, &status) == 0 && S_ISREG(status.st_mode);
+#elif defined(__LETO__WINDOWS__)
+    const DWORD attributes = GetFileAttributesA(path);
+    return attributes != INVALID_FILE_ATTRIBUTES &&
+           !(attributes & FILE_ATTRIBUTE_DIRECTORY);
+#endif
+}
+
+uint64_t LetoGetFileTime(const char* path)
+{
+    if (path == NULL)
+    {
+        LetoReport(null_param);
+        return 0;
+    }
+
+#if defined(__LETO__LINUX__)
+    struct stat status;
+    if (stat(path, &status) != 0) return 0;
+    return (uint64_t)status.st_mtim.tv_sec * UINT64_C(1000000000) +
+           (uint64_t)status.st_mtim.tv_nsec;
+#elif defined(__LETO__WINDOWS__)
+    WIN32_FILE_ATTRIBUTE_DATA attributes;
+    if (!GetFileAttributesExA(path, GetFileExInfoStandard, &attributes))
+        return 0;
+    return (uint64_t)attributes.ftLastWriteTime.dwHighDateTime << 32 |
+           attributes.ftLastWriteTime.dwLowDateTime;
+#endif
+}
+
+bool LetoMapFile(const char* path, mapping_t* mapping)
+{
+    if (path == NULL || mapping == NULL)
+    {
+        LetoReport(null_param);
+        return false;
+    }
+
+#if defined(__LETO__LINUX__)
+    const int descriptor = open(path, O_RDONLY);
+    if (descriptor == -1)
+    {
+        LetoReport(file_read);
+        return false;
+    }
+
+    struct stat status;
+    void* data = MAP_FAILED;
+    if (fstat(descriptor, &status) == 0 && status.st_size > 0)
+        data = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE,
+                    descriptor, 0);
+    // The mapping keeps its own reference to the file.
+    (void)close(descriptor);
+    if (data == MAP_FAILED)
+    {
+        LetoReport(file_read);
+        return false;
+    }
+
+    *mapping = (mapping_t){data, (size_t)status.st_size};
+    return true;
+#elif defined(__LETO__WINDOWS__)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        LetoReport(file_read);
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    HANDLE handle = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+        handle = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    (void)CloseHandle(file);
+
+    const void* data = NULL;
+    if (handle != NULL)
+        data = MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL)
+    {
+        if (handle != NULL) (void)CloseHandle(handle);
+        LetoReport(file_read);
+        return false;
+    }
+
+    *mapping = (mapping_t){data, (size_t)size.QuadPart, handle};
+    return true;
+#endif
+}
+
+void LetoUnmapFile(mapping_t* mapping)
+{
+    if (mapping == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+#if defined(__LETO__LINUX__)
+    (void)munmap((void*)mapping->data, mapping->size);
+#elif defined(__LETO__WINDOWS__)
+    (void)UnmapViewOfFile(mapping->data);
+    (void)CloseHandle(mapping->handle);
+#endif
+    *mapping = (mapping_t){0};
+}
@@ -24,6 +24,10 @@
 #include <stdbool.h>
 // IO functionality defined by the C standard.
 #include <stdio.h>
+// Pool handles for file object storage.
+#include <utilities/pools.h>
+// Platform-decision macros.
+#include <diagnostic/platform.h>
 
 /**
  * @brief An enumerator describing the various states a file can be opened
@@ -90,8 +94,35 @@ typedef struct
      * @ref LetoReadFile is called on the file.
      */
     uint8_t* contents;
+    /**
+     * @brief The handle of the file object within the file pool. This is
+     * used to return the object to the pool when the file is closed.
+     */
+    pool_handle_t pool_handle;
 } file_t;
 
+/**
+ * @brief A read-only view of a whole file mapped into memory. Pages are
+ * read in by the OS as they're touched, and nothing is copied.
+ */
+typedef struct
+{
+    /**
+     * @brief The contents of the file.
+     */
+    const uint8_t* data;
+    /**
+     * @brief The size of the file.
+     */
+    size_t size;
+#if defined(__LETO__WINDOWS__)
+    /**
+     * @brief The file mapping object backing the view.
+     */
+    void* handle;
+#endif
+} mapping_t;
+
 /**
  * DESCRIPTION
  *
@@ -344,4 +375,118 @@ uint8_t* LetoReadFilePV(bool terminate, const char* format, ...);
  */
 void LetoWriteFile(file_t* file, uint8_t* buffer, size_t buffer_size);
 
+/**
+ * DESCRIPTION
+ *
+ * @brief Check whether a file exists, without opening it. Unlike a failed
+ * open, a missing file isn't reported, so this suits optional files like
+ * caches.
+ *
+ * PARAMETERS
+ *
+ * @param path The path to the file, be it absolute or relative.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the file exists.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the path is NULL, this warning is thrown and
+ * false is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+bool LetoFileExists(const char* path);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Get when a file was last written to, for telling whether a file
+ * generated from another is out of date. Like @ref LetoFileExists, a
+ * missing file isn't reported.
+ *
+ * PARAMETERS
+ *
+ * @param path The path to the file, be it absolute or relative.
+ *
+ * RETURN VALUE
+ *
+ * @return The time of the last write, in platform-defined units that
+ * only mean anything compared to each other, or 0 if the file doesn't
+ * exist.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the path is NULL, this warning is thrown and
+ * 0 is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+uint64_t LetoGetFileTime(const char* path);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Map a whole file into memory, read-only.
+ *
+ * PARAMETERS
+ *
+ * @param path The path to the file, be it absolute or relative.
+ * @param mapping The storage for the mapping.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the file could be mapped. Empty files can't be.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If either parameter is NULL, this warning is
+ * thrown and false is returned.
+ * @warning file_read -- If the file can't be opened or mapped, this
+ * warning is thrown and false is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+bool LetoMapFile(const char* path, mapping_t* mapping);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Release a mapping made by @ref LetoMapFile. Pointers into it
+ * must no longer be used.
+ *
+ * PARAMETERS
+ *
+ * @param mapping The mapping to release.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the mapping is NULL, this warning is thrown
+ * and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoUnmapFile(mapping_t* mapping);
+
 #endif // __LETO__FILES__
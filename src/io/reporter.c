@@ -91,6 +91,7 @@ typedef struct
  */
 static const problem_t problems[problem_count] = {
     {"null_param", "a null parameter was passed", false, leto},
+    {"invalid_param", "a parameter was out of range", false, leto},
     {"failed_buffer", "an allocation failure occurred", true, os},
     {"small_buffer", "tried to access past buffer bounds", false, leto},
     {"no_such_value", "no equal value found in list", false, leto},
@@ -102,6 +103,7 @@ static const problem_t problems[problem_count] = {
     {"gl_init", "failed to initialize glad/opengl", true, opengl},
     {"gl_shader_comp", "failed to compile shader", true, opengl},
     {"gl_shader_bad", "failed to utilize shader", true, opengl},
+    {"gl_debug", "opengl raised an error message", false, opengl},
     {"window_null", "call made to nonexistent window", false, leto},
     {"null_window", "failed to create window", true, glfw},
     {"file_null", "call made to nonexistent file", false, leto},
@@ -109,6 +111,14 @@ static const problem_t problems[problem_count] = {
     {"file_pos_set", "failed to set file positioner", false, os},
     {"file_read", "failed to read (from?) file", false, os},
     {"file_write", "failed to write to file", false, os},
+    {"thread_error", "failed to create thread object", true, os},
+    {"stale_handle", "handle refers to a freed object", false, leto},
+    {"memory_budget", "subsystem exceeded memory budget", false, leto},
+    {"memory_leak", "memory still allocated at exit", false, leto},
+    {"mesh_malformed", "mesh file is malformed", false, leto},
+    {"material_malformed", "material file is malformed", false, leto},
+    {"unnamed_resource", "shader resource reflected without a name", false,
+     opengl},
 };
 
 /**
@@ -188,12 +198,13 @@ void LetoReport_(problem_code_t problem, const char* file,
     const problem_t reported_problem = problems[problem];
     if (!reported_problem.fatal)
     {
-        timestamp_t current_time;
+        timestamp_t current_time = TIMESTAMP_INITIALIZER;
         LetoGetTimestamp(&current_time, bracketed);
 
         printf("%s " ERROR_MESSAGE_FORMAT, current_time.string, function,
                file, line, reported_problem.name,
                reported_problem.description, reported_problem.type);
+        LetoStringFree(&current_time.string);
         last_warning = problem;
     }
     else PrintError_(&reported_problem, file, function, line);
@@ -33,6 +33,7 @@ typedef enum
      * @defgroup General-purpose problems.
      */
     null_param,
+    invalid_param, // out-of-range parameter
     failed_buffer,
     small_buffer,
     no_such_value,
@@ -47,6 +48,7 @@ typedef enum
     gl_init,
     gl_shader_comp,
     gl_shader_bad,
+    gl_debug,    // driver debug message
     null_window, // failed window
     window_null, // window not yet created
     file_null,   // file not yet created
@@ -54,6 +56,13 @@ typedef enum
     file_pos_set,
     file_read, // sometimes failed file open
     file_write,
+    thread_error,
+    stale_handle, // handle to a freed pool object
+    memory_budget,
+    memory_leak,
+    mesh_malformed,
+    material_malformed,
+    unnamed_resource, // SPIR-V programs needn't keep names
     /**
      * @defgroup Problem counter.
      */
@@ -1,14 +1,27 @@
+#include <diagnostic/platform.h>
 #include <interface/renderer.h>
+#include <interface/state.h>
 #include <interface/window.h>
+#include <resources/meshes.h>
+#include <resources/statistics.h>
+#include <utilities/memory.h>
+#include <utilities/strings.h>
 
 int main(void)
 {
     LetoCreateWindow("Leto");
-    LetoCreateRenderer(1);
-    LetoAddShader("basic");
+    LetoCreateRenderer(2);
+    LetoAddShaders((const char* const[]){"basic", "quantized"}, 2);
 
     render();
 
+    LetoReportShaderStatistics();
+    LetoReportMeshImports();
+#ifdef __LETO__DEBUG__
+    LetoReportGLState();
+#endif
     LetoDestroyRenderer();
     LetoDestroyWindow();
+    LetoStringFreeInterned();
+    LetoReportMemory();
 }
@@ -0,0 +1,214 @@
+/**
+ * @file Binaries.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Binaries.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "binaries.h"         // Public interface parent
+#include <gl.h>               // OpenGL function pointers
+#include <io/files.h>         // File mapping and writing
+#include <io/reporter.h>      // Error / warning reporter
+#include <string.h>           // Memcpy, strlen
+#include <utilities/memory.h> // Tracked allocations
+
+/**
+ * @brief The 64-bit FNV-1a offset basis, the hash of nothing.
+ */
+#define FNV_OFFSET UINT64_C(0xCBF29CE484222325)
+
+/**
+ * @brief The 64-bit FNV-1a prime.
+ */
+#define FNV_PRIME UINT64_C(0x100000001B3)
+
+/**
+ * @brief The hash of the driver, worked out on first use. The driver
+ * can't change under a running process.
+ */
+static uint64_t driver_hash = 0;
+
+/**
+ * @brief Continue an FNV-1a hash over some bytes.
+ */
+static uint64_t Hash_(uint64_t hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = data;
+    for (size_t i = 0; i < size; i++)
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    return hash;
+}
+
+/**
+ * @brief Get the hash of the current driver's vendor, renderer and
+ * version strings.
+ */
+static uint64_t GetDriverHash_(void)
+{
+    if (driver_hash != 0) return driver_hash;
+
+    const GLenum names[] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+    uint64_t hash = FNV_OFFSET;
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+    {
+        const char* string = (const char*)glGetString(names[i]);
+        if (string == NULL) string = "";
+        // The terminator keeps "ab" + "c" apart from "a" + "bc".
+        hash = Hash_(hash, string, strlen(string) + 1);
+    }
+    driver_hash = hash;
+    return hash;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Check whether the driver still accepts binaries of a format.
+ *
+ * PARAMETERS
+ *
+ * @param format The format.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the format is accepted. Drivers that support no
+ * formats accept none.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool FormatSupported_(GLenum format)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count);
+    if (count <= 0) return false;
+
+    GLint* formats =
+        LetoMalloc(memory_shaders, (size_t)count * sizeof(GLint));
+    glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats);
+    bool supported = false;
+    for (GLint i = 0; i < count && !supported; i++)
+        supported = (GLenum)formats[i] == format;
+    LetoFree(formats);
+    return supported;
+}
+
+uint64_t LetoHashSources(const char* const* sources, size_t count)
+{
+    if (sources == NULL)
+    {
+        LetoReport(null_param);
+        return 0;
+    }
+
+    uint64_t hash = FNV_OFFSET;
+    for (size_t i = 0; i < count; i++)
+    {
+        const char* source = sources[i] != NULL ? sources[i] : "";
+        hash = Hash_(hash, source, strlen(source) + 1);
+    }
+    return hash;
+}
+
+unsigned int LetoLoadProgramBinary(const char* path, uint64_t source_hash,
+                                   bool separable)
+{
+    if (path == NULL)
+    {
+        LetoReport(null_param);
+        return 0;
+    }
+
+    // A missing binary is the normal case on a first run, so it isn't
+    // worth a warning.
+    mapping_t mapping;
+    if (!LetoFileExists(path) || !LetoMapFile(path, &mapping)) return 0;
+
+    const binary_header_t* header = (const binary_header_t*)mapping.data;
+    GLuint program = 0;
+    if (mapping.size > sizeof(binary_header_t) &&
+        header->magic == BINARY_MAGIC &&
+        header->version == BINARY_VERSION &&
+        header->source_hash == source_hash &&
+        header->driver_hash == GetDriverHash_() &&
+        header->size == mapping.size - sizeof(binary_header_t) &&
+        FormatSupported_(header->format))
+    {
+        program = glCreateProgram();
+        glProgramParameteri(program, GL_PROGRAM_SEPARABLE,
+                            separable ? GL_TRUE : GL_FALSE);
+        glProgramBinary(program, header->format,
+                        mapping.data + sizeof(binary_header_t),
+                        (GLsizei)header->size);
+
+        GLint linked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked)
+        {
+            glDeleteProgram(program);
+            program = 0;
+        }
+    }
+
+    LetoUnmapFile(&mapping);
+    return program;
+}
+
+bool LetoStoreProgramBinary(unsigned int program, const char* path,
+                            uint64_t source_hash)
+{
+    if (path == NULL)
+    {
+        LetoReport(null_param);
+        return false;
+    }
+
+    GLint formats = 0, length = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (formats <= 0 || length <= 0) return false;
+
+    uint8_t* buffer = LetoMalloc(memory_shaders,
+                                 sizeof(binary_header_t) + (size_t)length);
+    binary_header_t header = {.magic = BINARY_MAGIC,
+                              .version = BINARY_VERSION,
+                              .source_hash = source_hash,
+                              .driver_hash = GetDriverHash_()};
+    GLsizei written = 0;
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &written, &format,
+                       buffer + sizeof(binary_header_t));
+    if (written <= 0)
+    {
+        LetoFree(buffer);
+        return false;
+    }
+    header.format = format;
+    header.size = (uint32_t)written;
+    (void)memcpy(buffer, &header, sizeof(binary_header_t));
+
+    file_t* file = LetoOpenFile(w, path);
+    if (file != NULL)
+    {
+        LetoWriteFile(file, buffer, sizeof(binary_header_t) + header.size);
+        LetoCloseFile(file);
+    }
+    LetoFree(buffer);
+    return file != NULL;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file Binaries.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the on-disk cache of linked shader programs. Drivers
+ * hand back a program's linked binary, which can be given straight back
+ * on a later run in place of compiling and linking its sources again.
+ * Binaries are only valid for the exact driver that made them, so every
+ * cached binary is keyed on both its sources and the driver.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__BINARIES__
+#define __LETO__BINARIES__
+
+// The boolean type as described by the C standard.
+#include <stdbool.h>
+// Standard macro definitions, like size_t.
+#include <stddef.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+
+/**
+ * @brief The first four bytes of every cached binary, "LPRG" on disk.
+ */
+#define BINARY_MAGIC UINT32_C(0x4752504C)
+
+/**
+ * @brief The version of the cache file layout. Files of any other version
+ * are treated as missing.
+ */
+#define BINARY_VERSION 1
+
+/**
+ * @brief The path of a shader's cached binary, formatted with the name of
+ * its folder and its permutation in hex. Each permutation of a shader
+ * keeps a single binary, which is replaced whenever its sources or the
+ * driver change.
+ */
+#define BINARY_PATH ASSET_DIR "/shaders/%s/program.%x.bin"
+
+/**
+ * @brief The path of a separable stage's cached binary, formatted with
+ * the name of its shader's folder, the name of its GLSL file and the
+ * permutation in hex.
+ */
+#define BINARY_STAGE_PATH ASSET_DIR "/shaders/%s/%s.%x.bin"
+
+/**
+ * @brief The header at the start of every cached binary.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    /**
+     * @brief The hash of the program's sources, see @ref
+     * LetoHashSources.
+     */
+    uint64_t source_hash;
+    /**
+     * @brief The hash of the GL_VENDOR, GL_RENDERER and GL_VERSION
+     * strings of the driver that made the binary.
+     */
+    uint64_t driver_hash;
+    /**
+     * @brief The driver's format of the binary, as given to
+     * glProgramBinary.
+     */
+    uint32_t format;
+    /**
+     * @brief The size of the binary, which directly follows the header.
+     */
+    uint32_t size;
+} binary_header_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Hash the sources of a program, in order, with 64-bit FNV-1a.
+ *
+ * PARAMETERS
+ *
+ * @param sources The NUL-terminated source of each stage. NULL sources
+ * hash the same as empty ones.
+ * @param count The amount of sources.
+ *
+ * RETURN VALUE
+ *
+ * @return The hash of the sources.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the sources are NULL, this warning is thrown
+ * and 0 is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+uint64_t LetoHashSources(const char* const* sources, size_t count);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Create a program from its cached binary. The binary is only
+ * used if it was made from sources with the same hash, by the same
+ * driver, in a format the driver still accepts; and even then, a driver
+ * may still reject it, like after an update that didn't change its
+ * version string. In every such case the program is thrown away, so the
+ * caller can simply compile from source instead. A GL context must be
+ * current.
+ *
+ * PARAMETERS
+ *
+ * @param path The path of the binary, see @ref BINARY_PATH and @ref
+ * BINARY_STAGE_PATH.
+ * @param source_hash The hash of the program's sources.
+ * @param separable Whether or not the program is a separable stage, which
+ * has to be set before its binary is loaded.
+ *
+ * RETURN VALUE
+ *
+ * @return The linked program, or 0 if there was no usable binary.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the path is NULL, this warning is thrown and
+ * 0 is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+unsigned int LetoLoadProgramBinary(const char* path, uint64_t source_hash,
+                                   bool separable);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Write a linked program's binary to the cache, replacing
+ * whatever was there. The program should have been linked with
+ * GL_PROGRAM_BINARY_RETRIEVABLE_HINT set, and nothing is written if the
+ * driver supports no binary formats. A GL context must be current.
+ *
+ * PARAMETERS
+ *
+ * @param program The linked program.
+ * @param path The path of the binary, see @ref BINARY_PATH and @ref
+ * BINARY_STAGE_PATH.
+ * @param source_hash The hash of the program's sources.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the binary was written.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the path is NULL, this warning is thrown and
+ * false is returned.
+ * @note For warnings unhandled by this function, see @ref LetoOpenFile.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For errors unhandled by this function, see @ref LetoWriteFile.
+ *
+ */
+bool LetoStoreProgramBinary(unsigned int program, const char* path,
+                            uint64_t source_hash);
+
+#endif // __LETO__BINARIES__
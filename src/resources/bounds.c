@@ -0,0 +1,123 @@
+/**
+ * @file Bounds.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Bounds.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "bounds.h"           // Public interface parent
+#include <float.h>            // Float limits
+#include <io/reporter.h>      // Error / warning reporter
+#include <math.h>             // Sqrtf
+#include <utilities/memory.h> // Tracked allocations
+
+/**
+ * @brief Load a vertex's position into a vec4, with a W of 0 so that it
+ * never affects a distance.
+ */
+static void Load_(const mesh_vertex_t* vertex, vec4 dest)
+{
+    glm_vec4((float*)vertex->position, 0.0f, dest);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Bound a set of a mesh's vertices.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh.
+ * @param indices The vertices to bound, widened to 32 bits, or NULL to
+ * bound every vertex of the mesh. Vertices may be repeated.
+ * @param count The amount of indices, or of vertices if there are none.
+ * @param bounds The storage for the bounds, zeroed if the set is empty.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void Bound_(const mesh_t* mesh, const uint32_t* indices,
+                   size_t count, mesh_bounds_t* bounds)
+{
+    *bounds = (mesh_bounds_t){0};
+    if (count == 0) return;
+
+    vec4 minimum, maximum, position;
+    glm_vec4_broadcast(FLT_MAX, minimum);
+    glm_vec4_broadcast(-FLT_MAX, maximum);
+    for (size_t i = 0; i < count; i++)
+    {
+        Load_(&mesh->vertices[indices == NULL ? i : indices[i]], position);
+        glm_vec4_minv(minimum, position, minimum);
+        glm_vec4_maxv(maximum, position, maximum);
+    }
+    glm_vec3_copy(minimum, bounds->minimum);
+    glm_vec3_copy(maximum, bounds->maximum);
+
+    // The box's center is rarely the tightest, but it's stable and within
+    // a factor of the square root of three of the smallest sphere.
+    vec4 center;
+    glm_vec4_add(minimum, maximum, center);
+    glm_vec4_scale(center, 0.5f, center);
+    float radius = 0.0f;
+    for (size_t i = 0; i < count; i++)
+    {
+        Load_(&mesh->vertices[indices == NULL ? i : indices[i]], position);
+        const float distance = glm_vec4_distance2(center, position);
+        if (distance > radius) radius = distance;
+    }
+    glm_vec3_copy(center, bounds->sphere);
+    bounds->sphere[3] = sqrtf(radius);
+}
+
+void LetoComputeBounds(mesh_t* mesh)
+{
+    if (mesh == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    Bound_(mesh, NULL, mesh->vertex_count, &mesh->bounds);
+    if (mesh->submesh_count == 0) return;
+
+    // Submeshes only reach into the full-detail level.
+    uint32_t* indices = NULL;
+    if (mesh->index_size == sizeof(uint16_t))
+    {
+        const size_t index_count = LetoGetDetailIndexCount(mesh);
+        indices =
+            LetoMalloc(memory_meshes, index_count * sizeof(uint32_t));
+        for (size_t i = 0; i < index_count; i++)
+            indices[i] = ((const uint16_t*)mesh->indices)[i];
+    }
+    const uint32_t* wide = indices != NULL ? indices : mesh->indices;
+
+    for (size_t i = 0; i < mesh->submesh_count; i++)
+    {
+        mesh_submesh_t* submesh = &mesh->submeshes[i];
+        Bound_(mesh, &wide[submesh->first_index], submesh->index_count,
+               &submesh->bounds);
+    }
+    LetoFree(indices);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file Bounds.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the bounding volumes of imported meshes and their
+ * submeshes. These are worked out once at import and carried through the
+ * container, so nothing at runtime has to walk vertices to cull.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__BOUNDS__
+#define __LETO__BOUNDS__
+
+// Imported meshes.
+#include <resources/meshes.h>
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Find the bounds of a mesh and each of its submeshes: an
+ * axis-aligned box, and a sphere around the box's center reaching the
+ * furthest vertex. A submesh is bounded by the vertices its full-detail
+ * triangles use. Each vertex is handled as one cglm vec4, so the box is
+ * grown with SIMD minimums and maximums.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the mesh is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoComputeBounds(mesh_t* mesh);
+
+#endif // __LETO__BOUNDS__
@@ -0,0 +1,662 @@
+/**
+ * @file Materials.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Materials.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "materials.h"         // Public interface parent
+#include <io/files.h>          // File mapping
+#include <io/reporter.h>       // Error / warning reporter
+#include <stdlib.h>            // Strtof, strtol
+#include <string.h>            // Memchr, memcpy, strcmp
+#include <utilities/macros.h>  // Path length
+#include <utilities/memory.h>  // Tracked allocations
+#include <utilities/strings.h> // String creation and interning
+
+/**
+ * @brief The longest line an MTL file may have, terminator included.
+ */
+#define MATERIAL_MAX_LINE 1024
+
+/**
+ * @brief The smallest the library's lookup table can be. This must be a
+ * power of two.
+ */
+#define MATERIAL_MIN_CAPACITY 64
+
+/**
+ * @brief Whether or not a character separates the tokens of a line.
+ */
+#define IS_BLANK(character) ((character) == ' ' || (character) == '\t')
+
+/**
+ * @brief A material within the library.
+ */
+typedef struct
+{
+    material_t material;
+    /**
+     * @brief The hash of the material, kept so the lookup table can grow
+     * without rehashing every material.
+     */
+    uint64_t hash;
+    /**
+     * @brief The amount of references to the material. Materials without
+     * any stay in the library, so they keep their index if they're
+     * registered again.
+     */
+    uint32_t references;
+} material_entry_t;
+
+/**
+ * @brief The state of an MTL parse.
+ */
+typedef struct
+{
+    /**
+     * @brief The material being described, valid if @ref
+     * material_parser_t::open.
+     */
+    material_t current;
+    bool open;
+    uint32_t* materials;
+    size_t count;
+    size_t capacity;
+} material_parser_t;
+
+/**
+ * @brief The materials of the library, indexed by their library index.
+ */
+static material_entry_t* library = NULL;
+static size_t library_count = 0, library_capacity = 0;
+
+/**
+ * @brief An open addressing hash table of library indices, keyed on the
+ * contents of the materials they refer to. Empty slots hold @ref
+ * MATERIAL_NONE. The capacity is a power of two.
+ */
+static uint32_t* library_table = NULL;
+static size_t table_capacity = 0;
+
+/**
+ * @brief The amount of references held to every material combined. The
+ * library is freed once this drops back to zero.
+ */
+static size_t library_references = 0;
+
+/**
+ * @brief Mix a 32-bit word into an FNV-1a style hash.
+ */
+static inline uint64_t MixHash_(uint64_t hash, uint32_t word)
+{
+    return (hash ^ word) * UINT64_C(0x100000001B3);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Hash every property of a material. Colors are hashed by their
+ * bits and strings by their (interned) address, which is exactly what
+ * @ref EqualMaterials_ compares.
+ *
+ * PARAMETERS
+ *
+ * @param material The material to hash.
+ *
+ * RETURN VALUE
+ *
+ * @return The hash of the material.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static uint64_t HashMaterial_(const material_t* material)
+{
+    const float* floats[] = {material->specular, material->diffuse,
+                             material->ambient, material->emission,
+                             material->transmission_filter};
+    const size_t lengths[] = {4, 3, 3, 3, 3};
+    uint64_t hash = UINT64_C(0xCBF29CE484222325);
+    uint32_t word;
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        for (size_t j = 0; j < lengths[i]; j++)
+        {
+            (void)memcpy(&word, &floats[i][j], sizeof(word));
+            hash = MixHash_(hash, word);
+        }
+    }
+    (void)memcpy(&word, &material->transparency, sizeof(word));
+    hash = MixHash_(hash, word);
+    (void)memcpy(&word, &material->refraction, sizeof(word));
+    hash = MixHash_(hash, word);
+    hash = MixHash_(hash, (uint32_t)material->illumination);
+
+    for (size_t i = 0; i < material_map_count; i++)
+        hash = MixHash_(hash, (uint32_t)(uintptr_t)material->maps[i]);
+    return MixHash_(hash, (uint32_t)(uintptr_t)material->name);
+}
+
+/**
+ * @brief Compare two floats by their bits, so that the comparison agrees
+ * with @ref HashMaterial_ even for NaNs and signed zeroes.
+ */
+static inline bool EqualFloats_(const float* a, const float* b,
+                                size_t count)
+{
+    return memcmp(a, b, count * sizeof(float)) == 0;
+}
+
+/**
+ * @brief Check whether two materials have identical properties. Names and
+ * maps must already be interned.
+ */
+static bool EqualMaterials_(const material_t* a, const material_t* b)
+{
+    if (!EqualFloats_(a->specular, b->specular, 4) ||
+        !EqualFloats_(a->diffuse, b->diffuse, 3) ||
+        !EqualFloats_(a->ambient, b->ambient, 3) ||
+        !EqualFloats_(a->emission, b->emission, 3) ||
+        !EqualFloats_(a->transmission_filter, b->transmission_filter, 3) ||
+        !EqualFloats_(&a->transparency, &b->transparency, 1) ||
+        !EqualFloats_(&a->refraction, &b->refraction, 1))
+        return false;
+    if (a->illumination != b->illumination || a->name != b->name)
+        return false;
+
+    for (size_t i = 0; i < material_map_count; i++)
+        if (a->maps[i] != b->maps[i]) return false;
+    return true;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Find the lookup table slot of a material: either the slot of the
+ * identical material already in the library, or the empty slot where it
+ * belongs.
+ *
+ * PARAMETERS
+ *
+ * @param material The material to look for.
+ * @param hash The hash of the material.
+ *
+ * RETURN VALUE
+ *
+ * @return The slot.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static uint32_t* FindSlot_(const material_t* material, uint64_t hash)
+{
+    const size_t mask = table_capacity - 1;
+    for (size_t i = (size_t)hash & mask;; i = (i + 1) & mask)
+    {
+        uint32_t* slot = &library_table[i];
+        if (*slot == MATERIAL_NONE) return slot;
+
+        const material_entry_t* entry = &library[*slot];
+        if (entry->hash == hash &&
+            EqualMaterials_(&entry->material, material))
+            return slot;
+    }
+}
+
+/**
+ * @brief Double the capacity of the lookup table, reinserting every
+ * material.
+ */
+static void GrowTable_(void)
+{
+    LetoFree(library_table);
+    table_capacity = table_capacity == 0 ? MATERIAL_MIN_CAPACITY
+                                         : table_capacity * 2;
+    library_table =
+        LetoMalloc(memory_meshes, table_capacity * sizeof(uint32_t));
+    (void)memset(library_table, 0xFF, table_capacity * sizeof(uint32_t));
+
+    const size_t mask = table_capacity - 1;
+    for (size_t i = 0; i < library_count; i++)
+    {
+        size_t slot = (size_t)library[i].hash & mask;
+        while (library_table[slot] != MATERIAL_NONE)
+            slot = (slot + 1) & mask;
+        library_table[slot] = (uint32_t)i;
+    }
+}
+
+/**
+ * @brief Free the library once nothing refers to it anymore.
+ */
+static void FreeLibrary_(void)
+{
+    LetoFree(library);
+    LetoFree(library_table);
+    library = NULL;
+    library_table = NULL;
+    library_count = library_capacity = table_capacity = 0;
+}
+
+/**
+ * @brief Get a live library entry, reporting a stale handle if there is
+ * none at the index.
+ */
+static material_entry_t* GetEntry_(uint32_t material)
+{
+    if (material >= library_count || library[material].references == 0)
+    {
+        LetoReport(stale_handle);
+        return NULL;
+    }
+    return &library[material];
+}
+
+uint32_t LetoRegisterMaterial(const material_t* material)
+{
+    if (material == NULL)
+    {
+        LetoReport(null_param);
+        return MATERIAL_NONE;
+    }
+
+    material_t interned = *material;
+    if (interned.name != NULL)
+        interned.name =
+            LetoStringIntern(interned.name, strlen(interned.name));
+    for (size_t i = 0; i < material_map_count; i++)
+    {
+        const char* map = interned.maps[i];
+        if (map != NULL)
+            interned.maps[i] = LetoStringIntern(map, strlen(map));
+    }
+
+    // Keep the table under three quarters full.
+    if ((library_count + 1) * 4 > table_capacity * 3) GrowTable_();
+
+    const uint64_t hash = HashMaterial_(&interned);
+    uint32_t* slot = FindSlot_(&interned, hash);
+    if (*slot == MATERIAL_NONE)
+    {
+        if (library_count == library_capacity)
+        {
+            library_capacity = library_capacity == 0
+                                   ? MATERIAL_MIN_CAPACITY
+                                   : library_capacity * 2;
+            const size_t size =
+                library_capacity * sizeof(material_entry_t);
+            library = library == NULL ? LetoMalloc(memory_meshes, size)
+                                      : LetoRealloc(library, size);
+        }
+        library[library_count] = (material_entry_t){interned, hash, 0};
+        *slot = (uint32_t)library_count++;
+    }
+
+    library[*slot].references++;
+    library_references++;
+    return *slot;
+}
+
+void LetoRetainMaterial(uint32_t material)
+{
+    if (material == MATERIAL_NONE) return;
+
+    material_entry_t* entry = GetEntry_(material);
+    if (entry == NULL) return;
+    entry->references++;
+    library_references++;
+}
+
+void LetoReleaseMaterial(uint32_t material)
+{
+    if (material == MATERIAL_NONE) return;
+
+    material_entry_t* entry = GetEntry_(material);
+    if (entry == NULL) return;
+    entry->references--;
+    if (--library_references == 0) FreeLibrary_();
+}
+
+const material_t* LetoGetMaterial(uint32_t material)
+{
+    if (material >= library_count || library[material].references == 0)
+        return NULL;
+    return &library[material].material;
+}
+
+uint32_t LetoFindMaterial(const char* name, size_t length,
+                          const uint32_t* materials, size_t count)
+{
+    if (name == NULL || materials == NULL) return MATERIAL_NONE;
+
+    // A name that was never interned can't belong to any material.
+    const char* interned = LetoStringFindInterned(name, length);
+    if (interned == NULL) return MATERIAL_NONE;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const material_t* material = LetoGetMaterial(materials[i]);
+        if (material != NULL && material->name == interned)
+            return materials[i];
+    }
+    return MATERIAL_NONE;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Parse the arguments of a color statement, like "Kd". Either one
+ * value (used for all three channels) or three may be given. The rarely
+ * used "spectral" and "xyz" forms are skipped, leaving the color as is.
+ *
+ * PARAMETERS
+ *
+ * @param arguments The arguments of the statement.
+ * @param color The color to fill in.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the arguments were well-formed.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool ParseColor_(const char* arguments, float* color)
+{
+    if (strncmp(arguments, "spectral", 8) == 0 ||
+        strncmp(arguments, "xyz", 3) == 0)
+        return true;
+
+    float values[3];
+    size_t count = 0;
+    char* cursor = (char*)arguments;
+    while (count < 3)
+    {
+        char* next;
+        values[count] = strtof(cursor, &next);
+        if (next == cursor) break;
+        cursor = next;
+        count++;
+    }
+    while (IS_BLANK(*cursor)) cursor++;
+    if (*cursor != '\0' || (count != 1 && count != 3)) return false;
+
+    for (size_t i = 0; i < 3; i++) color[i] = values[count == 1 ? 0 : i];
+    return true;
+}
+
+/**
+ * @brief Parse the single number argument of a statement, like "Ns".
+ */
+static bool ParseScalar_(const char* arguments, float* value)
+{
+    char* end;
+    *value = strtof(arguments, &end);
+    if (end == arguments) return false;
+    while (IS_BLANK(*end)) end++;
+    return *end == '\0';
+}
+
+/**
+ * @brief Finish the material being described, if any, adding it to the
+ * library.
+ */
+static void CloseMaterial_(material_parser_t* parser)
+{
+    if (!parser->open) return;
+    parser->open = false;
+
+    if (parser->count == parser->capacity)
+    {
+        parser->capacity =
+            parser->capacity == 0 ? 8 : parser->capacity * 2;
+        const size_t size = parser->capacity * sizeof(uint32_t);
+        parser->materials =
+            parser->materials == NULL
+                ? LetoMalloc(memory_meshes, size)
+                : LetoRealloc(parser->materials, size);
+    }
+    parser->materials[parser->count++] =
+        LetoRegisterMaterial(&parser->current);
+}
+
+/**
+ * @brief Get the map a "map_" statement (or "bump") refers to, or @ref
+ * material_map_count if it's not one we read.
+ */
+static material_map_t GetMap_(const char* keyword)
+{
+    static const char* const keywords[] = {
+        "map_Ka", "map_Kd", "map_Ks",   "map_Ke",
+        "map_Ns", "map_d",  "map_Bump", "map_bump",
+        "bump"};
+    static const material_map_t maps[] = {
+        material_map_ambient,  material_map_diffuse, material_map_specular,
+        material_map_emission, material_map_exponent, material_map_alpha,
+        material_map_bump,     material_map_bump,     material_map_bump};
+
+    for (size_t i = 0; i < sizeof(maps) / sizeof(maps[0]); i++)
+        if (strcmp(keyword, keywords[i]) == 0) return maps[i];
+    return material_map_count;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Parse a single statement of an MTL file.
+ *
+ * PARAMETERS
+ *
+ * @param line The line holding the statement, NUL-terminated and without
+ * any leading or trailing blanks. This is modified.
+ * @param parser The state of the parse.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the statement was well-formed.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool ParseStatement_(char* line, material_parser_t* parser)
+{
+    if (*line == '\0' || *line == '#') return true;
+
+    // Split the keyword off of its arguments.
+    char* arguments = line;
+    while (*arguments != '\0' && !IS_BLANK(*arguments)) arguments++;
+    if (*arguments != '\0') *arguments++ = '\0';
+    while (IS_BLANK(*arguments)) arguments++;
+
+    material_t* material = &parser->current;
+    if (strcmp(line, "newmtl") == 0)
+    {
+        if (*arguments == '\0') return false;
+        CloseMaterial_(parser);
+
+        *material = (material_t){
+            .diffuse = {1.0f, 1.0f, 1.0f},
+            .transmission_filter = {1.0f, 1.0f, 1.0f},
+            .illumination = color_and_ambient,
+            .transparency = 1.0f,
+            .refraction = 1.0f,
+            .name = LetoStringIntern(arguments, strlen(arguments))};
+        parser->open = true;
+        return true;
+    }
+
+    const material_map_t map = GetMap_(line);
+    const bool known =
+        map != material_map_count || strcmp(line, "Ka") == 0 ||
+        strcmp(line, "Kd") == 0 || strcmp(line, "Ks") == 0 ||
+        strcmp(line, "Ke") == 0 || strcmp(line, "Tf") == 0 ||
+        strcmp(line, "Ns") == 0 || strcmp(line, "Ni") == 0 ||
+        strcmp(line, "d") == 0 || strcmp(line, "Tr") == 0 ||
+        strcmp(line, "illum") == 0;
+    if (!known) return true;
+    if (!parser->open) return false;
+
+    if (map != material_map_count)
+    {
+        // Options like "-s 1 1 1" come first, so the file name is the
+        // last argument.
+        const char* file = strrchr(arguments, ' ');
+        const char* tab = strrchr(arguments, '\t');
+        if (tab != NULL && (file == NULL || tab > file)) file = tab;
+        file = file == NULL ? arguments : file + 1;
+        if (*file == '\0') return false;
+
+        material->maps[map] = LetoStringIntern(file, strlen(file));
+        return true;
+    }
+
+    if (strcmp(line, "Ka") == 0)
+        return ParseColor_(arguments, material->ambient);
+    if (strcmp(line, "Kd") == 0)
+        return ParseColor_(arguments, material->diffuse);
+    if (strcmp(line, "Ks") == 0)
+        return ParseColor_(arguments, material->specular);
+    if (strcmp(line, "Ke") == 0)
+        return ParseColor_(arguments, material->emission);
+    if (strcmp(line, "Tf") == 0)
+        return ParseColor_(arguments, material->transmission_filter);
+    if (strcmp(line, "Ns") == 0)
+        return ParseScalar_(arguments, &material->specular[3]);
+    if (strcmp(line, "Ni") == 0)
+        return ParseScalar_(arguments, &material->refraction);
+    if (strcmp(line, "d") == 0)
+    {
+        // The halo form fades by viewing angle, which we don't support,
+        // so it's read as a plain dissolve.
+        if (strncmp(arguments, "-halo", 5) == 0 && IS_BLANK(arguments[5]))
+            arguments += 6;
+        return ParseScalar_(arguments, &material->transparency);
+    }
+    if (strcmp(line, "Tr") == 0)
+    {
+        float transparency;
+        if (!ParseScalar_(arguments, &transparency)) return false;
+        material->transparency = 1.0f - transparency;
+        return true;
+    }
+
+    char* end;
+    const long illumination = strtol(arguments, &end, 10);
+    if (end == arguments || *end != '\0' || illumination < 0 ||
+        illumination > shadows_on_invisible)
+        return false;
+    material->illumination = (illumination_t)illumination;
+    return true;
+}
+
+bool LetoParseMaterials(const char* buffer, size_t size,
+                        uint32_t** materials, size_t* count)
+{
+    if (buffer == NULL || materials == NULL || count == NULL)
+    {
+        LetoReport(null_param);
+        return false;
+    }
+
+    material_parser_t parser = {0};
+    const char *cursor = buffer, *end = buffer + size;
+    char line[MATERIAL_MAX_LINE];
+    bool valid = true;
+
+    while (valid && cursor < end)
+    {
+        const char* newline = memchr(cursor, '\n', (size_t)(end - cursor));
+        const char* line_end = newline == NULL ? end : newline;
+        size_t length = (size_t)(line_end - cursor);
+        if (length >= MATERIAL_MAX_LINE)
+        {
+            valid = false;
+            break;
+        }
+
+        // Trim the line down to its statement, dropping any carriage
+        // return along with the other trailing blanks.
+        while (length > 0 && (IS_BLANK(cursor[length - 1]) ||
+                              cursor[length - 1] == '\r'))
+            length--;
+        size_t start = 0;
+        while (start < length && IS_BLANK(cursor[start])) start++;
+        (void)memcpy(line, cursor + start, length - start);
+        line[length - start] = '\0';
+
+        valid = ParseStatement_(line, &parser);
+        cursor = newline == NULL ? end : newline + 1;
+    }
+
+    if (!valid)
+    {
+        for (size_t i = 0; i < parser.count; i++)
+            LetoReleaseMaterial(parser.materials[i]);
+        LetoFree(parser.materials);
+        LetoReport(material_malformed);
+        return false;
+    }
+
+    CloseMaterial_(&parser);
+    *materials = parser.materials;
+    *count = parser.count;
+    return true;
+}
+
+bool LetoLoadMaterials(const char* name, uint32_t** materials,
+                       size_t* count)
+{
+    if (name == NULL)
+    {
+        LetoReport(null_param);
+        return false;
+    }
+
+    char* path = LetoStringCreate(MAX_PATH_LENGTH,
+                                  ASSET_DIR "/meshes/%s", name);
+    mapping_t mapping;
+    const bool mapped = LetoMapFile(path, &mapping);
+    LetoStringFree(&path);
+    if (!mapped) return false;
+
+    const bool parsed = LetoParseMaterials((const char*)mapping.data,
+                                           mapping.size, materials, count);
+    LetoUnmapFile(&mapping);
+    return parsed;
+}
@@ -0,0 +1,316 @@
+/**
+ * @file Materials.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides Leto's material library, and the Wavefront MTL parser
+ * that fills it. Every material lives in one table shared by all meshes,
+ * and identical materials are stored once, so meshes refer to materials
+ * by their index in that table.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__MATERIALS__
+#define __LETO__MATERIALS__
+
+// The boolean type as described by the C standard.
+#include <stdbool.h>
+// Standard macro definitions, like size_t.
+#include <stddef.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+// CGLM's vector types.
+#include <vec3.h>
+#include <vec4.h>
+
+/**
+ * @brief The index standing in for "no material", used by geometry that
+ * never had one assigned.
+ */
+#define MATERIAL_NONE UINT32_MAX
+
+typedef enum
+{
+    color_no_ambient,
+    color_and_ambient,
+    highlight,
+    reflection_and_raytrace,
+    glass_and_raytrace,
+    fresnel_and_raytrace,
+    refraction_and_fresnel_and_raytrace,
+    refraction_and_raytrace,
+    reflection_no_raytrace,
+    glass_no_raytrace,
+    shadows_on_invisible
+} illumination_t;
+
+/**
+ * @brief The texture maps a material can reference, named after the MTL
+ * statement each is read from.
+ */
+typedef enum
+{
+    material_map_ambient,  // map_Ka
+    material_map_diffuse,  // map_Kd
+    material_map_specular, // map_Ks
+    material_map_emission, // map_Ke
+    material_map_exponent, // map_Ns
+    material_map_alpha,    // map_d
+    material_map_bump,     // map_Bump, map_bump, bump
+    /**
+     * @defgroup Map counter.
+     */
+    material_map_count,
+} material_map_t;
+
+typedef struct
+{
+    vec4 specular; // first three are spec, last is spec exponent
+    vec3 diffuse;
+    vec3 ambient;
+    /**
+     * @brief The color the material emits on its own.
+     */
+    vec3 emission;
+    vec3 transmission_filter; // only on transparent obj
+    illumination_t illumination;
+    /**
+     * @brief The opacity of the material, as MTL's "d" statement: 1 is
+     * fully opaque. "Tr" statements are inverted into this.
+     */
+    float transparency;
+    float refraction;
+    /**
+     * @brief The file names of the material's texture maps, or NULL for
+     * those it doesn't have. These are interned.
+     */
+    const char* maps[material_map_count];
+    /**
+     * @brief The name of the material. This is interned, so names can be
+     * compared by pointer.
+     */
+    const char* name;
+} material_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Add a material to the library, or find the identical one already
+ * in it. Either way, the material gains a reference, to be given up with
+ * @ref LetoReleaseMaterial. The material's strings are interned, so the
+ * caller's copies don't need to outlive the call. The library is not
+ * thread-safe, and must only be used from one thread at a time.
+ *
+ * PARAMETERS
+ *
+ * @param material The material to add.
+ *
+ * RETURN VALUE
+ *
+ * @return The index of the material within the library, or @ref
+ * MATERIAL_NONE if the material is NULL.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the material is NULL, this warning is thrown
+ * and @ref MATERIAL_NONE is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+uint32_t LetoRegisterMaterial(const material_t* material);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Add a reference to a material already in the library.
+ *
+ * PARAMETERS
+ *
+ * @param material The index of the material. @ref MATERIAL_NONE is
+ * ignored.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning stale_handle -- If the index doesn't refer to a live material,
+ * this warning is thrown and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoRetainMaterial(uint32_t material);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Give up a reference to a material. Once the last reference to
+ * the last material is given up, the library is freed.
+ *
+ * PARAMETERS
+ *
+ * @param material The index of the material. @ref MATERIAL_NONE is
+ * ignored.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning stale_handle -- If the index doesn't refer to a live material,
+ * this warning is thrown and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoReleaseMaterial(uint32_t material);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Get a material from the library.
+ *
+ * PARAMETERS
+ *
+ * @param material The index of the material.
+ *
+ * RETURN VALUE
+ *
+ * @return The material, which stays valid until its last reference is
+ * given up, or NULL if the index doesn't refer to a live material.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+const material_t* LetoGetMaterial(uint32_t material);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Find the material with a given name among a set of materials,
+ * like the ones read from a single MTL file.
+ *
+ * PARAMETERS
+ *
+ * @param name The name to look for. This does not need to be
+ * NUL-terminated.
+ * @param length The length of the name.
+ * @param materials The indices of the materials to search.
+ * @param count The amount of indices.
+ *
+ * RETURN VALUE
+ *
+ * @return The index of the first material with the name, or @ref
+ * MATERIAL_NONE if none have it.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+uint32_t LetoFindMaterial(const char* name, size_t length,
+                          const uint32_t* materials, size_t count);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Parse a Wavefront MTL file held in memory, adding every material
+ * it describes to the library. "newmtl", "Ka", "Kd", "Ks", "Ke", "Tf",
+ * "Ns", "Ni", "d", "Tr", "illum" and the "map_" statements of @ref
+ * material_map_t are read, everything else is skipped. The file is read
+ * one line at a time, and each material is registered as soon as the
+ * next begins.
+ *
+ * PARAMETERS
+ *
+ * @param buffer The contents of the file. This does not need to be
+ * NUL-terminated.
+ * @param size The size of the contents in bytes.
+ * @param materials The storage for the library indices of the materials,
+ * in file order. This is to be freed with @ref LetoFree, after releasing
+ * every index with @ref LetoReleaseMaterial.
+ * @param count The storage for the amount of materials.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the file was well-formed. Nothing is registered
+ * if it wasn't.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If any parameter is NULL, this warning is thrown
+ * and false is returned.
+ * @warning material_malformed -- If a statement comes before the first
+ * "newmtl", a number can't be read, or a line is too long, this warning
+ * is thrown and false is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+bool LetoParseMaterials(const char* buffer, size_t size,
+                        uint32_t** materials, size_t* count);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Load a Wavefront MTL file from the asset directory's meshes
+ * folder. See @ref LetoParseMaterials.
+ *
+ * PARAMETERS
+ *
+ * @param name The file name of the library, like "cube.mtl".
+ * @param materials The storage for the library indices of the materials.
+ * @param count The storage for the amount of materials.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the file could be read and parsed.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ * @note For warnings unhandled by this function, see @ref LetoMapFile and
+ * @ref LetoParseMaterials.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+bool LetoLoadMaterials(const char* name, uint32_t** materials,
+                       size_t* count);
+
+#endif // __LETO__MATERIALS__
@@ -1,22 +1,1814 @@
-#include "meshes.h"
-#include <io/files.h>
-#include <stdio.h>
-#include <utilities/strings.h>
+/**
+ * @file Meshes.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Meshes.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "meshes.h"               // Public interface parent
+#include <diagnostic/platform.h>  // Build type macros
+#include <io/files.h>             // File reading
+#include <io/reporter.h>          // Error / warning reporter
+#include <resources/bounds.h>     // Bounding volumes
+#include <resources/meshlets.h>   // Meshlet partitioning
+#include <resources/models.h>     // Model containers
+#include <resources/optimizer.h>  // Triangle and vertex reordering
+#include <resources/simplifier.h> // LOD chain generation
+#include <resources/tangents.h>   // Tangent generation
+#include <stdbool.h>              // Boolean type
+#include <stdio.h>                // Printf
+#include <stdlib.h>               // Qsort
+#include <string.h>               // Memchr, memcpy, strncmp
+#include <utilities/macros.h>     // Path length
+#include <utilities/memory.h>     // Tracked allocations
+#include <utilities/strings.h>    // String creation
+#include <utilities/threads.h>    // Chunk threads
+
+/**
+ * @brief The capacity an output array starts at. Every time it fills up,
+ * it doubles.
+ */
+#define MESH_INITIAL_CAPACITY 1024
+
+/**
+ * @brief The most threads a single parse will split across.
+ */
+#define MESH_MAX_THREADS 64
+
+/**
+ * @brief The smallest chunk worth handing to its own thread. Below this,
+ * starting the thread and stitching the chunk costs more than it saves.
+ */
+#define MESH_MIN_CHUNK_SIZE (256 * 1024)
+
+/**
+ * @brief The vertex stored in an unused welding table entry.
+ */
+#define WELD_EMPTY UINT32_MAX
+
+/**
+ * @brief The smallest capacity of a welding table.
+ */
+#define WELD_MIN_CAPACITY 64
+
+/**
+ * @brief The largest mantissa we keep accumulating digits into. Past this
+ * another digit could overflow, and a float can't hold it anyway.
+ */
+#define MANTISSA_LIMIT UINT64_C(100000000000000000)
+
+/**
+ * @brief The most decimal digits that always fit in a 64-bit mantissa.
+ */
+#define MAX_EXACT_DIGITS 19
+
+/**
+ * @brief Check if a character is a decimal digit. Unlike isdigit, this
+ * doesn't look at the locale.
+ */
+#define IS_DIGIT(character) ((unsigned)((character) - '0') < 10u)
+
+/**
+ * @brief Check if a character separates values on a line.
+ */
+#define IS_BLANK(character) ((character) == ' ' || (character) == '\t')
+
+/**
+ * @brief The powers of ten a double represents exactly. Multiplying an
+ * exact mantissa by one of these rounds only once.
+ */
+static const double powers_of_ten[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/**
+ * @brief The reciprocals of @ref powers_of_ten. These aren't exact, but
+ * multiplying by them is much cheaper than dividing, and the error is far
+ * below what rounding to a float throws away.
+ */
+static const double negative_powers_of_ten[] = {
+    1e0,   1e-1,  1e-2,  1e-3,  1e-4,  1e-5,  1e-6,  1e-7,
+    1e-8,  1e-9,  1e-10, 1e-11, 1e-12, 1e-13, 1e-14, 1e-15,
+    1e-16, 1e-17, 1e-18, 1e-19, 1e-20, 1e-21, 1e-22};
+
+/**
+ * @brief The vertex cache efficiency of a mesh imported by @ref
+ * LetoLoadMesh, kept for @ref LetoReportMeshImports.
+ */
+typedef struct
+{
+    /**
+     * @brief The mesh's name, interned.
+     */
+    const char* name;
+    mesh_optimization_t optimization;
+} mesh_import_t;
+
+/**
+ * @brief Every import made since the last report.
+ */
+static mesh_import_t* imports = NULL;
+
+/**
+ * @brief The amount of imports in @ref imports.
+ */
+static size_t import_count = 0;
+
+/**
+ * @brief The amount of imports @ref imports has room for.
+ */
+static size_t import_capacity = 0;
+
+/**
+ * @brief The index stored in a face corner for an attribute the corner
+ * doesn't reference, like the texture of "f 1//1".
+ */
+#define MESH_NO_INDEX UINT32_MAX
+
+/**
+ * @brief A single corner of a face. Each attribute is indexed separately,
+ * just like in the OBJ file, except zero-based and already resolved if
+ * the file used relative indices.
+ */
+typedef struct
+{
+    /**
+     * @brief The index of the corner's position within @ref
+     * mesh_source_t::vertices.
+     */
+    uint32_t vertex;
+    /**
+     * @brief The index of the corner's texture coordinate within @ref
+     * mesh_source_t::texture, or @ref MESH_NO_INDEX.
+     */
+    uint32_t texture;
+    /**
+     * @brief The index of the corner's normal within @ref
+     * mesh_source_t::normals, or @ref MESH_NO_INDEX.
+     */
+    uint32_t normal;
+} face_corner_t;
+
+/**
+ * @brief A triangle. Polygons with more corners are split into a fan of
+ * these on import.
+ */
+typedef struct
+{
+    face_corner_t corners[3];
+} face_t;
+
+/**
+ * @brief A mesh exactly as the OBJ file describes it, with every attribute
+ * in its own array and indexed separately. This is what the parser
+ * produces, and what gets welded into a @ref mesh_t.
+ */
+typedef struct
+{
+    /**
+     * @brief The positions of the mesh, one per "v" line.
+     */
+    vec3* vertices;
+    /**
+     * @brief The normals of the mesh, one per "vn" line.
+     */
+    vec3* normals;
+    /**
+     * @brief The texture coordinates of the mesh, one per "vt" line.
+     * Components missing from the file are 0.
+     */
+    vec3* texture;
+    /**
+     * @brief The triangles of the mesh.
+     */
+    face_t* faces;
+    size_t vertex_count;
+    size_t normal_count;
+    size_t texture_count;
+    size_t face_count;
+} mesh_source_t;
+
+/**
+ * @brief An entry of the welding hash table, mapping a unique face corner
+ * to the vertex built from it.
+ */
+typedef struct
+{
+    face_corner_t key;
+    /**
+     * @brief The index of the vertex, or @ref WELD_EMPTY if the entry is
+     * unused.
+     */
+    uint32_t vertex;
+} weld_entry_t;
+
+/**
+ * @brief An open addressing hash table mapping face corners to welded
+ * vertices.
+ */
+typedef struct
+{
+    weld_entry_t* entries;
+    /**
+     * @brief The amount of entries in the table. This is a power of two.
+     */
+    size_t capacity;
+    /**
+     * @brief The amount of slots set aside per source position. This is a
+     * power of two.
+     */
+    size_t spacing;
+} weld_table_t;
+
+/**
+ * @brief The attributes a face corner indexes.
+ */
+typedef enum
+{
+    attribute_vertex,
+    attribute_texture,
+    attribute_normal,
+    /**
+     * @defgroup Attribute counter.
+     */
+    attribute_count,
+} mesh_attribute_t;
+
+/**
+ * @brief A name read from the file, pointing into the parsed buffer.
+ */
+typedef struct
+{
+    const char* start;
+    size_t length;
+} mesh_name_t;
+
+/**
+ * @brief A "usemtl" statement: the triangles from a face onward use the
+ * named material, up until the next statement.
+ */
+typedef struct
+{
+    mesh_name_t material;
+    /**
+     * @brief The first face using the material, within its chunk.
+     */
+    size_t face;
+} mesh_run_t;
+
+/**
+ * @brief A relative index that couldn't be resolved while parsing, because
+ * the chunk it's in doesn't yet know how many elements came before it.
+ */
+typedef struct
+{
+    /**
+     * @brief The face the index belongs to, within its chunk.
+     */
+    size_t face;
+    /**
+     * @brief The corner of the face the index belongs to.
+     */
+    uint8_t corner;
+    /**
+     * @brief The attribute the index refers to.
+     */
+    uint8_t attribute;
+    /**
+     * @brief The index relative to the start of the chunk. This is
+     * negative if it points into an earlier chunk.
+     */
+    int64_t offset;
+} mesh_fixup_t;
+
+/**
+ * @brief A face corner in the middle of being parsed, along with any of
+ * its indices that have to wait for stitching to be resolved.
+ */
+typedef struct
+{
+    face_corner_t corner;
+    /**
+     * @brief A bitmask of the attributes whose index is deferred.
+     */
+    uint32_t deferred;
+    /**
+     * @brief The chunk-relative offsets of the deferred indices.
+     */
+    int64_t offsets[attribute_count];
+} mesh_corner_t;
+
+/**
+ * @brief The state of one chunk of a parse; a serial parse is just one
+ * chunk. The capacities live here instead of the mesh because they mean
+ * nothing once parsing is done.
+ */
+typedef struct
+{
+    /**
+     * @brief The elements parsed from this chunk alone.
+     */
+    mesh_source_t mesh;
+    size_t vertex_capacity;
+    size_t normal_capacity;
+    size_t texture_capacity;
+    size_t face_capacity;
+    mesh_fixup_t* fixups;
+    size_t fixup_count;
+    size_t fixup_capacity;
+    /**
+     * @brief The material runs started within this chunk.
+     */
+    mesh_run_t* runs;
+    size_t run_count;
+    size_t run_capacity;
+    /**
+     * @brief The material libraries named by "mtllib" statements within
+     * this chunk.
+     */
+    mesh_name_t* libraries;
+    size_t library_count;
+    size_t library_capacity;
+    /**
+     * @brief Whether or not the chunk starts the file. Only then are the
+     * counts it sees global, so only then can relative indices be
+     * resolved straight away.
+     */
+    bool first;
+    /**
+     * @brief The run of lines the chunk covers.
+     */
+    const char* start;
+    const char* end;
+    /**
+     * @brief Whether or not the chunk has been parsed and stitched without
+     * finding anything malformed.
+     */
+    bool valid;
+    /**
+     * @brief The amount of each attribute (and, in the last slot, faces)
+     * parsed by earlier chunks.
+     */
+    size_t bases[attribute_count + 1];
+    /**
+     * @brief The mesh the chunk is stitched into.
+     */
+    mesh_source_t* output;
+} mesh_parser_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Make sure an output array can hold one more element, doubling its
+ * capacity if it can't.
+ *
+ * PARAMETERS
+ *
+ * @param array The array to grow. This may be NULL.
+ * @param capacity The capacity of the array, in elements.
+ * @param count The amount of elements in the array.
+ * @param stride The size of a single element.
+ *
+ * RETURN VALUE
+ *
+ * @return The (possibly moved) array.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For errors unhandled by this function, see @ref LetoMalloc.
+ *
+ */
+static void* Reserve_(void* array, size_t* capacity, size_t count,
+                      size_t stride)
+{
+    if (count < *capacity) return array;
+
+    *capacity = *capacity == 0 ? MESH_INITIAL_CAPACITY : *capacity * 2;
+    if (array == NULL)
+        return LetoMalloc(memory_meshes, *capacity * stride);
+    return LetoRealloc(array, *capacity * stride);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Parse a decimal floating point number, with an optional sign,
+ * fraction and exponent. Digits are gathered into an integer mantissa and
+ * scaled once at the end, which is exact to within a rounding of the
+ * float for every value an OBJ exporter realistically writes.
+ *
+ * PARAMETERS
+ *
+ * @param cursor Where the number starts.
+ * @param value The storage for the parsed number.
+ *
+ * RETURN VALUE
+ *
+ * @return The character after the number, or NULL if there was no number.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static const char* ParseFloat_(const char* cursor, float* value)
+{
+    bool negative = false;
+    if (*cursor == '-' || *cursor == '+') negative = *cursor++ == '-';
+
+    // Gather every digit without checking for overflow, as almost every
+    // number is short enough not to. Those that aren't are gathered again,
+    // keeping only the digits that fit.
+    const char* digits_start = cursor;
+    uint64_t mantissa = 0;
+    int exponent = 0;
+
+    for (; IS_DIGIT(*cursor); cursor++)
+        mantissa = mantissa * 10 + (uint64_t)(*cursor - '0');
+    const char* period = cursor;
+    if (*cursor == '.')
+        for (cursor++; IS_DIGIT(*cursor); cursor++)
+            mantissa = mantissa * 10 + (uint64_t)(*cursor - '0');
+    const int digit_count =
+        (int)(cursor - digits_start) - (period != cursor);
+
+    // A lone sign or period isn't a number.
+    if (digit_count == 0) return NULL;
+    if (digit_count <= MAX_EXACT_DIGITS)
+        exponent = period == cursor ? 0 : -(int)(cursor - period - 1);
+    else
+    {
+        mantissa = 0;
+        for (const char* digit = digits_start; digit != cursor; digit++)
+        {
+            if (digit == period) continue;
+            if (mantissa < MANTISSA_LIMIT)
+            {
+                mantissa = mantissa * 10 + (uint64_t)(*digit - '0');
+                if (digit > period) exponent -= 1;
+            }
+            else if (digit < period) exponent += 1;
+        }
+    }
+
+    if ((*cursor == 'e' || *cursor == 'E') &&
+        (IS_DIGIT(cursor[1]) ||
+         ((cursor[1] == '-' || cursor[1] == '+') && IS_DIGIT(cursor[2]))))
+    {
+        const bool exponent_negative = *++cursor == '-';
+        if (!IS_DIGIT(*cursor)) cursor++;
+
+        int written = 0;
+        for (; IS_DIGIT(*cursor); cursor++)
+            if (written < 10000) written = written * 10 + *cursor - '0';
+        exponent += exponent_negative ? -written : written;
+    }
+
+    double result = (double)mantissa;
+    if (mantissa != 0)
+    {
+        for (; exponent < -22; exponent += 22) result *= 1e-22;
+        for (; exponent > 22; exponent -= 22) result *= 1e22;
+        if (exponent < 0) result *= negative_powers_of_ten[-exponent];
+        else result *= powers_of_ten[exponent];
+    }
+
+    *value = (float)(negative ? -result : result);
+    return cursor;
+}
+
+/**
+ * @brief Get the index a corner stores for an attribute.
+ */
+static inline uint32_t* CornerIndex_(face_corner_t* corner,
+                                     mesh_attribute_t attribute)
+{
+    switch (attribute)
+    {
+        case attribute_texture: return &corner->texture;
+        case attribute_normal:  return &corner->normal;
+        default:                return &corner->vertex;
+    }
+}
+
+/**
+ * @brief Get the amount of elements a mesh holds for an attribute.
+ */
+static inline size_t AttributeCount_(const mesh_source_t* mesh,
+                                     mesh_attribute_t attribute)
+{
+    switch (attribute)
+    {
+        case attribute_texture: return mesh->texture_count;
+        case attribute_normal:  return mesh->normal_count;
+        default:                return mesh->vertex_count;
+    }
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Parse a face index and resolve it against the amount of elements
+ * the chunk has read so far. Positive indices are one-based, negative
+ * ones count back from the last element. Positive indices aren't checked
+ * against the count, as the file may define the element later. Negative
+ * indices outside of the first chunk are deferred until stitching.
+ *
+ * PARAMETERS
+ *
+ * @param cursor Where the index starts.
+ * @param parser The chunk being parsed.
+ * @param attribute The attribute the index refers to.
+ * @param parsed The corner to store the index in.
+ *
+ * RETURN VALUE
+ *
+ * @return The character after the index, or NULL if the index is missing,
+ * zero, or out of range.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static const char* ParseIndex_(const char* cursor,
+                               const mesh_parser_t* parser,
+                               mesh_attribute_t attribute,
+                               mesh_corner_t* parsed)
+{
+    const bool negative = *cursor == '-';
+    if (negative) cursor++;
+
+    if (!IS_DIGIT(*cursor)) return NULL;
+    const char* digits_start = cursor;
+    uint64_t value = 0;
+    for (; IS_DIGIT(*cursor); cursor++)
+        value = value * 10 + (uint64_t)(*cursor - '0');
+    // Ten digits can't overflow the accumulator, but can overflow an
+    // index.
+    if (cursor - digits_start > 10 || value == 0 || value >= MESH_NO_INDEX)
+        return NULL;
+
+    uint32_t* index = CornerIndex_(&parsed->corner, attribute);
+    if (!negative)
+    {
+        *index = (uint32_t)(value - 1);
+        return cursor;
+    }
+
+    const int64_t offset =
+        (int64_t)AttributeCount_(&parser->mesh, attribute) -
+        (int64_t)value;
+    if (!parser->first)
+    {
+        parsed->deferred |= UINT32_C(1) << attribute;
+        parsed->offsets[attribute] = offset;
+        *index = 0;
+        return cursor;
+    }
+    if (offset < 0) return NULL;
+
+    *index = (uint32_t)offset;
+    return cursor;
+}
+
+/**
+ * @brief Skip spaces and tabs.
+ */
+static inline const char* SkipBlank_(const char* cursor)
+{
+    while (IS_BLANK(*cursor)) cursor++;
+    return cursor;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Parse up to three blank-separated floats into a vector. Values
+ * missing before the end of the line are left as 0.
+ *
+ * PARAMETERS
+ *
+ * @param cursor Where the first value starts.
+ * @param minimum The amount of values that must be present.
+ * @param vector The storage for the values.
+ *
+ * RETURN VALUE
+ *
+ * @return The character after the last value read, or NULL if fewer than
+ * the minimum amount of values could be read.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static const char* ParseVector_(const char* cursor, int minimum,
+                                vec3 vector)
+{
+    vector[0] = vector[1] = vector[2] = 0.0f;
+    for (int i = 0; i < 3; i++)
+    {
+        cursor = SkipBlank_(cursor);
+        const char* next = ParseFloat_(cursor, &vector[i]);
+        if (next == NULL) return i < minimum ? NULL : cursor;
+        cursor = next;
+    }
+    return cursor;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Parse a single face corner in any of the "v", "v/vt", "v//vn" or
+ * "v/vt/vn" forms.
+ *
+ * PARAMETERS
+ *
+ * @param cursor Where the corner starts.
+ * @param parser The chunk being parsed.
+ * @param parsed The storage for the corner.
+ *
+ * RETURN VALUE
+ *
+ * @return The character after the corner, or NULL if it is malformed.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static const char* ParseCorner_(const char* cursor,
+                                const mesh_parser_t* parser,
+                                mesh_corner_t* parsed)
+{
+    parsed->corner.texture = parsed->corner.normal = MESH_NO_INDEX;
+    parsed->deferred = 0;
+
+    cursor = ParseIndex_(cursor, parser, attribute_vertex, parsed);
+    if (cursor == NULL || *cursor != '/') return cursor;
+
+    if (*++cursor != '/')
+    {
+        cursor = ParseIndex_(cursor, parser, attribute_texture, parsed);
+        if (cursor == NULL || *cursor != '/') return cursor;
+    }
+
+    return ParseIndex_(cursor + 1, parser, attribute_normal, parsed);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Record the deferred indices of a freshly written face, so they
+ * can be resolved once the chunk is stitched.
+ *
+ * PARAMETERS
+ *
+ * @param parser The chunk being parsed.
+ * @param corners The corners of the face, in the order they were written.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void DeferFace_(mesh_parser_t* parser,
+                       const mesh_corner_t* corners[3])
+{
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        for (uint8_t j = 0; j < attribute_count; j++)
+        {
+            if ((corners[i]->deferred & (UINT32_C(1) << j)) == 0) continue;
+
+            parser->fixups =
+                Reserve_(parser->fixups, &parser->fixup_capacity,
+                         parser->fixup_count, sizeof(mesh_fixup_t));
+            parser->fixups[parser->fixup_count++] = (mesh_fixup_t){
+                parser->mesh.face_count - 1, i, j, corners[i]->offsets[j]};
+        }
+    }
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Parse the corners of an "f" line, splitting polygons into a fan
+ * of triangles around the first corner.
+ *
+ * PARAMETERS
+ *
+ * @param cursor Where the first corner starts.
+ * @param parser The chunk being parsed.
+ *
+ * RETURN VALUE
+ *
+ * @return The character after the last corner, or NULL if the face is
+ * malformed or has fewer than three corners.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static const char* ParseFace_(const char* cursor, mesh_parser_t* parser)
+{
+    mesh_source_t* mesh = &parser->mesh;
+    mesh_corner_t first, previous, current;
+
+    cursor = ParseCorner_(SkipBlank_(cursor), parser, &first);
+    if (cursor == NULL) return NULL;
+    cursor = ParseCorner_(SkipBlank_(cursor), parser, &previous);
+    if (cursor == NULL) return NULL;
+
+    size_t corners = 2;
+    while (true)
+    {
+        cursor = SkipBlank_(cursor);
+        if (!IS_DIGIT(*cursor) && *cursor != '-') break;
+        cursor = ParseCorner_(cursor, parser, &current);
+        if (cursor == NULL) return NULL;
+
+        mesh->faces = Reserve_(mesh->faces, &parser->face_capacity,
+                               mesh->face_count, sizeof(face_t));
+        mesh->faces[mesh->face_count++] = (face_t){
+            {first.corner, previous.corner, current.corner}};
+        if ((first.deferred | previous.deferred | current.deferred) != 0)
+            DeferFace_(parser, (const mesh_corner_t*[3]){
+                                   &first, &previous, &current});
+
+        previous = current;
+        corners++;
+    }
+
+    return corners < 3 ? NULL : cursor;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Parse the name of a "usemtl" line, starting a new material run at
+ * the next face. The name is everything up to the end of the line, less
+ * any trailing blanks.
+ *
+ * PARAMETERS
+ *
+ * @param cursor Where the name starts.
+ * @param parser The chunk being parsed.
+ *
+ * RETURN VALUE
+ *
+ * @return The newline ending the line, or NULL if the name is empty.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static const char* ParseUseMaterial_(const char* cursor,
+                                     mesh_parser_t* parser)
+{
+    cursor = SkipBlank_(cursor);
+    const char* end = cursor;
+    while (*end != '\n') end++;
+    const char* newline = end;
+    while (end > cursor && (IS_BLANK(end[-1]) || end[-1] == '\r')) end--;
+    if (end == cursor) return NULL;
+
+    parser->runs = Reserve_(parser->runs, &parser->run_capacity,
+                            parser->run_count, sizeof(mesh_run_t));
+    parser->runs[parser->run_count++] = (mesh_run_t){
+        {cursor, (size_t)(end - cursor)}, parser->mesh.face_count};
+    return newline;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Parse the blank-separated file names of a "mtllib" line.
+ *
+ * PARAMETERS
+ *
+ * @param cursor Where the first name starts.
+ * @param parser The chunk being parsed.
+ *
+ * RETURN VALUE
+ *
+ * @return The end of the last name.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static const char* ParseLibraries_(const char* cursor,
+                                   mesh_parser_t* parser)
+{
+    while (true)
+    {
+        cursor = SkipBlank_(cursor);
+        const char* start = cursor;
+        while (!IS_BLANK(*cursor) && *cursor != '\r' && *cursor != '\n')
+            cursor++;
+        if (cursor == start) return cursor;
+
+        parser->libraries =
+            Reserve_(parser->libraries, &parser->library_capacity,
+                     parser->library_count, sizeof(mesh_name_t));
+        parser->libraries[parser->library_count++] =
+            (mesh_name_t){start, (size_t)(cursor - start)};
+    }
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Parse a run of whole lines. The run must end with a newline,
+ * which is what lets every scan inside a line go without bounds checks:
+ * none of them can step past a newline.
+ *
+ * PARAMETERS
+ *
+ * @param cursor The start of the run.
+ * @param end The end of the run, just past its final newline.
+ * @param parser The chunk being parsed.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not every line was well-formed.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool ParseLines_(const char* cursor, const char* end,
+                        mesh_parser_t* parser)
+{
+    mesh_source_t* mesh = &parser->mesh;
+
+    while (cursor < end)
+    {
+        cursor = SkipBlank_(cursor);
+        if (cursor[0] == 'v' && IS_BLANK(cursor[1]))
+        {
+            mesh->vertices =
+                Reserve_(mesh->vertices, &parser->vertex_capacity,
+                         mesh->vertex_count, sizeof(vec3));
+            cursor = ParseVector_(cursor + 2, 3,
+                                  mesh->vertices[mesh->vertex_count++]);
+        }
+        else if (cursor[0] == 'v' && cursor[1] == 'n' &&
+                 IS_BLANK(cursor[2]))
+        {
+            mesh->normals =
+                Reserve_(mesh->normals, &parser->normal_capacity,
+                         mesh->normal_count, sizeof(vec3));
+            cursor = ParseVector_(cursor + 3, 3,
+                                  mesh->normals[mesh->normal_count++]);
+        }
+        else if (cursor[0] == 'v' && cursor[1] == 't' &&
+                 IS_BLANK(cursor[2]))
+        {
+            mesh->texture =
+                Reserve_(mesh->texture, &parser->texture_capacity,
+                         mesh->texture_count, sizeof(vec3));
+            cursor = ParseVector_(cursor + 3, 1,
+                                  mesh->texture[mesh->texture_count++]);
+        }
+        else if (cursor[0] == 'f' && IS_BLANK(cursor[1]))
+            cursor = ParseFace_(cursor + 2, parser);
+        else if (strncmp(cursor, "usemtl", 6) == 0 && IS_BLANK(cursor[6]))
+            cursor = ParseUseMaterial_(cursor + 7, parser);
+        else if (strncmp(cursor, "mtllib", 6) == 0 && IS_BLANK(cursor[6]))
+            cursor = ParseLibraries_(cursor + 7, parser);
+        if (cursor == NULL) return false;
+
+        // Whatever is left of the line is either a trailing comment, an
+        // ignored component (like vertex colors), or an unknown statement.
+        if (*cursor != '\n')
+            cursor = memchr(cursor, '\n', (size_t)(end - cursor));
+        cursor++;
+    }
+
+    return true;
+}
+
+/**
+ * @brief The thread entry point parsing a single chunk.
+ */
+static void ParseChunk_(void* chunk)
+{
+    mesh_parser_t* parser = chunk;
+    parser->valid = ParseLines_(parser->start, parser->end, parser);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Check that every face index in a range refers to an element that
+ * exists. Relative indices are checked while parsing or stitching, but
+ * absolute ones can refer forward, so they're checked once everything has
+ * been read.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The stitched mesh.
+ * @param first The first face to check.
+ * @param count The amount of faces to check.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not every index is in range.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool ValidateFaces_(const mesh_source_t* mesh, size_t first,
+                           size_t count)
+{
+    for (size_t i = first; i < first + count; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+        {
+            const face_corner_t* corner = &mesh->faces[i].corners[j];
+            if (corner->vertex >= mesh->vertex_count) return false;
+            if (corner->texture != MESH_NO_INDEX &&
+                corner->texture >= mesh->texture_count)
+                return false;
+            if (corner->normal != MESH_NO_INDEX &&
+                corner->normal >= mesh->normal_count)
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Copy one of a chunk's arrays into its place in the output.
+ */
+static void CopyChunkArray_(void* destination, const void* source,
+                            size_t count, size_t stride)
+{
+    if (count != 0) (void)memcpy(destination, source, count * stride);
+}
+
+/**
+ * @brief The thread entry point stitching a single chunk into the output:
+ * its elements are copied into place, its deferred indices are resolved
+ * against its bases, and then its faces are validated.
+ */
+static void StitchChunk_(void* chunk)
+{
+    mesh_parser_t* parser = chunk;
+    const mesh_source_t* mesh = &parser->mesh;
+    mesh_source_t* output = parser->output;
+    const size_t* bases = parser->bases;
+
+    CopyChunkArray_(output->vertices + bases[attribute_vertex],
+                    mesh->vertices, mesh->vertex_count, sizeof(vec3));
+    CopyChunkArray_(output->texture + bases[attribute_texture],
+                    mesh->texture, mesh->texture_count, sizeof(vec3));
+    CopyChunkArray_(output->normals + bases[attribute_normal],
+                    mesh->normals, mesh->normal_count, sizeof(vec3));
+    face_t* faces = output->faces + bases[attribute_count];
+    CopyChunkArray_(faces, mesh->faces, mesh->face_count, sizeof(face_t));
+
+    parser->valid = false;
+    for (size_t i = 0; i < parser->fixup_count; i++)
+    {
+        const mesh_fixup_t* fixup = &parser->fixups[i];
+        const int64_t index =
+            (int64_t)bases[fixup->attribute] + fixup->offset;
+        if (index < 0) return;
+
+        face_corner_t* corner = &faces[fixup->face].corners[fixup->corner];
+        *CornerIndex_(corner, (mesh_attribute_t)fixup->attribute) =
+            (uint32_t)index;
+    }
+    parser->valid = ValidateFaces_(output, bases[attribute_count],
+                                   mesh->face_count);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Run a function over every chunk, one thread per chunk. The first
+ * chunk runs on the calling thread.
+ *
+ * PARAMETERS
+ *
+ * @param parsers The chunks.
+ * @param count The amount of chunks.
+ * @param function The function to run.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not every chunk came out valid.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For errors unhandled by this function, see @ref LetoCreateThread.
+ *
+ */
+static bool RunChunks_(mesh_parser_t* parsers, size_t count,
+                       thread_function_t function)
+{
+    thread_t threads[MESH_MAX_THREADS];
+    for (size_t i = 1; i < count; i++)
+        LetoCreateThread(&threads[i], function, &parsers[i]);
+    function(&parsers[0]);
+    for (size_t i = 1; i < count; i++) LetoJoinThread(&threads[i]);
+
+    bool valid = true;
+    for (size_t i = 0; i < count; i++) valid &= parsers[i].valid;
+    return valid;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Split a run of lines into chunks of roughly equal size. Every
+ * chunk ends just after a newline, though chunks may be empty if the run
+ * holds very long lines.
+ *
+ * PARAMETERS
+ *
+ * @param parsers The chunks to fill in.
+ * @param count The amount of chunks.
+ * @param start The start of the run.
+ * @param end The end of the run, just past its final newline.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void SplitChunks_(mesh_parser_t* parsers, size_t count,
+                         const char* start, const char* end)
+{
+    const size_t size = (size_t)(end - start);
+    const char* boundary = start;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        parsers[i].first = i == 0;
+        parsers[i].start = boundary;
+        if (i == count - 1)
+        {
+            parsers[i].end = end;
+            break;
+        }
+
+        const char* split = start + size / count * (i + 1);
+        if (split < boundary) split = boundary;
+        const char* newline = memchr(split, '\n', (size_t)(end - split));
+        boundary = newline == NULL ? end : newline + 1;
+        parsers[i].end = boundary;
+    }
+}
+
+/**
+ * @brief Free the arrays of a source mesh.
+ */
+static void FreeSource_(mesh_source_t* source)
+{
+    LetoFree(source->vertices);
+    LetoFree(source->normals);
+    LetoFree(source->texture);
+    LetoFree(source->faces);
+    *source = (mesh_source_t){0};
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Join parsed chunks into one source mesh. A single chunk is simply
+ * moved. Otherwise the chunks' element counts are prefix-summed into
+ * bases, and each chunk is copied into place and resolved in parallel.
+ *
+ * PARAMETERS
+ *
+ * @param parsers The parsed chunks.
+ * @param count The amount of chunks.
+ * @param source The storage for the joined mesh. This must be zeroed, and
+ * must be freed with @ref FreeSource_ whatever the outcome.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not every index is in range.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool Stitch_(mesh_parser_t* parsers, size_t count,
+                    mesh_source_t* source)
+{
+    if (count == 1)
+    {
+        *source = parsers[0].mesh;
+        parsers[0].mesh = (mesh_source_t){0};
+        return ValidateFaces_(source, 0, source->face_count);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const mesh_source_t* chunk = &parsers[i].mesh;
+        parsers[i].output = source;
+        parsers[i].bases[attribute_vertex] = source->vertex_count;
+        parsers[i].bases[attribute_texture] = source->texture_count;
+        parsers[i].bases[attribute_normal] = source->normal_count;
+        parsers[i].bases[attribute_count] = source->face_count;
+
+        source->vertex_count += chunk->vertex_count;
+        source->texture_count += chunk->texture_count;
+        source->normal_count += chunk->normal_count;
+        source->face_count += chunk->face_count;
+    }
+
+    if (source->vertex_count != 0)
+        source->vertices =
+            LetoMalloc(memory_meshes, source->vertex_count * sizeof(vec3));
+    if (source->texture_count != 0)
+        source->texture = LetoMalloc(memory_meshes,
+                                     source->texture_count * sizeof(vec3));
+    if (source->normal_count != 0)
+        source->normals =
+            LetoMalloc(memory_meshes, source->normal_count * sizeof(vec3));
+    if (source->face_count != 0)
+        source->faces =
+            LetoMalloc(memory_meshes, source->face_count * sizeof(face_t));
+
+    return RunChunks_(parsers, count, StitchChunk_);
+}
+
+/**
+ * @brief Compare two material groups by material, then by position in the
+ * file, for @ref Group_.
+ */
+static int CompareGroups_(const void* a, const void* b)
+{
+    const mesh_submesh_t *first = a, *second = b;
+    if (first->material != second->material)
+        return first->material < second->material ? -1 : 1;
+    return first->first_index < second->first_index ? -1 : 1;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Resolve the material runs of a stitched mesh, and reorder its
+ * faces so that each material's faces are contiguous. Every library the
+ * file names is loaded and searched for each "usemtl" name, in file order;
+ * names found in none of them, and faces before the first "usemtl", get
+ * @ref MATERIAL_NONE. The runs are then sorted by library index, which
+ * keeps faces in file order within a material, and merged into submeshes.
+ *
+ * PARAMETERS
+ *
+ * @param parsers The stitched chunks.
+ * @param count The amount of chunks.
+ * @param source The stitched mesh, whose faces are reordered.
+ * @param submesh_count The storage for the amount of submeshes.
+ *
+ * RETURN VALUE
+ *
+ * @return The submeshes, each holding a reference to its material, with
+ * index ranges in terms of the reordered faces. This is NULL if the mesh
+ * has no faces.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ * @note For warnings unhandled by this function, see @ref
+ * LetoLoadMaterials.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static mesh_submesh_t* Group_(const mesh_parser_t* parsers, size_t count,
+                              mesh_source_t* source,
+                              size_t* submesh_count)
+{
+    *submesh_count = 0;
+    if (source->face_count == 0) return NULL;
+
+    uint32_t* materials = NULL;
+    size_t material_count = 0, group_count = 1;
+    for (size_t i = 0; i < count; i++)
+    {
+        group_count += parsers[i].run_count;
+        for (size_t j = 0; j < parsers[i].library_count; j++)
+        {
+            const mesh_name_t* library = &parsers[i].libraries[j];
+            char* name = LetoStringCreate(MAX_PATH_LENGTH, "%.*s",
+                                          (int)library->length,
+                                          library->start);
+            uint32_t* loaded;
+            size_t loaded_count;
+            if (LetoLoadMaterials(name, &loaded, &loaded_count) &&
+                loaded_count != 0)
+            {
+                const size_t size =
+                    (material_count + loaded_count) * sizeof(uint32_t);
+                materials = materials == NULL
+                                ? LetoMalloc(memory_meshes, size)
+                                : LetoRealloc(materials, size);
+                (void)memcpy(materials + material_count, loaded,
+                             loaded_count * sizeof(uint32_t));
+                material_count += loaded_count;
+                LetoFree(loaded);
+            }
+            LetoStringFree(&name);
+        }
+    }
+
+    // Groups are built in terms of faces, and only scaled to indices once
+    // they're merged into submeshes.
+    mesh_submesh_t* groups =
+        LetoMalloc(memory_meshes, group_count * sizeof(mesh_submesh_t));
+    groups[0] = (mesh_submesh_t){.material = MATERIAL_NONE};
+    group_count = 1;
+    for (size_t i = 0; i < count; i++)
+    {
+        for (size_t j = 0; j < parsers[i].run_count; j++)
+        {
+            const mesh_run_t* run = &parsers[i].runs[j];
+            const size_t first_face =
+                parsers[i].bases[attribute_count] + run->face;
+            groups[group_count++] = (mesh_submesh_t){
+                .first_index = first_face,
+                .material = LetoFindMaterial(run->material.start,
+                                             run->material.length,
+                                             materials, material_count)};
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < group_count; i++)
+    {
+        const size_t end = i + 1 < group_count ? groups[i + 1].first_index
+                                               : source->face_count;
+        groups[i].index_count = end - groups[i].first_index;
+        if (groups[i].index_count != 0) groups[kept++] = groups[i];
+    }
+    group_count = kept;
+    qsort(groups, group_count, sizeof(mesh_submesh_t), CompareGroups_);
+
+    bool reordered = false;
+    for (size_t i = 0, face = 0; i < group_count; i++)
+    {
+        reordered |= groups[i].first_index != face;
+        face += groups[i].index_count;
+    }
+    if (reordered)
+    {
+        face_t* faces =
+            LetoMalloc(memory_meshes, source->face_count * sizeof(face_t));
+        for (size_t i = 0, face = 0; i < group_count; i++)
+        {
+            (void)memcpy(faces + face,
+                         source->faces + groups[i].first_index,
+                         groups[i].index_count * sizeof(face_t));
+            face += groups[i].index_count;
+        }
+        LetoFree(source->faces);
+        source->faces = faces;
+    }
+
+    // Merge neighbouring groups of the same material into one submesh.
+    mesh_submesh_t* submeshes = groups;
+    size_t face = 0;
+    for (size_t i = 0; i < group_count; i++)
+    {
+        // The submeshes are written over the groups, so read the group
+        // out before its slot can be reused.
+        const mesh_submesh_t group = groups[i];
+        const size_t last = *submesh_count - 1;
+        if (*submesh_count != 0 &&
+            submeshes[last].material == group.material)
+            submeshes[last].index_count += group.index_count * 3;
+        else
+        {
+            LetoRetainMaterial(group.material);
+            submeshes[(*submesh_count)++] =
+                (mesh_submesh_t){.first_index = face * 3,
+                                 .index_count = group.index_count * 3,
+                                 .material = group.material};
+        }
+        face += group.index_count;
+    }
+
+    for (size_t i = 0; i < material_count; i++)
+        LetoReleaseMaterial(materials[i]);
+    LetoFree(materials);
+    return LetoRealloc(submeshes,
+                       *submesh_count * sizeof(mesh_submesh_t));
+}
+
+/**
+ * @brief Mix the texture and normal indices of a face corner, to pick a
+ * slot among those set aside for its position.
+ */
+static inline size_t HashAttributes_(const face_corner_t* corner)
+{
+    const uint64_t hash =
+        (uint64_t)corner->texture * UINT64_C(0x9E3779B97F4A7C15) ^
+        (uint64_t)corner->normal * UINT64_C(0xC2B2AE3D27D4EB4F);
+    return (size_t)(hash >> 32);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Allocate an empty welding table. Each source position gets its
+ * own run of slots, in position order, so the corners of neighbouring
+ * triangles probe neighbouring memory. Corners sharing a position but not
+ * its attributes, like those along a UV seam, spill into the following
+ * slots.
+ *
+ * PARAMETERS
+ *
+ * @param table The storage for the table.
+ * @param capacity The capacity of the table. This is a power of two.
+ * @param positions The amount of positions in the source mesh.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For errors unhandled by this function, see @ref LetoMalloc.
+ *
+ */
+static void CreateWeldTable_(weld_table_t* table, size_t capacity,
+                             size_t positions)
+{
+    table->entries =
+        LetoMalloc(memory_meshes, capacity * sizeof(weld_entry_t));
+    (void)memset(table->entries, 0xFF, capacity * sizeof(weld_entry_t));
+    table->capacity = capacity;
+    table->spacing = 1;
+    while (table->spacing * 2 * positions <= capacity)
+        table->spacing <<= 1;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Find the entry of a welding table holding a corner, or the empty
+ * entry it would be inserted into. The table is linearly probed.
+ *
+ * PARAMETERS
+ *
+ * @param table The table to search.
+ * @param corner The corner to look for.
+ *
+ * RETURN VALUE
+ *
+ * @return The matching or empty entry.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static weld_entry_t* FindWeldEntry_(const weld_table_t* table,
+                                    const face_corner_t* corner)
+{
+    const size_t mask = table->capacity - 1;
+    size_t slot = ((size_t)corner->vertex * table->spacing +
+                   (HashAttributes_(corner) & (table->spacing - 1))) &
+                  mask;
+
+    weld_entry_t* entries = table->entries;
+    while (entries[slot].vertex != WELD_EMPTY &&
+           (entries[slot].key.vertex != corner->vertex ||
+            entries[slot].key.texture != corner->texture ||
+            entries[slot].key.normal != corner->normal))
+        slot = (slot + 1) & mask;
+    return &entries[slot];
+}
+
+/**
+ * @brief Double the capacity of a welding table, reinserting every entry.
+ */
+static void GrowWeldTable_(weld_table_t* table, size_t positions)
+{
+    weld_table_t grown;
+    CreateWeldTable_(&grown, table->capacity * 2, positions);
+    for (size_t i = 0; i < table->capacity; i++)
+        if (table->entries[i].vertex != WELD_EMPTY)
+            *FindWeldEntry_(&grown, &table->entries[i].key) =
+                table->entries[i];
+
+    LetoFree(table->entries);
+    *table = grown;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Build the interleaved vertex for a face corner.
+ *
+ * PARAMETERS
+ *
+ * @param source The source mesh.
+ * @param corner The corner.
+ * @param vertex The storage for the vertex.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void BuildVertex_(const mesh_source_t* source,
+                         const face_corner_t* corner,
+                         mesh_vertex_t* vertex)
+{
+    *vertex = (mesh_vertex_t){0};
+    glm_vec3_copy(source->vertices[corner->vertex], vertex->position);
+    if (corner->normal != MESH_NO_INDEX)
+        glm_vec3_copy(source->normals[corner->normal], vertex->normal);
+    if (corner->texture != MESH_NO_INDEX)
+        glm_vec2_copy(source->texture[corner->texture], vertex->texture);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Weld a source mesh into unique interleaved vertices and a
+ * triangle list indexing them. Corners are deduplicated through an open
+ * addressing hash table keyed on their (position, texture, normal)
+ * triplet, see @ref CreateWeldTable_. The index buffer is narrowed to 16
+ * bits when every vertex fits.
+ *
+ * PARAMETERS
+ *
+ * @param source The source mesh.
+ *
+ * RETURN VALUE
+ *
+ * @return The welded mesh.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For errors unhandled by this function, see @ref LetoMalloc.
+ *
+ */
+static mesh_t* Weld_(const mesh_source_t* source)
+{
+    mesh_t* mesh = LetoCalloc(memory_meshes, 1, sizeof(mesh_t));
+    mesh->index_size = sizeof(uint16_t);
+    mesh->index_count = source->face_count * 3;
+    if (mesh->index_count == 0) return mesh;
+
+    // Most corners share their position with a handful of others, so
+    // start the table at twice the largest attribute count, and grow it
+    // if the mesh has more seams than that.
+    size_t largest = source->vertex_count;
+    if (source->texture_count > largest) largest = source->texture_count;
+    if (source->normal_count > largest) largest = source->normal_count;
+    size_t capacity = WELD_MIN_CAPACITY;
+    while (capacity < largest * 2) capacity <<= 1;
+    weld_table_t table;
+    CreateWeldTable_(&table, capacity, source->vertex_count);
+
+    mesh->vertices = LetoMalloc(
+        memory_meshes, mesh->index_count * sizeof(mesh_vertex_t));
+    uint32_t* indices =
+        LetoMalloc(memory_meshes, mesh->index_count * sizeof(uint32_t));
+
+    const face_corner_t* corners = source->faces[0].corners;
+    for (size_t i = 0; i < mesh->index_count; i++)
+    {
+        const face_corner_t* corner = &corners[i];
+        weld_entry_t* entry = FindWeldEntry_(&table, corner);
+        if (entry->vertex != WELD_EMPTY)
+        {
+            indices[i] = entry->vertex;
+            continue;
+        }
+
+        *entry = (weld_entry_t){*corner, (uint32_t)mesh->vertex_count};
+        indices[i] = entry->vertex;
+        BuildVertex_(source, corner,
+                     &mesh->vertices[mesh->vertex_count++]);
+
+        // Keep the table under three quarters full.
+        if (mesh->vertex_count * 4 > table.capacity * 3)
+            GrowWeldTable_(&table, source->vertex_count);
+    }
+    LetoFree(table.entries);
+
+    mesh->vertices = LetoRealloc(
+        mesh->vertices, mesh->vertex_count * sizeof(mesh_vertex_t));
+    if (mesh->vertex_count > UINT16_MAX + 1)
+    {
+        mesh->index_size = sizeof(uint32_t);
+        mesh->indices = indices;
+        return mesh;
+    }
+
+    uint16_t* narrow =
+        LetoMalloc(memory_meshes, mesh->index_count * sizeof(uint16_t));
+    for (size_t i = 0; i < mesh->index_count; i++)
+        narrow[i] = (uint16_t)indices[i];
+    LetoFree(indices);
+    mesh->indices = narrow;
+    return mesh;
+}
 
 mesh_t* LetoLoadMesh(const char* name)
 {
-    char* obj_file_contents =
-        (char*)LetoReadFilePV(true, ASSET_DIR "/Meshes/%s", name);
-    char** mesh_data = LetoStringSplit(obj_file_contents, '\n');
-    // LetoStringFree(&obj_file_contents);
+    if (name == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+
+    char* path = LetoStringCreate(MAX_PATH_LENGTH,
+                                  ASSET_DIR "/meshes/%s", name);
+    file_t* file = LetoOpenFile(r, path);
+    LetoStringFree(&path);
+    if (file == NULL) return NULL;
+
+    LetoReadFile(file);
+    mesh_t* mesh =
+        LetoParseMesh(name, (const char*)file->contents, file->size, 0);
+    LetoCloseFile(file);
+
+    if (mesh == NULL) return NULL;
+    LetoProcessMesh(mesh, &mesh->optimization);
 
-    for (size_t i = 0; mesh_data[i] != NULL; i++)
-        printf("%s\n\n", mesh_data[i]);
+    if (import_count == import_capacity)
+    {
+        import_capacity = import_capacity == 0 ? 16 : import_capacity * 2;
+        const size_t size = import_capacity * sizeof(mesh_import_t);
+        imports = imports == NULL ? LetoMalloc(memory_meshes, size)
+                                  : LetoRealloc(imports, size);
+    }
+    imports[import_count++] = (mesh_import_t){
+        LetoStringIntern(name, strlen(name)), mesh->optimization};
 
-    return NULL;
+    // The container is written here, at import, so every later load of
+    // the model maps it instead of parsing the file again.
+    path = LetoStringCreate(MAX_PATH_LENGTH, MODEL_PATH, name);
+#if defined(__LETO__DEBUG__)
+    if (LetoExportModel(mesh, path)) (void)LetoVerifyModel(mesh, path);
+#else
+    (void)LetoExportModel(mesh, path);
+#endif
+    LetoStringFree(&path);
+    return mesh;
 }
+
+void LetoReportMeshImports(void)
+{
+    if (import_count == 0) return;
+
+    printf("\n%-24s %12s %12s %12s %12s\n", "mesh", "acmr before",
+           "acmr after", "atvr before", "atvr after");
+    for (size_t i = 0; i < import_count; i++)
+    {
+        const mesh_optimization_t* optimization = &imports[i].optimization;
+        printf("%-24s %12.3f %12.3f %12.3f %12.3f\n", imports[i].name,
+               (double)optimization->before.acmr,
+               (double)optimization->after.acmr,
+               (double)optimization->before.atvr,
+               (double)optimization->after.atvr);
+    }
+
+    LetoFree(imports);
+    imports = NULL;
+    import_count = 0;
+    import_capacity = 0;
+}
+
+mesh_t* LetoParseMesh(const char* name, const char* buffer, size_t size,
+                      size_t thread_count)
+{
+    if (name == NULL || buffer == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+
+    // Everything up to the last newline is parsed in place. A final line
+    // without one is copied out and given one, so the line parser never
+    // needs to check for the end of the buffer.
+    const char* tail = buffer + size;
+    while (tail > buffer && tail[-1] != '\n') tail--;
+    const size_t tail_size = (size_t)(buffer + size - tail);
+
+    size_t count = thread_count == 0 ? LetoGetHardwareThreads()
+                                     : thread_count;
+    if (count > MESH_MAX_THREADS) count = MESH_MAX_THREADS;
+    if (count > (size_t)(tail - buffer) / MESH_MIN_CHUNK_SIZE)
+        count = (size_t)(tail - buffer) / MESH_MIN_CHUNK_SIZE;
+    if (count == 0) count = 1;
+
+    mesh_parser_t* parsers =
+        LetoCalloc(memory_meshes, count, sizeof(mesh_parser_t));
+    SplitChunks_(parsers, count, buffer, tail);
+    bool parsed = RunChunks_(parsers, count, ParseChunk_);
+
+    // The copied line has to outlive grouping, as names point into it.
+    char* line = NULL;
+    if (parsed && tail_size != 0)
+    {
+        line = LetoMalloc(memory_meshes, tail_size + 1);
+        (void)memcpy(line, tail, tail_size);
+        line[tail_size] = '\n';
+        parsed =
+            ParseLines_(line, line + tail_size + 1, &parsers[count - 1]);
+    }
+
+    mesh_source_t source = {0};
+    mesh_submesh_t* submeshes = NULL;
+    size_t submesh_count = 0;
+    if (parsed) parsed = Stitch_(parsers, count, &source);
+    if (parsed)
+        submeshes = Group_(parsers, count, &source, &submesh_count);
+    for (size_t i = 0; i < count; i++)
+    {
+        FreeSource_(&parsers[i].mesh);
+        LetoFree(parsers[i].fixups);
+        LetoFree(parsers[i].runs);
+        LetoFree(parsers[i].libraries);
+    }
+    LetoFree(parsers);
+    LetoFree(line);
+
+    if (!parsed)
+    {
+        FreeSource_(&source);
+        LetoReport(mesh_malformed);
+        return NULL;
+    }
+
+    mesh_t* mesh = Weld_(&source);
+    FreeSource_(&source);
+    mesh->submeshes = submeshes;
+    mesh->submesh_count = submesh_count;
+    mesh->name = LetoStringCreate(MAX_PATH_LENGTH, "%s", name);
+    return mesh;
+}
+
+void LetoProcessMesh(mesh_t* mesh, mesh_optimization_t* report)
+{
+    if (mesh == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    LetoGenerateTangents(mesh);
+    LetoOptimizeMesh(mesh, report);
+    LetoGenerateLODs(mesh, MESH_LOD_LEVELS, MESH_LOD_RATIO);
+    LetoBuildMeshlets(mesh);
+    LetoComputeBounds(mesh);
+}
+
+size_t LetoGetDetailIndexCount(const mesh_t* mesh)
+{
+    if (mesh == NULL)
+    {
+        LetoReport(null_param);
+        return 0;
+    }
+    if (mesh->submesh_count == 0) return mesh->index_count;
+
+    size_t count = 0;
+    for (size_t i = 0; i < mesh->submesh_count; i++)
+        count += mesh->submeshes[i].index_count;
+    return count;
+}
+
 void LetoUnloadMesh(mesh_t* mesh)
 {
-    printf("unloaded, %s\n", mesh->name);
-    return;
+    if (mesh == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    LetoFree(mesh->vertices);
+    LetoFree(mesh->tangents);
+    LetoFree(mesh->indices);
+    for (size_t i = 0; i < mesh->submesh_count; i++)
+        LetoReleaseMaterial(mesh->submeshes[i].material);
+    LetoFree(mesh->submeshes);
+    LetoFree(mesh->lods);
+    LetoFree(mesh->meshlets);
+    LetoFree(mesh->meshlet_vertices);
+    LetoFree(mesh->meshlet_triangles);
+    LetoFree((void*)mesh->name);
+    LetoFree(mesh);
 }
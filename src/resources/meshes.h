@@ -19,51 +19,391 @@
 #ifndef __LETO__MESHES__
 #define __LETO__MESHES__
 
+// Standard macro definitions, like size_t.
+#include <stddef.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+// The material library.
+#include <resources/materials.h>
+// CGLM's vector types.
+#include <vec2.h>
 #include <vec3.h>
+#include <vec4.h>
 
 typedef enum
 {
     wavefront
 } mode_format_t;
 
-typedef enum
+/**
+ * @brief The volumes bounding a mesh or a submesh, for culling.
+ */
+typedef struct
 {
-    color_no_ambient,
-    color_and_ambient,
-    highlight,
-    reflection_and_raytrace,
-    glass_and_raytrace,
-    fresnel_and_raytrace,
-    refraction_and_fresnel_and_raytrace,
-    refraction_and_raytrace,
-    reflection_no_raytrace,
-    glass_no_raytrace,
-    shadows_on_invisible
-} illumination_t;
+    /**
+     * @brief The corners of the axis-aligned box bounding every vertex.
+     */
+    vec3 minimum;
+    vec3 maximum;
+    /**
+     * @brief The sphere bounding every vertex, centered on the box, with
+     * its radius in W.
+     */
+    vec4 sphere;
+} mesh_bounds_t;
 
+/**
+ * @brief A run of a mesh's triangles drawn with a single material.
+ */
 typedef struct
 {
-    vec4 specular; // first three are spec, last is spec exponent
-    vec3 diffuse;
-    vec3 ambient;
-    vec3 transmission_filter; // only on transparent obj
-    illumination_t illumination;
-    float transparency;
-    float refraction;
-    const char* name;
-} material_t;
+    /**
+     * @brief The first index of the run within @ref mesh_t::indices.
+     */
+    size_t first_index;
+    size_t index_count;
+    /**
+     * @brief The library index of the run's material, or @ref
+     * MATERIAL_NONE.
+     */
+    uint32_t material;
+    /**
+     * @brief The bounds of the vertices the run's triangles use.
+     */
+    mesh_bounds_t bounds;
+} mesh_submesh_t;
 
+/**
+ * @brief One submesh's run of triangles within a level of a mesh's LOD
+ * chain.
+ */
 typedef struct
 {
-    vec3* vertices;
-    vec3* normals;
-    vec3* texture;
-    vec3* faces;
-    material_t* materials;
+    /**
+     * @brief The first index of the run within @ref mesh_t::indices.
+     */
+    size_t first_index;
+    size_t index_count;
+    /**
+     * @brief The geometric error of the level, in object-space units: how
+     * far its surface strays from the full-detail mesh. This is the same
+     * for every run of a level.
+     */
+    float error;
+} mesh_lod_t;
+
+/**
+ * @brief A small cluster of a submesh's triangles, which can be culled as
+ * a whole. Every field is 32 bits or less and the vectors come first, so
+ * the array can be uploaded as-is for a compute shader to cull.
+ */
+typedef struct
+{
+    /**
+     * @brief The sphere bounding every vertex of the meshlet, with its
+     * radius in W.
+     */
+    vec4 sphere;
+    /**
+     * @brief The cone bounding every triangle normal of the meshlet: its
+     * unit axis, and in W the sine of its half-angle. This is 1 when the
+     * normals spread too far for the meshlet to ever be backfacing.
+     */
+    vec4 cone;
+    /**
+     * @brief The first of the meshlet's vertices within @ref
+     * mesh_t::meshlet_vertices.
+     */
+    uint32_t vertex_offset;
+    /**
+     * @brief The first of the meshlet's triangles within @ref
+     * mesh_t::meshlet_triangles, counted in triangles.
+     */
+    uint32_t triangle_offset;
+    /**
+     * @brief The index of the submesh the meshlet's triangles come from.
+     */
+    uint32_t submesh;
+    uint8_t vertex_count;
+    uint8_t triangle_count;
+    uint16_t reserved;
+} mesh_meshlet_t;
+
+/**
+ * @brief How efficiently a mesh uses the post-transform vertex cache.
+ */
+typedef struct
+{
+    /**
+     * @brief The average cache miss ratio: vertices shaded per triangle.
+     * This ranges from 3 (no reuse at all) down to about 0.5.
+     */
+    float acmr;
+    /**
+     * @brief The average transformed vertex ratio: vertices shaded per
+     * vertex in the mesh. This is 1 for a perfect order.
+     */
+    float atvr;
+} mesh_cache_stats_t;
+
+/**
+ * @brief The cache efficiency of a mesh before and after optimization.
+ */
+typedef struct
+{
+    mesh_cache_stats_t before;
+    mesh_cache_stats_t after;
+} mesh_optimization_t;
+
+/**
+ * @brief A single vertex of an imported mesh, with every attribute
+ * interleaved so it can be uploaded and fetched as one stream.
+ */
+typedef struct
+{
+    vec3 position;
+    vec3 normal;
+    /**
+     * @brief The texture coordinate of the vertex. Only U and V are kept;
+     * the rarely-used W component of OBJ files is dropped.
+     */
+    vec2 texture;
+} mesh_vertex_t;
+
+typedef struct
+{
+    /**
+     * @brief The unique vertices of the mesh. Every distinct combination
+     * of position, texture and normal indices in the source file becomes
+     * exactly one of these.
+     */
+    mesh_vertex_t* vertices;
+    /**
+     * @brief The tangent of each vertex, with the handedness of its
+     * bitangent in W, or NULL if the mesh has none. OBJ files carry no
+     * tangents, so these only exist once generated by @ref
+     * LetoGenerateTangents, which needs texture coordinates to do so.
+     */
+    vec4* tangents;
+    /**
+     * @brief The triangle list indexing @ref mesh_t::vertices. Each index
+     * is @ref mesh_t::index_size bytes wide.
+     */
+    void* indices;
+    /**
+     * @brief The runs of triangles sharing a material, sorted by material
+     * so that draws can be batched by material state. Each submesh holds
+     * a reference to its material.
+     */
+    mesh_submesh_t* submeshes;
+    /**
+     * @brief The amount of vertices in the mesh.
+     */
+    size_t vertex_count;
+    /**
+     * @brief The LOD chain of the mesh, or NULL if it has none. The
+     * chain holds one run per submesh for each level, so submesh S of
+     * level L is at L * @ref mesh_t::submesh_count + S. Level 0 is the
+     * full-detail mesh, the same as @ref mesh_t::submeshes, and the
+     * lower levels share the vertices but have their own indices.
+     */
+    mesh_lod_t* lods;
+    /**
+     * @brief The meshlets of the full-detail mesh, or NULL if it hasn't
+     * been split into any.
+     */
+    mesh_meshlet_t* meshlets;
+    /**
+     * @brief The vertices of every meshlet, as indices into @ref
+     * mesh_t::vertices.
+     */
+    uint32_t* meshlet_vertices;
+    /**
+     * @brief The triangles of every meshlet, three bytes each, indexing
+     * the meshlet's own vertices.
+     */
+    uint8_t* meshlet_triangles;
+    /**
+     * @brief The amount of indices in the mesh, three per triangle, over
+     * every level of the LOD chain. See @ref LetoGetDetailIndexCount for
+     * the full-detail level's alone.
+     */
+    size_t index_count;
+    /**
+     * @brief The width of each index in bytes: 2 if every vertex fits in
+     * 16 bits, otherwise 4.
+     */
+    uint32_t index_size;
+    size_t submesh_count;
+    /**
+     * @brief The amount of levels in the LOD chain, counting full detail.
+     */
+    size_t lod_count;
+    size_t meshlet_count;
+    /**
+     * @brief The bounds of every vertex of the mesh.
+     */
+    mesh_bounds_t bounds;
+    /**
+     * @brief The vertex cache efficiency of the mesh before and after
+     * optimization, if it was imported by @ref LetoLoadMesh. Meshes only
+     * parsed have none, and this is zeroed.
+     */
+    mesh_optimization_t optimization;
     const char* name;
 } mesh_t;
 
+/**
+ * DESCRIPTION
+ *
+ * @brief Load a Wavefront OBJ mesh from the asset directory's meshes
+ * folder. See @ref LetoParseMesh for what is read, and @ref
+ * LetoProcessMesh for what's done with it afterward. The processed mesh
+ * is then exported to its container, see @ref MODEL_PATH, which @ref
+ * LetoLoadModel loads from then on; debug builds check that it reads
+ * back the same with @ref LetoVerifyModel. The mesh's vertex cache
+ * efficiency is kept in @ref mesh_t::optimization, and recorded for @ref
+ * LetoReportMeshImports.
+ *
+ * PARAMETERS
+ *
+ * @param name The file name of the mesh, like "cube.obj".
+ *
+ * RETURN VALUE
+ *
+ * @return The loaded mesh, to be freed with @ref LetoUnloadMesh, or NULL
+ * if the file couldn't be read or parsed.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ * @note For warnings unhandled by this function, see @ref LetoOpenFile,
+ * @ref LetoParseMesh and @ref LetoExportModel. A mesh whose container
+ * couldn't be written is still returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
 mesh_t* LetoLoadMesh(const char* name);
+
+/**
+ * @brief Print the vertex cache efficiency, before and after
+ * optimization, of every mesh imported by @ref LetoLoadMesh since the
+ * last report, then forget them.
+ */
+void LetoReportMeshImports(void);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Parse a Wavefront OBJ file held in memory. "v", "vt", "vn" and
+ * "f" lines are read, everything else is skipped. Numbers are parsed in
+ * place, nothing is allocated per line, and the output arrays grow
+ * geometrically. Large files are split at line boundaries into chunks
+ * that are parsed concurrently, then stitched back together in order;
+ * relative indices that reach into an earlier chunk are resolved then.
+ * Every unique face corner is then welded into one interleaved vertex,
+ * and the faces become a 16- or 32-bit index buffer. Nothing else is
+ * done to the mesh; see @ref LetoProcessMesh.
+ *
+ * PARAMETERS
+ *
+ * @param name The name to give the mesh.
+ * @param buffer The contents of the file. This does not need to be
+ * NUL-terminated.
+ * @param size The size of the contents in bytes.
+ * @param thread_count The most threads to parse with, or 0 to use one per
+ * hardware thread. Small files are always parsed on one thread.
+ *
+ * RETURN VALUE
+ *
+ * @return The parsed mesh, to be freed with @ref LetoUnloadMesh, or NULL
+ * if the contents are malformed.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If the name or buffer is NULL, this warning is
+ * thrown and NULL is returned.
+ * @warning mesh_malformed -- If a number can't be read or a face indexes
+ * past the attributes of the mesh, this warning is thrown and NULL is
+ * returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For errors unhandled by this function, see @ref LetoCreateThread.
+ *
+ */
+mesh_t* LetoParseMesh(const char* name, const char* buffer, size_t size,
+                      size_t thread_count);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Run a freshly parsed mesh through the rest of the import
+ * pipeline. @ref LetoGenerateTangents gives the vertices tangents, and
+ * the mesh is run through @ref LetoOptimizeMesh. Lastly, @ref
+ * LetoGenerateLODs builds the mesh's LOD chain, @ref LetoBuildMeshlets
+ * splits it into meshlets, and @ref LetoComputeBounds bounds it and its
+ * submeshes.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh, as @ref LetoParseMesh returned it.
+ * @param report The storage for the mesh's vertex cache efficiency
+ * before and after optimization, or NULL; see @ref LetoOptimizeMesh.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the mesh is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoProcessMesh(mesh_t* mesh, mesh_optimization_t* report);
+
+/**
+ * @brief Get the amount of indices in a mesh's full-detail level, level
+ * 0 of its LOD chain: those of every submesh. @ref mesh_t::index_count
+ * also counts the lower levels.
+ */
+size_t LetoGetDetailIndexCount(const mesh_t* mesh);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Free a mesh and everything it owns.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh to free.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the mesh is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
 void LetoUnloadMesh(mesh_t* mesh);
 
 #endif // __LETO__MESHES__
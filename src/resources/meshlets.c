@@ -0,0 +1,658 @@
+/**
+ * @file Meshlets.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Meshlets.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "meshlets.h"         // Public interface parent
+#include <io/reporter.h>      // Error / warning reporter
+#include <math.h>             // Sqrtf
+#include <string.h>           // Memset
+#include <utilities/memory.h> // Tracked allocations
+
+/**
+ * @brief The slot of a vertex that isn't in the meshlet being built.
+ */
+#define NO_SLOT 0xFF
+
+/**
+ * @brief The most triangles a leaf of the centroid tree holds.
+ */
+#define TREE_LEAF_SIZE 8
+
+/**
+ * @brief The axis of a leaf of the centroid tree.
+ */
+#define TREE_LEAF 3
+
+/**
+ * @brief A node of the k-d tree over a submesh's triangle centroids,
+ * which finds the closest unused triangle when a meshlet runs out of
+ * neighbours. An inner node's left child directly follows it.
+ */
+typedef struct
+{
+    /**
+     * @brief The axis the node splits on, or @ref TREE_LEAF.
+     */
+    uint32_t axis;
+    float split;
+    /**
+     * @brief An inner node's right child, or a leaf's first triangle
+     * within @ref builder_t::tree_items.
+     */
+    uint32_t first;
+    /**
+     * @brief The amount of a leaf's triangles still unused. Used ones are
+     * swapped past the end as they're found.
+     */
+    uint32_t count;
+} tree_node_t;
+
+/**
+ * @brief The state of a mesh being split into meshlets. Triangles are
+ * numbered by their position within the full-detail index range.
+ */
+typedef struct
+{
+    const mesh_t* mesh;
+    /**
+     * @brief The full-detail indices, widened to 32 bits.
+     */
+    uint32_t* indices;
+    /**
+     * @brief The unit normal of every triangle, or zero for degenerate
+     * ones.
+     */
+    vec3* normals;
+    vec3* centroids;
+    /**
+     * @brief The centroid tree of the submesh being split, and the
+     * triangles its leaves hold.
+     */
+    tree_node_t* tree;
+    uint32_t* tree_items;
+    size_t tree_count;
+    /**
+     * @brief The triangles around each vertex, as offsets into @ref
+     * builder_t::adjacency.
+     */
+    uint32_t* offsets;
+    uint32_t* adjacency;
+    uint8_t* emitted;
+    /**
+     * @brief The slot of every vertex within the meshlet being built, or
+     * @ref NO_SLOT.
+     */
+    uint8_t* slots;
+    /**
+     * @brief The meshlet being built.
+     */
+    uint32_t vertices[MESH_MESHLET_VERTICES];
+    uint32_t triangles[MESH_MESHLET_TRIANGLES];
+    size_t vertex_count;
+    size_t triangle_count;
+    vec3 normal;
+    /**
+     * @brief The finished meshlets, sized for the worst case of one
+     * triangle each, and shrunk once done.
+     */
+    mesh_meshlet_t* meshlets;
+    uint32_t* meshlet_vertices;
+    uint8_t* meshlet_triangles;
+    size_t meshlet_count;
+    size_t meshlet_vertex_count;
+    size_t meshlet_triangle_count;
+} builder_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Find every triangle's normal and centroid, and build the
+ * vertex-to-triangle adjacency of the full-detail triangles as a
+ * counting sort.
+ *
+ * PARAMETERS
+ *
+ * @param builder The builder, whose indices are set.
+ * @param triangle_count The amount of full-detail triangles.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void BuildAdjacency_(builder_t* builder, size_t triangle_count)
+{
+    const mesh_t* mesh = builder->mesh;
+    builder->offsets = LetoCalloc(memory_meshes, mesh->vertex_count + 1,
+                                  sizeof(uint32_t));
+    builder->adjacency =
+        LetoMalloc(memory_meshes, triangle_count * 3 * sizeof(uint32_t));
+    builder->normals =
+        LetoMalloc(memory_meshes, triangle_count * sizeof(vec3));
+    builder->centroids =
+        LetoMalloc(memory_meshes, triangle_count * sizeof(vec3));
+
+    for (size_t i = 0; i < triangle_count * 3; i++)
+        builder->offsets[builder->indices[i] + 1]++;
+    for (size_t i = 0; i < mesh->vertex_count; i++)
+        builder->offsets[i + 1] += builder->offsets[i];
+
+    // Filling moves every offset to the start of the next vertex, so they
+    // get shifted back afterwards.
+    for (uint32_t i = 0; i < triangle_count; i++)
+    {
+        const uint32_t* triangle = &builder->indices[i * 3];
+        for (size_t j = 0; j < 3; j++)
+            builder->adjacency[builder->offsets[triangle[j]]++] = i;
+
+        vec3 ab, ac;
+        glm_vec3_sub((float*)mesh->vertices[triangle[1]].position,
+                     (float*)mesh->vertices[triangle[0]].position, ab);
+        glm_vec3_sub((float*)mesh->vertices[triangle[2]].position,
+                     (float*)mesh->vertices[triangle[0]].position, ac);
+        glm_vec3_cross(ab, ac, builder->normals[i]);
+        glm_vec3_normalize(builder->normals[i]);
+
+        float* centroid = builder->centroids[i];
+        glm_vec3_zero(centroid);
+        for (size_t j = 0; j < 3; j++)
+            glm_vec3_add(centroid,
+                         (float*)mesh->vertices[triangle[j]].position,
+                         centroid);
+        glm_vec3_scale(centroid, 1.0f / 3.0f, centroid);
+    }
+    for (size_t i = mesh->vertex_count; i > 0; i--)
+        builder->offsets[i] = builder->offsets[i - 1];
+    builder->offsets[0] = 0;
+}
+
+/**
+ * @brief Add a triangle to the meshlet being built.
+ */
+static void AddTriangle_(builder_t* builder, uint32_t triangle)
+{
+    builder->emitted[triangle] = 1;
+    for (size_t i = 0; i < 3; i++)
+    {
+        const uint32_t vertex = builder->indices[triangle * 3 + i];
+        if (builder->slots[vertex] != NO_SLOT) continue;
+        builder->slots[vertex] = (uint8_t)builder->vertex_count;
+        builder->vertices[builder->vertex_count++] = vertex;
+    }
+    builder->triangles[builder->triangle_count++] = triangle;
+    glm_vec3_add(builder->normal, builder->normals[triangle],
+                 builder->normal);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Build a node of the centroid tree over some of a submesh's
+ * triangles, and everything below it. Nodes split at the mean centroid
+ * along their widest axis, until a leaf's worth is left or the
+ * centroids can't be split any further.
+ *
+ * PARAMETERS
+ *
+ * @param builder The builder, with room in its tree for the node.
+ * @param first The node's first triangle within @ref
+ * builder_t::tree_items.
+ * @param count The amount of triangles under the node.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void BuildTree_(builder_t* builder, uint32_t first, uint32_t count)
+{
+    tree_node_t* node = &builder->tree[builder->tree_count++];
+    uint32_t* items = &builder->tree_items[first];
+    *node = (tree_node_t){.axis = TREE_LEAF, .first = first,
+                          .count = count};
+    if (count <= TREE_LEAF_SIZE) return;
+
+    vec3 minimum, maximum, mean = GLM_VEC3_ZERO_INIT;
+    glm_vec3_copy(builder->centroids[items[0]], minimum);
+    glm_vec3_copy(minimum, maximum);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        float* centroid = builder->centroids[items[i]];
+        glm_vec3_minv(minimum, centroid, minimum);
+        glm_vec3_maxv(maximum, centroid, maximum);
+        glm_vec3_add(mean, centroid, mean);
+    }
+
+    uint32_t axis = 0;
+    for (uint32_t j = 1; j < 3; j++)
+        if (maximum[j] - minimum[j] > maximum[axis] - minimum[axis])
+            axis = j;
+    const float split = mean[axis] / (float)count;
+
+    uint32_t left = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (builder->centroids[items[i]][axis] >= split) continue;
+        const uint32_t swap = items[left];
+        items[left++] = items[i], items[i] = swap;
+    }
+    // Every centroid on one side means they're all the same point.
+    if (left == 0 || left == count) return;
+
+    node->axis = axis, node->split = split;
+    BuildTree_(builder, first, left);
+    // The right child goes wherever the left subtree ends.
+    node->first = (uint32_t)builder->tree_count;
+    BuildTree_(builder, first + left, count - left);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Find the unused triangle under a node of the centroid tree
+ * closest to a point. Used triangles met along the way are dropped from
+ * their leaves.
+ *
+ * PARAMETERS
+ *
+ * @param builder The builder.
+ * @param index The index of the node.
+ * @param point The point.
+ * @param best The storage for the closest triangle found so far.
+ * @param best_distance The squared distance to it.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void FindClosest_(builder_t* builder, uint32_t index,
+                         const vec3 point, uint32_t* best,
+                         float* best_distance)
+{
+    tree_node_t* node = &builder->tree[index];
+    if (node->axis != TREE_LEAF)
+    {
+        // The near side first, so the far side can usually be skipped.
+        const float offset = point[node->axis] - node->split;
+        const uint32_t near = offset < 0.0f ? index + 1 : node->first,
+                       far = offset < 0.0f ? node->first : index + 1;
+        FindClosest_(builder, near, point, best, best_distance);
+        if (offset * offset < *best_distance)
+            FindClosest_(builder, far, point, best, best_distance);
+        return;
+    }
+
+    uint32_t* items = &builder->tree_items[node->first];
+    for (uint32_t i = 0; i < node->count;)
+    {
+        const uint32_t triangle = items[i];
+        if (builder->emitted[triangle])
+        {
+            items[i] = items[--node->count], items[node->count] = triangle;
+            continue;
+        }
+        i++;
+
+        const float distance = glm_vec3_distance2(
+            (float*)point, builder->centroids[triangle]);
+        if (distance < *best_distance)
+            *best = triangle, *best_distance = distance;
+    }
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Find the unused triangle of the submesh closest to the meshlet
+ * being built, for when it has no unused neighbours left, like at a seam
+ * or the edge of a disconnected piece. None of the candidates share a
+ * vertex with the meshlet, so each adds three.
+ *
+ * PARAMETERS
+ *
+ * @param builder The builder, with the submesh's centroid tree built.
+ *
+ * RETURN VALUE
+ *
+ * @return The triangle to add, or UINT32_MAX if the meshlet hasn't room
+ * for three more vertices or the submesh has no unused triangles left.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static uint32_t FindNearest_(builder_t* builder)
+{
+    if (builder->vertex_count + 3 > MESH_MESHLET_VERTICES)
+        return UINT32_MAX;
+
+    vec3 center = GLM_VEC3_ZERO_INIT;
+    for (size_t i = 0; i < builder->vertex_count; i++)
+        glm_vec3_add(
+            center,
+            (float*)builder->mesh->vertices[builder->vertices[i]].position,
+            center);
+    glm_vec3_scale(center, 1.0f / (float)builder->vertex_count, center);
+
+    uint32_t best = UINT32_MAX;
+    float best_distance = INFINITY;
+    FindClosest_(builder, 0, center, &best, &best_distance);
+    return best;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Find the best triangle to add to the meshlet being built: the
+ * unused one around its vertices that adds the fewest new vertices, with
+ * ties going to the one facing most like the meshlet.
+ *
+ * PARAMETERS
+ *
+ * @param builder The builder.
+ * @param first The first triangle of the submesh being split.
+ * @param end The triangle past the last of the submesh.
+ *
+ * RETURN VALUE
+ *
+ * @return The triangle to add, or UINT32_MAX if none fit.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static uint32_t FindTriangle_(const builder_t* builder, size_t first,
+                              size_t end)
+{
+    vec3 facing;
+    glm_vec3_normalize_to((float*)builder->normal, facing);
+
+    uint32_t best = UINT32_MAX;
+    float best_score = INFINITY;
+    for (size_t i = 0; i < builder->vertex_count; i++)
+    {
+        const uint32_t vertex = builder->vertices[i];
+        for (size_t j = builder->offsets[vertex];
+             j < builder->offsets[vertex + 1]; j++)
+        {
+            const uint32_t triangle = builder->adjacency[j];
+            if (builder->emitted[triangle] || triangle < first ||
+                triangle >= end)
+                continue;
+
+            size_t added = 0;
+            for (size_t k = 0; k < 3; k++)
+                if (builder->slots[builder->indices[triangle * 3 + k]] ==
+                    NO_SLOT)
+                    added++;
+            if (builder->vertex_count + added > MESH_MESHLET_VERTICES)
+                continue;
+
+            const float score =
+                (float)added +
+                0.5f * (1.0f - glm_vec3_dot(facing,
+                                            builder->normals[triangle]));
+            if (score < best_score) best = triangle, best_score = score;
+        }
+    }
+    return best;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Finish the meshlet being built: copy out its vertices and
+ * triangles, and bound it with a sphere and a normal cone.
+ *
+ * PARAMETERS
+ *
+ * @param builder The builder.
+ * @param submesh The submesh the meshlet belongs to.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void FinishMeshlet_(builder_t* builder, uint32_t submesh)
+{
+    const mesh_t* mesh = builder->mesh;
+    mesh_meshlet_t* meshlet = &builder->meshlets[builder->meshlet_count++];
+    *meshlet = (mesh_meshlet_t){
+        .vertex_offset = (uint32_t)builder->meshlet_vertex_count,
+        .triangle_offset = (uint32_t)builder->meshlet_triangle_count,
+        .submesh = submesh,
+        .vertex_count = (uint8_t)builder->vertex_count,
+        .triangle_count = (uint8_t)builder->triangle_count};
+
+    vec3 minimum, maximum;
+    glm_vec3_copy((float*)mesh->vertices[builder->vertices[0]].position,
+                  minimum);
+    glm_vec3_copy(minimum, maximum);
+    for (size_t i = 0; i < builder->vertex_count; i++)
+    {
+        float* position =
+            (float*)mesh->vertices[builder->vertices[i]].position;
+        glm_vec3_minv(minimum, position, minimum);
+        glm_vec3_maxv(maximum, position, maximum);
+        builder->meshlet_vertices[builder->meshlet_vertex_count++] =
+            builder->vertices[i];
+    }
+
+    glm_vec3_center(minimum, maximum, meshlet->sphere);
+    for (size_t i = 0; i < builder->vertex_count; i++)
+    {
+        const float distance = glm_vec3_distance(
+            meshlet->sphere,
+            (float*)mesh->vertices[builder->vertices[i]].position);
+        if (distance > meshlet->sphere[3]) meshlet->sphere[3] = distance;
+    }
+
+    // The cone's axis is the average normal, and its spread is set by the
+    // normal furthest from it. Past a right angle the meshlet can't ever
+    // be entirely backfacing.
+    glm_vec3_normalize_to(builder->normal, meshlet->cone);
+    float spread = 1.0f;
+    for (size_t i = 0; i < builder->triangle_count; i++)
+    {
+        const uint32_t triangle = builder->triangles[i];
+        uint8_t* corners =
+            &builder->meshlet_triangles[builder->meshlet_triangle_count++ *
+                                        3];
+        for (size_t j = 0; j < 3; j++)
+            corners[j] =
+                builder->slots[builder->indices[triangle * 3 + j]];
+
+        if (glm_vec3_norm2(builder->normals[triangle]) == 0.0f) continue;
+        const float alignment =
+            glm_vec3_dot(meshlet->cone, builder->normals[triangle]);
+        if (alignment < spread) spread = alignment;
+    }
+    meshlet->cone[3] =
+        spread <= 0.0f ? 1.0f : sqrtf(1.0f - spread * spread);
+
+    for (size_t i = 0; i < builder->vertex_count; i++)
+        builder->slots[builder->vertices[i]] = NO_SLOT;
+    builder->vertex_count = 0;
+    builder->triangle_count = 0;
+    glm_vec3_zero(builder->normal);
+}
+
+void LetoBuildMeshlets(mesh_t* mesh)
+{
+    if (mesh == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+    if (mesh->meshlets != NULL || mesh->submesh_count == 0) return;
+
+    // Any LOD levels come after the full-detail triangles.
+    const size_t index_count = LetoGetDetailIndexCount(mesh);
+    const size_t triangle_count = index_count / 3;
+    if (triangle_count == 0) return;
+
+    builder_t builder = {
+        .mesh = mesh,
+        .indices =
+            LetoMalloc(memory_meshes, index_count * sizeof(uint32_t)),
+        .emitted = LetoCalloc(memory_meshes, triangle_count, 1),
+        .slots = LetoMalloc(memory_meshes, mesh->vertex_count),
+        .meshlets = LetoMalloc(memory_meshes,
+                               triangle_count * sizeof(mesh_meshlet_t)),
+        .meshlet_vertices = LetoMalloc(
+            memory_meshes, triangle_count * 3 * sizeof(uint32_t)),
+        .meshlet_triangles =
+            LetoMalloc(memory_meshes, triangle_count * 3),
+        .tree = LetoMalloc(memory_meshes,
+                           triangle_count * 2 * sizeof(tree_node_t)),
+        .tree_items =
+            LetoMalloc(memory_meshes, triangle_count * sizeof(uint32_t))};
+    for (size_t i = 0; i < index_count; i++)
+        builder.indices[i] =
+            mesh->index_size == sizeof(uint32_t)
+                ? ((const uint32_t*)mesh->indices)[i]
+                : ((const uint16_t*)mesh->indices)[i];
+    (void)memset(builder.slots, NO_SLOT, mesh->vertex_count);
+    BuildAdjacency_(&builder, triangle_count);
+
+    for (uint32_t i = 0; i < mesh->submesh_count; i++)
+    {
+        const size_t first = mesh->submeshes[i].first_index / 3,
+                     end = first + mesh->submeshes[i].index_count / 3;
+        if (first == end) continue;
+
+        for (size_t j = first; j < end; j++)
+            builder.tree_items[j - first] = (uint32_t)j;
+        builder.tree_count = 0;
+        BuildTree_(&builder, 0, (uint32_t)(end - first));
+
+        // Triangles are seeded in order, which after vertex cache
+        // optimization keeps consecutive meshlets close together.
+        for (size_t seed = first; seed < end; seed++)
+        {
+            if (builder.emitted[seed]) continue;
+
+            AddTriangle_(&builder, (uint32_t)seed);
+            // A meshlet only finishes once it's full, so meshlets don't
+            // end early at seams.
+            while (builder.triangle_count < MESH_MESHLET_TRIANGLES)
+            {
+                uint32_t next = FindTriangle_(&builder, first, end);
+                if (next == UINT32_MAX) next = FindNearest_(&builder);
+                if (next == UINT32_MAX) break;
+                AddTriangle_(&builder, next);
+            }
+            FinishMeshlet_(&builder, i);
+        }
+    }
+
+    LetoFree(builder.indices);
+    LetoFree(builder.normals);
+    LetoFree(builder.centroids);
+    LetoFree(builder.tree);
+    LetoFree(builder.tree_items);
+    LetoFree(builder.offsets);
+    LetoFree(builder.adjacency);
+    LetoFree(builder.emitted);
+    LetoFree(builder.slots);
+
+    mesh->meshlet_count = builder.meshlet_count;
+    mesh->meshlets = LetoRealloc(
+        builder.meshlets, builder.meshlet_count * sizeof(mesh_meshlet_t));
+    mesh->meshlet_vertices =
+        LetoRealloc(builder.meshlet_vertices,
+                    builder.meshlet_vertex_count * sizeof(uint32_t));
+    mesh->meshlet_triangles = LetoRealloc(
+        builder.meshlet_triangles, builder.meshlet_triangle_count * 3);
+}
+
+bool LetoMeshletVisible(const mesh_meshlet_t* meshlet, vec4 planes[6],
+                        vec3 camera)
+{
+    float* center = (float*)meshlet->sphere;
+    const float radius = meshlet->sphere[3];
+    for (size_t i = 0; i < 6; i++)
+        if (glm_vec3_dot(planes[i], center) + planes[i][3] < -radius)
+            return false;
+
+    // Every triangle faces away from any point whose direction lies
+    // within the cone's complement around the axis; the sphere's radius
+    // widens that test to cover the whole meshlet.
+    vec3 offset;
+    glm_vec3_sub(center, camera, offset);
+    return glm_vec3_dot(offset, (float*)meshlet->cone) <
+           meshlet->cone[3] * glm_vec3_norm(offset) + radius;
+}
+
+size_t LetoCullMeshlets(const mesh_t* mesh, vec4 planes[6], vec3 camera,
+                        uint32_t* visible)
+{
+    if (mesh == NULL || visible == NULL)
+    {
+        LetoReport(null_param);
+        return 0;
+    }
+
+    size_t count = 0;
+    for (uint32_t i = 0; i < mesh->meshlet_count; i++)
+        if (LetoMeshletVisible(&mesh->meshlets[i], planes, camera))
+            visible[count++] = i;
+    return count;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file Meshlets.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the partitioning of imported meshes into meshlets, and
+ * the culling of those meshlets. Each meshlet carries a bounding sphere
+ * for frustum culling and a normal cone for backface culling, so whole
+ * clusters of triangles can be rejected before they're submitted.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__MESHLETS__
+#define __LETO__MESHLETS__
+
+// The boolean type as described by the C standard.
+#include <stdbool.h>
+// Imported meshes.
+#include <resources/meshes.h>
+
+/**
+ * @brief The most vertices a meshlet may have. This matches the output
+ * limit most mesh shader hardware prefers.
+ */
+#define MESH_MESHLET_VERTICES 64
+
+/**
+ * @brief The most triangles a meshlet may have. 124 rather than 128
+ * leaves the triangle data of a full meshlet a multiple of four bytes.
+ */
+#define MESH_MESHLET_TRIANGLES 124
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Split a mesh's full-detail triangles into meshlets, one submesh
+ * at a time. Each meshlet is grown greedily from a seed triangle, always
+ * taking the neighbouring triangle that adds the fewest new vertices,
+ * with ties going to the one whose normal best matches the meshlet's so
+ * far. When no neighbour is left, like at a seam, the closest unused
+ * triangle of the submesh by centroid is taken instead, so a meshlet
+ * only ends once either limit is reached or its submesh runs out. This
+ * keeps meshlets full and compact, and their normal cones narrow.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh to split. Meshes that already have meshlets are
+ * left alone.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the mesh is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoBuildMeshlets(mesh_t* mesh);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Check whether any of a meshlet could be visible. The meshlet is
+ * rejected if its bounding sphere is entirely outside any frustum plane,
+ * or if the camera sits inside the region from which every one of its
+ * triangles faces away.
+ *
+ * PARAMETERS
+ *
+ * @param meshlet The meshlet.
+ * @param planes The six frustum planes in the mesh's object space, with
+ * normalized normals pointing inwards, as made by glm_frustum_planes from
+ * the model-view-projection matrix.
+ * @param camera The position of the camera in the mesh's object space.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the meshlet may be visible.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+bool LetoMeshletVisible(const mesh_meshlet_t* meshlet, vec4 planes[6],
+                        vec3 camera);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Cull every meshlet of a mesh with @ref LetoMeshletVisible.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh.
+ * @param planes The six frustum planes in the mesh's object space.
+ * @param camera The position of the camera in the mesh's object space.
+ * @param visible The storage for the indices of the meshlets that may be
+ * visible, with room for every meshlet of the mesh.
+ *
+ * RETURN VALUE
+ *
+ * @return The amount of meshlets that may be visible.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the mesh or the visible storage is NULL, this
+ * warning is thrown and 0 is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+size_t LetoCullMeshlets(const mesh_t* mesh, vec4 planes[6], vec3 camera,
+                        uint32_t* visible);
+
+#endif // __LETO__MESHLETS__
@@ -0,0 +1,1297 @@
+/**
+ * @file Models.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Models.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "models.h"             // Public interface parent
+#include <float.h>              // Float limits
+#include <gl.h>                 // OpenGL function pointers
+#include <interface/state.h>    // OpenGL state shadow
+#include <io/files.h>           // File mapping and writing
+#include <io/reporter.h>        // Error / warning reporter
+#include <math.h>               // Fabsf, roundf
+#include <resources/uniforms.h> // Decode range uniforms
+#include <string.h>             // Memcmp, memcpy, memchr, strcmp
+#include <utilities/macros.h>   // Path length
+#include <utilities/memory.h>   // Tracked allocations
+#include <utilities/strings.h>  // String creation
+
+/**
+ * @brief Round a value up to the next multiple of @ref MODEL_ALIGNMENT.
+ */
+#define ALIGN_SECTION(value)                                              \
+    (((value) + (MODEL_ALIGNMENT - 1)) & ~(uint64_t)(MODEL_ALIGNMENT - 1))
+
+// The loader reads these straight out of the mapping, so their layout is
+// part of the format and must never drift.
+_Static_assert(sizeof(model_header_t) == 160, "model header layout");
+_Static_assert(sizeof(model_material_t) == 112, "model material layout");
+_Static_assert(sizeof(model_submesh_t) == 64, "model submesh layout");
+_Static_assert(sizeof(model_lod_t) == 24, "model LOD layout");
+_Static_assert(sizeof(mesh_vertex_t) == 32, "model vertex layout");
+_Static_assert(sizeof(model_quantized_vertex_t) == 20,
+               "model quantized vertex layout");
+
+/**
+ * @brief A vertex attribute as described to OpenGL.
+ */
+typedef struct
+{
+    GLint size;
+    GLenum type;
+    GLboolean normalized;
+    GLuint offset;
+} model_attribute_t;
+
+/**
+ * @brief The attributes of @ref model_vertex_float vertices, by location.
+ */
+static const model_attribute_t float_attributes[] = {
+    {3, GL_FLOAT, GL_FALSE, offsetof(mesh_vertex_t, position)},
+    {3, GL_FLOAT, GL_FALSE, offsetof(mesh_vertex_t, normal)},
+    {2, GL_FLOAT, GL_FALSE, offsetof(mesh_vertex_t, texture)}};
+
+/**
+ * @brief The attributes of @ref model_vertex_quantized vertices, by
+ * location. The normal is still octahedral-encoded once read.
+ */
+static const model_attribute_t quantized_attributes[] = {
+    {3, GL_UNSIGNED_SHORT, GL_TRUE,
+     offsetof(model_quantized_vertex_t, position)},
+    {2, GL_SHORT, GL_TRUE, offsetof(model_quantized_vertex_t, normal)},
+    {2, GL_HALF_FLOAT, GL_FALSE,
+     offsetof(model_quantized_vertex_t, texture)},
+    {4, GL_INT_2_10_10_10_REV, GL_TRUE,
+     offsetof(model_quantized_vertex_t, tangent)}};
+
+/**
+ * @brief A string table being built for export.
+ */
+typedef struct
+{
+    char* data;
+    size_t size;
+    size_t capacity;
+} model_strings_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Write zeroes to a file until it reaches the given offset, so the
+ * next section starts aligned.
+ *
+ * PARAMETERS
+ *
+ * @param file The file being written.
+ * @param written The amount of bytes written so far. This is updated.
+ * @param offset The offset to pad to.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void PadTo_(file_t* file, uint64_t* written, uint64_t offset)
+{
+    static uint8_t zeroes[MODEL_ALIGNMENT] = {0};
+    if (offset == *written) return;
+    LetoWriteFile(file, zeroes, (size_t)(offset - *written));
+    *written = offset;
+}
+
+/**
+ * @brief Copy bounds into the fields a container stores them in.
+ */
+static void StoreBounds_(const mesh_bounds_t* bounds, float minimum[3],
+                         float maximum[3], float sphere[4])
+{
+    (void)memcpy(minimum, bounds->minimum, sizeof(vec3));
+    (void)memcpy(maximum, bounds->maximum, sizeof(vec3));
+    (void)memcpy(sphere, bounds->sphere, sizeof(vec4));
+}
+
+/**
+ * @brief Copy bounds out of the fields a container stores them in.
+ */
+static void LoadBounds_(const float minimum[3], const float maximum[3],
+                        const float sphere[4], mesh_bounds_t* bounds)
+{
+    (void)memcpy(bounds->minimum, minimum, sizeof(vec3));
+    (void)memcpy(bounds->maximum, maximum, sizeof(vec3));
+    (void)memcpy(bounds->sphere, sphere, sizeof(vec4));
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Convert a float to the nearest half float, rounding ties to
+ * even. Values past the half range become infinite.
+ *
+ * PARAMETERS
+ *
+ * @param value The float to convert.
+ *
+ * RETURN VALUE
+ *
+ * @return The bits of the half float.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static uint16_t FloatToHalf_(float value)
+{
+    uint32_t bits;
+    (void)memcpy(&bits, &value, sizeof(bits));
+    const uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+    bits &= 0x7FFFFFFF;
+
+    // NaNs stay NaNs; anything at or past 65520 rounds up to infinity.
+    if (bits > 0x7F800000) return sign | 0x7E00;
+    if (bits >= 0x477FF000) return sign | 0x7C00;
+
+    // Below 2^-14 the result is subnormal, and the mantissa (implicit bit
+    // and all) is shifted down into place by hand.
+    if (bits < 0x38800000)
+    {
+        const uint32_t shift = 126 - (bits >> 23);
+        if (shift > 24) return sign;
+
+        const uint32_t mantissa = (bits & 0x7FFFFF) | 0x800000;
+        const uint32_t half = 1u << (shift - 1);
+        const uint32_t remainder = mantissa & ((1u << shift) - 1);
+        uint32_t result = mantissa >> shift;
+        if (remainder > half || (remainder == half && (result & 1)))
+            result++;
+        return sign | (uint16_t)result;
+    }
+
+    // Rebias the exponent and round off the bottom 13 mantissa bits; a
+    // carry out of the mantissa correctly bumps the exponent.
+    bits += 0xFFF + ((bits >> 13) & 1);
+    return sign | (uint16_t)((bits - ((uint32_t)(127 - 15) << 23)) >> 13);
+}
+
+/**
+ * @brief Convert a half float back to a float. This is exact.
+ */
+static float HalfToFloat_(uint16_t half)
+{
+    const uint32_t sign = (uint32_t)(half & 0x8000) << 16;
+    const uint32_t exponent = (half >> 10) & 0x1F;
+    const uint32_t mantissa = half & 0x3FF;
+
+    uint32_t bits;
+    if (exponent == 0)
+    {
+        const float value = (float)mantissa * (1.0f / 16777216.0f);
+        return sign != 0 ? -value : value;
+    }
+    if (exponent == 0x1F) bits = sign | 0x7F800000 | (mantissa << 13);
+    else bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+
+    float value;
+    (void)memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief Round a value in [-1, 1] to a signed normalized integer whose
+ * largest magnitude is the given one.
+ */
+static int32_t Snorm_(float value, float magnitude)
+{
+    if (value > 1.0f) value = 1.0f;
+    if (value < -1.0f) value = -1.0f;
+    return (int32_t)roundf(value * magnitude);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Encode a normal onto the octahedron |x| + |y| + |z| = 1, folding
+ * the lower half over the upper so the whole sphere fits in a square.
+ *
+ * PARAMETERS
+ *
+ * @param normal The normal. This doesn't need to be normalized.
+ * @param encoded The storage for the encoded normal.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void EncodeOctahedral_(const float normal[3], int16_t encoded[2])
+{
+    const float sum =
+        fabsf(normal[0]) + fabsf(normal[1]) + fabsf(normal[2]);
+    float x = 0.0f, y = 0.0f;
+    if (sum > 0.0f)
+    {
+        x = normal[0] / sum, y = normal[1] / sum;
+        if (normal[2] < 0.0f)
+        {
+            const float folded_x = (1.0f - fabsf(y)) * (x >= 0 ? 1 : -1);
+            y = (1.0f - fabsf(x)) * (y >= 0 ? 1 : -1);
+            x = folded_x;
+        }
+    }
+
+    encoded[0] = (int16_t)Snorm_(x, 32767.0f);
+    encoded[1] = (int16_t)Snorm_(y, 32767.0f);
+}
+
+/**
+ * @brief Decode a normal encoded by @ref EncodeOctahedral_, as the
+ * quantized vertex shader does. The result is normalized.
+ */
+static void DecodeOctahedral_(const int16_t encoded[2], float normal[3])
+{
+    float x = fmaxf((float)encoded[0] / 32767.0f, -1.0f);
+    float y = fmaxf((float)encoded[1] / 32767.0f, -1.0f);
+    const float z = 1.0f - fabsf(x) - fabsf(y);
+    if (z < 0.0f)
+    {
+        const float folded_x = (1.0f - fabsf(y)) * (x >= 0 ? 1 : -1);
+        y = (1.0f - fabsf(x)) * (y >= 0 ? 1 : -1);
+        x = folded_x;
+    }
+
+    normal[0] = x, normal[1] = y, normal[2] = z;
+    glm_vec3_normalize(normal);
+}
+
+/**
+ * @brief Pack a tangent and its handedness into the bits of a
+ * GL_INT_2_10_10_10_REV value.
+ */
+static uint32_t PackTangent_(const float tangent[4])
+{
+    const uint32_t x = (uint32_t)Snorm_(tangent[0], 511.0f) & 0x3FF;
+    const uint32_t y = (uint32_t)Snorm_(tangent[1], 511.0f) & 0x3FF;
+    const uint32_t z = (uint32_t)Snorm_(tangent[2], 511.0f) & 0x3FF;
+    const uint32_t w = (uint32_t)(tangent[3] < 0.0f ? -1 : 1) & 0x3;
+    return x | (y << 10) | (z << 20) | (w << 30);
+}
+
+/**
+ * @brief Unpack a tangent packed by @ref PackTangent_, as the vertex
+ * format does; the handedness comes out as -1 or 1.
+ */
+static void UnpackTangent_(uint32_t packed, float tangent[4])
+{
+    for (size_t j = 0; j < 3; j++)
+    {
+        // Each field is sign extended from its top bit.
+        const int32_t field =
+            (int32_t)((packed >> (j * 10)) & 0x3FF) -
+            (int32_t)((packed >> (j * 10)) & 0x200) * 2;
+        tangent[j] = fmaxf((float)field / 511.0f, -1.0f);
+    }
+    tangent[3] = (packed >> 31) != 0 ? -1.0f : 1.0f;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Convert a mesh's vertices into the quantized layout.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh.
+ * @param minimum The minimum of the mesh's bounds.
+ * @param maximum The maximum of the mesh's bounds.
+ *
+ * RETURN VALUE
+ *
+ * @return The quantized vertices, to be freed with @ref LetoFree.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static model_quantized_vertex_t* QuantizeVertices_(const mesh_t* mesh,
+                                                   const float minimum[3],
+                                                   const float maximum[3])
+{
+    model_quantized_vertex_t* vertices = LetoCalloc(
+        memory_meshes, mesh->vertex_count,
+        sizeof(model_quantized_vertex_t));
+
+    float scale[3];
+    for (size_t j = 0; j < 3; j++)
+    {
+        const float extent = maximum[j] - minimum[j];
+        scale[j] = extent > 0.0f ? 65535.0f / extent : 0.0f;
+    }
+
+    for (size_t i = 0; i < mesh->vertex_count; i++)
+    {
+        const mesh_vertex_t* source = &mesh->vertices[i];
+        model_quantized_vertex_t* vertex = &vertices[i];
+
+        for (size_t j = 0; j < 3; j++)
+            vertex->position[j] = (uint16_t)roundf(
+                (source->position[j] - minimum[j]) * scale[j]);
+        EncodeOctahedral_(source->normal, vertex->normal);
+        vertex->texture[0] = FloatToHalf_(source->texture[0]);
+        vertex->texture[1] = FloatToHalf_(source->texture[1]);
+        if (mesh->tangents != NULL)
+            vertex->tangent = PackTangent_(mesh->tangents[i]);
+    }
+    return vertices;
+}
+
+/**
+ * @brief Append a string to a string table, returning its offset, or
+ * @ref MODEL_NO_STRING if the string is NULL.
+ */
+static uint32_t AddString_(model_strings_t* strings, const char* string)
+{
+    if (string == NULL) return MODEL_NO_STRING;
+
+    const size_t length = strlen(string) + 1;
+    if (strings->size + length > strings->capacity)
+    {
+        while (strings->size + length > strings->capacity)
+            strings->capacity =
+                strings->capacity == 0 ? 256 : strings->capacity * 2;
+        strings->data =
+            strings->data == NULL
+                ? LetoMalloc(memory_meshes, strings->capacity)
+                : LetoRealloc(strings->data, strings->capacity);
+    }
+
+    (void)memcpy(strings->data + strings->size, string, length);
+    strings->size += length;
+    return (uint32_t)(strings->size - length);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Check that a section lies entirely within the file and starts
+ * aligned.
+ *
+ * PARAMETERS
+ *
+ * @param header The header of the container.
+ * @param offset The offset of the section.
+ * @param count The amount of elements in the section.
+ * @param size The size of each element.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the section is valid.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool CheckSection_(const model_header_t* header, uint64_t offset,
+                          uint64_t count, uint64_t size)
+{
+    if (count == 0) return true;
+    if (offset % MODEL_ALIGNMENT != 0 || offset > header->file_size)
+        return false;
+    return count <= (header->file_size - offset) / size;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Check a container's header against the size of its mapping.
+ * Nothing past the header is touched before this passes.
+ *
+ * PARAMETERS
+ *
+ * @param header The header of the container.
+ * @param size The size of the mapping.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the header is valid.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool CheckHeader_(const model_header_t* header, size_t size)
+{
+    if (header->magic != MODEL_MAGIC || header->version != MODEL_VERSION ||
+        header->file_size != size)
+        return false;
+    if (!(header->vertex_format == model_vertex_float &&
+          header->vertex_stride == sizeof(mesh_vertex_t)) &&
+        !(header->vertex_format == model_vertex_quantized &&
+          header->vertex_stride == sizeof(model_quantized_vertex_t)))
+        return false;
+    if (header->index_size != 2 && header->index_size != 4) return false;
+    if (header->lod_count != 0 && header->submesh_count == 0) return false;
+    if (header->vertex_count == 0 || header->index_count == 0 ||
+        header->index_count % 3 != 0)
+        return false;
+
+    // The tangent stream shares the vertex stream's buffer, so it has to
+    // come after it.
+    if (header->tangent_offset != 0 &&
+        (header->vertex_format != model_vertex_float ||
+         header->tangent_offset <= header->vertex_offset ||
+         !CheckSection_(header, header->tangent_offset,
+                        header->vertex_count, sizeof(vec4))))
+        return false;
+
+    return CheckSection_(header, header->vertex_offset,
+                         header->vertex_count, header->vertex_stride) &&
+           CheckSection_(header, header->index_offset,
+                         header->index_count, header->index_size) &&
+           CheckSection_(header, header->material_offset,
+                         header->material_count,
+                         sizeof(model_material_t)) &&
+           CheckSection_(header, header->submesh_offset,
+                         header->submesh_count, sizeof(model_submesh_t)) &&
+           CheckSection_(header, header->lod_offset,
+                         (uint64_t)header->lod_count *
+                             header->submesh_count,
+                         sizeof(model_lod_t)) &&
+           CheckSection_(header, header->string_offset,
+                         header->string_size, 1);
+}
+
+/**
+ * @brief Get a string out of a mapped container's string table. This
+ * returns NULL for @ref MODEL_NO_STRING, and sets the flag if the offset
+ * is out of range or the string isn't terminated.
+ */
+static const char* GetString_(const mapping_t* mapping,
+                              const model_header_t* header,
+                              uint32_t offset, bool* malformed)
+{
+    if (offset == MODEL_NO_STRING) return NULL;
+    if (offset >= header->string_size)
+    {
+        *malformed = true;
+        return NULL;
+    }
+
+    const char* string =
+        (const char*)(mapping->data + header->string_offset + offset);
+    if (memchr(string, '\0', (size_t)(header->string_size - offset)) ==
+        NULL)
+    {
+        *malformed = true;
+        return NULL;
+    }
+    return string;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Check the tables of a container whose header has passed @ref
+ * CheckHeader_: every submesh and LOD must lie within the index stream,
+ * every submesh material must exist, and every string must be in range.
+ *
+ * PARAMETERS
+ *
+ * @param mapping The mapped container.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the tables are valid.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool CheckTables_(const mapping_t* mapping)
+{
+    const model_header_t* header = (const model_header_t*)mapping->data;
+    const model_submesh_t* submeshes =
+        (const model_submesh_t*)(mapping->data + header->submesh_offset);
+    const model_lod_t* lods =
+        (const model_lod_t*)(mapping->data + header->lod_offset);
+    const model_material_t* materials =
+        (const model_material_t*)(mapping->data +
+                                  header->material_offset);
+
+    for (size_t i = 0; i < header->submesh_count; i++)
+    {
+        if (submeshes[i].first_index > header->index_count ||
+            submeshes[i].index_count >
+                header->index_count - submeshes[i].first_index)
+            return false;
+        if (submeshes[i].material != MATERIAL_NONE &&
+            submeshes[i].material >= header->material_count)
+            return false;
+    }
+    const size_t lod_count =
+        (size_t)header->lod_count * header->submesh_count;
+    for (size_t i = 0; i < lod_count; i++)
+    {
+        if (lods[i].first_index > header->index_count ||
+            lods[i].index_count >
+                header->index_count - lods[i].first_index)
+            return false;
+    }
+
+    bool malformed = false;
+    for (size_t i = 0; i < header->material_count; i++)
+    {
+        (void)GetString_(mapping, header, materials[i].name, &malformed);
+        for (size_t j = 0; j < material_map_count; j++)
+            (void)GetString_(mapping, header, materials[i].maps[j],
+                             &malformed);
+    }
+    return !malformed;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Map a container and check it, header and tables, so that
+ * nothing read out of it afterward can fall outside the file.
+ *
+ * PARAMETERS
+ *
+ * @param path The path of the container.
+ * @param mapping The storage for the mapping.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the container was mapped and is valid. It's
+ * left unmapped if not.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning mesh_malformed -- If the container is malformed, this warning
+ * is thrown and false is returned.
+ * @note For warnings unhandled by this function, see @ref LetoMapFile.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool OpenModel_(const char* path, mapping_t* mapping)
+{
+    if (!LetoMapFile(path, mapping)) return false;
+
+    const model_header_t* header = (const model_header_t*)mapping->data;
+    if (mapping->size < sizeof(model_header_t) ||
+        !CheckHeader_(header, mapping->size) || !CheckTables_(mapping))
+    {
+        LetoReport(mesh_malformed);
+        LetoUnmapFile(mapping);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Check that a mapped container's vertices and tangents are the
+ * mesh's, once decoded. Full-precision vertices and tangents must match
+ * exactly; quantized ones must be within the tolerances @ref
+ * LetoPickVertexFormat picked them with, their normals within a degree
+ * or so, and their tangents within a rounding of 10 bits.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh.
+ * @param mapping The mapped container, already checked.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the vertices match.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool VerifyVertices_(const mesh_t* mesh, const mapping_t* mapping)
+{
+    const model_header_t* header = (const model_header_t*)mapping->data;
+    const uint8_t* stream = mapping->data + header->vertex_offset;
+    if (header->vertex_format == model_vertex_float)
+    {
+        if (memcmp(stream, mesh->vertices,
+                   mesh->vertex_count * sizeof(mesh_vertex_t)) != 0 ||
+            (header->tangent_offset != 0) != (mesh->tangents != NULL))
+            return false;
+        return mesh->tangents == NULL ||
+               memcmp(mapping->data + header->tangent_offset,
+                      mesh->tangents,
+                      mesh->vertex_count * sizeof(vec4)) == 0;
+    }
+
+    // Rounding is off by at most half a step, and the decode itself by a
+    // float rounding or two of the bounds.
+    float step[3], slack[3];
+    for (size_t j = 0; j < 3; j++)
+    {
+        step[j] = (header->maximum[j] - header->minimum[j]) / 65535.0f;
+        const float magnitude =
+            fabsf(header->minimum[j]) + fabsf(header->maximum[j]);
+        slack[j] = step[j] * 0.5f + magnitude * FLT_EPSILON * 4.0f;
+    }
+
+    const model_quantized_vertex_t* vertices =
+        (const model_quantized_vertex_t*)stream;
+    for (size_t i = 0; i < mesh->vertex_count; i++)
+    {
+        const mesh_vertex_t* source = &mesh->vertices[i];
+        for (size_t j = 0; j < 3; j++)
+        {
+            const float position =
+                header->minimum[j] +
+                (float)vertices[i].position[j] * step[j];
+            if (!(fabsf(position - source->position[j]) <= slack[j]))
+                return false;
+        }
+        for (size_t j = 0; j < 2; j++)
+            if (!(fabsf(HalfToFloat_(vertices[i].texture[j]) -
+                        source->texture[j]) <= MODEL_TEXTURE_TOLERANCE))
+                return false;
+
+        if (mesh->tangents == NULL)
+        {
+            if (vertices[i].tangent != 0) return false;
+        }
+        else
+        {
+            vec4 tangent;
+            UnpackTangent_(vertices[i].tangent, tangent);
+            for (size_t j = 0; j < 3; j++)
+                if (!(fabsf(tangent[j] - mesh->tangents[i][j]) <=
+                      0.5f / 511.0f + FLT_EPSILON * 4.0f))
+                    return false;
+            if ((tangent[3] < 0.0f) != (mesh->tangents[i][3] < 0.0f))
+                return false;
+        }
+
+        vec3 expected, normal;
+        glm_vec3_copy((float*)source->normal, expected);
+        if (glm_vec3_norm2(expected) == 0.0f) continue;
+        glm_vec3_normalize(expected);
+        DecodeOctahedral_(vertices[i].normal, normal);
+        if (glm_vec3_dot(expected, normal) < 0.9998f) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Check that bounds stored in a container are the ones given.
+ */
+static bool VerifyBounds_(const mesh_bounds_t* bounds,
+                          const float minimum[3], const float maximum[3],
+                          const float sphere[4])
+{
+    return memcmp(bounds->minimum, minimum, sizeof(vec3)) == 0 &&
+           memcmp(bounds->maximum, maximum, sizeof(vec3)) == 0 &&
+           memcmp(bounds->sphere, sphere, sizeof(vec4)) == 0;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Register the materials of a mapped container with the material
+ * library, and give the model its submeshes in terms of library indices.
+ *
+ * PARAMETERS
+ *
+ * @param mapping The mapped container, already checked.
+ * @param model The model to fill in.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void LoadSubmeshes_(const mapping_t* mapping, model_t* model)
+{
+    const model_header_t* header = (const model_header_t*)mapping->data;
+    const model_material_t* materials =
+        (const model_material_t*)(mapping->data +
+                                  header->material_offset);
+    const model_submesh_t* submeshes =
+        (const model_submesh_t*)(mapping->data + header->submesh_offset);
+
+    uint32_t* registered = NULL;
+    if (header->material_count != 0)
+        registered = LetoMalloc(memory_meshes,
+                                header->material_count * sizeof(uint32_t));
+
+    bool malformed = false;
+    for (size_t i = 0; i < header->material_count; i++)
+    {
+        const model_material_t* source = &materials[i];
+        material_t material = {
+            .illumination = (illumination_t)source->illumination,
+            .transparency = source->transparency,
+            .refraction = source->refraction,
+            .name = GetString_(mapping, header, source->name, &malformed)};
+        (void)memcpy(material.specular, source->specular, sizeof(vec4));
+        (void)memcpy(material.diffuse, source->diffuse, sizeof(vec3));
+        (void)memcpy(material.ambient, source->ambient, sizeof(vec3));
+        (void)memcpy(material.emission, source->emission, sizeof(vec3));
+        (void)memcpy(material.transmission_filter,
+                     source->transmission_filter, sizeof(vec3));
+        for (size_t j = 0; j < material_map_count; j++)
+            material.maps[j] =
+                GetString_(mapping, header, source->maps[j], &malformed);
+
+        registered[i] = LetoRegisterMaterial(&material);
+    }
+
+    model->submesh_count = header->submesh_count;
+    if (model->submesh_count != 0)
+        model->submeshes = LetoMalloc(
+            memory_meshes, model->submesh_count * sizeof(mesh_submesh_t));
+    for (size_t i = 0; i < model->submesh_count; i++)
+    {
+        const uint32_t material =
+            submeshes[i].material == MATERIAL_NONE
+                ? MATERIAL_NONE
+                : registered[submeshes[i].material];
+        LetoRetainMaterial(material);
+        model->submeshes[i] = (mesh_submesh_t){
+            .first_index = (size_t)submeshes[i].first_index,
+            .index_count = (size_t)submeshes[i].index_count,
+            .material = material};
+        LoadBounds_(submeshes[i].minimum, submeshes[i].maximum,
+                    submeshes[i].sphere, &model->submeshes[i].bounds);
+    }
+
+    for (size_t i = 0; i < header->material_count; i++)
+        LetoReleaseMaterial(registered[i]);
+    LetoFree(registered);
+}
+
+model_vertex_format_t LetoPickVertexFormat(const mesh_t* mesh)
+{
+    if (mesh == NULL)
+    {
+        LetoReport(null_param);
+        return model_vertex_float;
+    }
+    if (mesh->vertex_count == 0) return model_vertex_float;
+
+    // Rounding to the nearest of 65536 steps across the bounds is off by
+    // at most half a step.
+    const mesh_bounds_t* bounds = &mesh->bounds;
+    for (size_t j = 0; j < 3; j++)
+        if ((bounds->maximum[j] - bounds->minimum[j]) / 65535.0f * 0.5f >
+            MODEL_POSITION_TOLERANCE)
+            return model_vertex_float;
+
+    for (size_t i = 0; i < mesh->vertex_count; i++)
+    {
+        for (size_t j = 0; j < 2; j++)
+        {
+            const float value = mesh->vertices[i].texture[j];
+            const float error =
+                fabsf(HalfToFloat_(FloatToHalf_(value)) - value);
+            if (!(error <= MODEL_TEXTURE_TOLERANCE))
+                return model_vertex_float;
+        }
+    }
+    return model_vertex_quantized;
+}
+
+bool LetoExportModel(const mesh_t* mesh, const char* path)
+{
+    if (mesh == NULL || path == NULL)
+    {
+        LetoReport(null_param);
+        return false;
+    }
+
+    // Gather the materials the submeshes use, and point each submesh at
+    // its material's slot in the container.
+    uint32_t* materials = NULL;
+    model_submesh_t* submeshes = NULL;
+    size_t material_count = 0;
+    if (mesh->submesh_count != 0)
+    {
+        materials = LetoMalloc(memory_meshes,
+                               mesh->submesh_count * sizeof(uint32_t));
+        submeshes = LetoMalloc(memory_meshes, mesh->submesh_count *
+                                                  sizeof(model_submesh_t));
+    }
+    for (size_t i = 0; i < mesh->submesh_count; i++)
+    {
+        const mesh_submesh_t* submesh = &mesh->submeshes[i];
+        uint32_t slot = MATERIAL_NONE;
+        if (submesh->material != MATERIAL_NONE)
+        {
+            for (slot = 0; slot < material_count; slot++)
+                if (materials[slot] == submesh->material) break;
+            if (slot == material_count)
+                materials[material_count++] = submesh->material;
+        }
+        submeshes[i] = (model_submesh_t){
+            .first_index = submesh->first_index,
+            .index_count = submesh->index_count,
+            .material = slot};
+        StoreBounds_(&submesh->bounds, submeshes[i].minimum,
+                     submeshes[i].maximum, submeshes[i].sphere);
+    }
+
+    model_header_t header = {
+        .magic = MODEL_MAGIC,
+        .version = MODEL_VERSION,
+        .vertex_format = LetoPickVertexFormat(mesh),
+        .vertex_stride = sizeof(mesh_vertex_t),
+        .index_size = mesh->index_size,
+        .material_count = (uint32_t)material_count,
+        .submesh_count = (uint32_t)mesh->submesh_count,
+        .vertex_count = mesh->vertex_count,
+        .index_count = mesh->index_count};
+    StoreBounds_(&mesh->bounds, header.minimum, header.maximum,
+                 header.sphere);
+
+    const void* vertices = mesh->vertices;
+    model_quantized_vertex_t* quantized = NULL;
+    if (header.vertex_format == model_vertex_quantized)
+    {
+        quantized =
+            QuantizeVertices_(mesh, header.minimum, header.maximum);
+        vertices = quantized;
+        header.vertex_stride = sizeof(model_quantized_vertex_t);
+    }
+
+    const size_t lod_count = mesh->lod_count * mesh->submesh_count;
+    model_lod_t* lods = NULL;
+    if (lod_count != 0)
+    {
+        header.lod_count = (uint32_t)mesh->lod_count;
+        lods = LetoMalloc(memory_meshes, lod_count * sizeof(model_lod_t));
+    }
+    for (size_t i = 0; i < lod_count; i++)
+        lods[i] = (model_lod_t){mesh->lods[i].first_index,
+                                mesh->lods[i].index_count,
+                                mesh->lods[i].error, 0};
+
+    model_strings_t strings = {0};
+    model_material_t* records = NULL;
+    if (material_count != 0)
+        records = LetoCalloc(memory_meshes, material_count,
+                             sizeof(model_material_t));
+    for (size_t i = 0; i < material_count; i++)
+    {
+        const material_t* source = LetoGetMaterial(materials[i]);
+        model_material_t* record = &records[i];
+        (void)memcpy(record->specular, source->specular, sizeof(vec4));
+        (void)memcpy(record->diffuse, source->diffuse, sizeof(vec3));
+        (void)memcpy(record->ambient, source->ambient, sizeof(vec3));
+        (void)memcpy(record->emission, source->emission, sizeof(vec3));
+        (void)memcpy(record->transmission_filter,
+                     source->transmission_filter, sizeof(vec3));
+        record->transparency = source->transparency;
+        record->refraction = source->refraction;
+        record->illumination = (uint32_t)source->illumination;
+        record->name = AddString_(&strings, source->name);
+        for (size_t j = 0; j < material_map_count; j++)
+            record->maps[j] = AddString_(&strings, source->maps[j]);
+    }
+    LetoFree(materials);
+
+    // Full-precision vertices leave their tangents out, so those go in a
+    // stream of their own right after.
+    size_t tangent_size = 0;
+    if (header.vertex_format == model_vertex_float &&
+        mesh->tangents != NULL)
+        tangent_size = mesh->vertex_count * sizeof(vec4);
+    header.vertex_offset = ALIGN_SECTION(sizeof(model_header_t));
+    header.index_offset = ALIGN_SECTION(
+        header.vertex_offset + mesh->vertex_count * header.vertex_stride);
+    if (tangent_size != 0)
+    {
+        header.tangent_offset = header.index_offset;
+        header.index_offset =
+            ALIGN_SECTION(header.tangent_offset + tangent_size);
+    }
+    header.material_offset = ALIGN_SECTION(
+        header.index_offset + mesh->index_count * mesh->index_size);
+    header.submesh_offset = ALIGN_SECTION(
+        header.material_offset +
+        material_count * sizeof(model_material_t));
+    header.lod_offset = ALIGN_SECTION(
+        header.submesh_offset +
+        mesh->submesh_count * sizeof(model_submesh_t));
+    header.string_offset = ALIGN_SECTION(
+        header.lod_offset + lod_count * sizeof(model_lod_t));
+    header.string_size = strings.size;
+    header.file_size =
+        ALIGN_SECTION(header.string_offset + header.string_size);
+
+    file_t* file = LetoOpenFile(w, path);
+    if (file != NULL)
+    {
+        uint64_t written = sizeof(model_header_t);
+        LetoWriteFile(file, (uint8_t*)&header, sizeof(model_header_t));
+
+        const struct
+        {
+            uint64_t offset;
+            const void* data;
+            size_t size;
+        } sections[] = {
+            {header.vertex_offset, vertices,
+             mesh->vertex_count * header.vertex_stride},
+            {header.tangent_offset, mesh->tangents, tangent_size},
+            {header.index_offset, mesh->indices,
+             mesh->index_count * mesh->index_size},
+            {header.material_offset, records,
+             material_count * sizeof(model_material_t)},
+            {header.submesh_offset, submeshes,
+             mesh->submesh_count * sizeof(model_submesh_t)},
+            {header.lod_offset, lods, lod_count * sizeof(model_lod_t)},
+            {header.string_offset, strings.data, strings.size}};
+
+        for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++)
+        {
+            if (sections[i].size == 0) continue;
+            PadTo_(file, &written, sections[i].offset);
+            LetoWriteFile(file, (uint8_t*)sections[i].data,
+                          sections[i].size);
+            written += sections[i].size;
+        }
+        PadTo_(file, &written, header.file_size);
+        LetoCloseFile(file);
+    }
+
+    LetoFree(quantized);
+    LetoFree(lods);
+    LetoFree(records);
+    LetoFree(submeshes);
+    LetoFree(strings.data);
+    return file != NULL;
+}
+
+bool LetoVerifyModel(const mesh_t* mesh, const char* path)
+{
+    if (mesh == NULL || path == NULL)
+    {
+        LetoReport(null_param);
+        return false;
+    }
+
+    mapping_t mapping;
+    if (!OpenModel_(path, &mapping)) return false;
+
+    const model_header_t* header = (const model_header_t*)mapping.data;
+    const size_t lod_count =
+        mesh->lods != NULL ? mesh->lod_count * mesh->submesh_count : 0;
+    bool matches =
+        header->vertex_format == LetoPickVertexFormat(mesh) &&
+        header->vertex_count == mesh->vertex_count &&
+        header->index_count == mesh->index_count &&
+        header->index_size == mesh->index_size &&
+        header->submesh_count == mesh->submesh_count &&
+        (size_t)header->lod_count * header->submesh_count == lod_count &&
+        VerifyBounds_(&mesh->bounds, header->minimum, header->maximum,
+                      header->sphere);
+
+    if (matches)
+        matches = memcmp(mapping.data + header->index_offset,
+                         mesh->indices,
+                         mesh->index_count * mesh->index_size) == 0 &&
+                  VerifyVertices_(mesh, &mapping);
+
+    const model_submesh_t* submeshes =
+        (const model_submesh_t*)(mapping.data + header->submesh_offset);
+    const model_material_t* materials =
+        (const model_material_t*)(mapping.data + header->material_offset);
+    for (size_t i = 0; matches && i < mesh->submesh_count; i++)
+    {
+        const mesh_submesh_t* submesh = &mesh->submeshes[i];
+        matches = submeshes[i].first_index == submesh->first_index &&
+                  submeshes[i].index_count == submesh->index_count &&
+                  VerifyBounds_(&submesh->bounds, submeshes[i].minimum,
+                                submeshes[i].maximum,
+                                submeshes[i].sphere) &&
+                  (submeshes[i].material == MATERIAL_NONE) ==
+                      (submesh->material == MATERIAL_NONE);
+        if (!matches || submesh->material == MATERIAL_NONE) continue;
+
+        // Materials are stored by value, so their names stand in for
+        // them.
+        bool malformed = false;
+        const char* name =
+            GetString_(&mapping, header,
+                       materials[submeshes[i].material].name, &malformed);
+        const char* expected = LetoGetMaterial(submesh->material)->name;
+        matches = (name == NULL) == (expected == NULL) &&
+                  (name == NULL || strcmp(name, expected) == 0);
+    }
+
+    const model_lod_t* lods =
+        (const model_lod_t*)(mapping.data + header->lod_offset);
+    for (size_t i = 0; matches && i < lod_count; i++)
+        matches = lods[i].first_index == mesh->lods[i].first_index &&
+                  lods[i].index_count == mesh->lods[i].index_count &&
+                  lods[i].error == mesh->lods[i].error;
+
+    LetoUnmapFile(&mapping);
+    if (!matches) LetoReport(mesh_malformed);
+    return matches;
+}
+
+model_t* LetoLoadModel(const char* name)
+{
+    if (name == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+
+    // A container that's missing, older than its mesh, or can't be read,
+    // like one of an older version, is rebuilt by importing the mesh
+    // again, which writes a fresh one.
+    char* path = LetoStringCreate(MAX_PATH_LENGTH, MODEL_PATH, name);
+    char* source =
+        LetoStringCreate(MAX_PATH_LENGTH, ASSET_DIR "/meshes/%s", name);
+    const uint64_t written = LetoGetFileTime(path);
+    mapping_t mapping;
+    // File times are coarse, so a container written in the same tick as
+    // its mesh was edited counts as stale.
+    bool opened = written > LetoGetFileTime(source) &&
+                  OpenModel_(path, &mapping);
+    LetoStringFree(&source);
+    if (!opened)
+    {
+        mesh_t* mesh = LetoLoadMesh(name);
+        if (mesh != NULL) LetoUnloadMesh(mesh);
+        opened = OpenModel_(path, &mapping);
+    }
+    LetoStringFree(&path);
+    if (!opened) return NULL;
+
+    const model_header_t* header = (const model_header_t*)mapping.data;
+    model_t* model = LetoCalloc(memory_meshes, 1, sizeof(model_t));
+    model->index_count = header->index_count;
+    model->vertex_count = header->vertex_count;
+    model->index_type = header->index_size == 2 ? GL_UNSIGNED_SHORT
+                                                : GL_UNSIGNED_INT;
+    model->vertex_format = (model_vertex_format_t)header->vertex_format;
+    LoadBounds_(header->minimum, header->maximum, header->sphere,
+                &model->bounds);
+    model->name = LetoStringCreate(MAX_PATH_LENGTH, "%s", name);
+
+    // Both streams go from the mapping straight into immutable storage;
+    // the pages are only faulted in as the driver copies them. Tangents
+    // ride along at the end of the vertex buffer.
+    const uint64_t tangent_start =
+        header->tangent_offset - header->vertex_offset;
+    const uint64_t vertex_size =
+        header->tangent_offset != 0
+            ? tangent_start + header->vertex_count * sizeof(vec4)
+            : header->vertex_count * header->vertex_stride;
+    glCreateBuffers(1, &model->vertex_buffer);
+    glNamedBufferStorage(model->vertex_buffer, (GLsizeiptr)vertex_size,
+                         mapping.data + header->vertex_offset, 0);
+    glCreateBuffers(1, &model->index_buffer);
+    glNamedBufferStorage(
+        model->index_buffer,
+        (GLsizeiptr)(header->index_count * header->index_size),
+        mapping.data + header->index_offset, 0);
+
+    glCreateVertexArrays(1, &model->vertex_array);
+    glVertexArrayVertexBuffer(model->vertex_array, 0,
+                              model->vertex_buffer, 0,
+                              (GLsizei)header->vertex_stride);
+    glVertexArrayElementBuffer(model->vertex_array, model->index_buffer);
+
+    const GLuint attribute_count = LetoDescribeModelVertices(
+        model->vertex_array, model->vertex_format, 0);
+    if (header->tangent_offset != 0)
+    {
+        glVertexArrayVertexBuffer(model->vertex_array, 1,
+                                  model->vertex_buffer,
+                                  (GLintptr)tangent_start, sizeof(vec4));
+        glEnableVertexArrayAttrib(model->vertex_array, attribute_count);
+        glVertexArrayAttribFormat(model->vertex_array, attribute_count, 4,
+                                  GL_FLOAT, GL_FALSE, 0);
+        glVertexArrayAttribBinding(model->vertex_array, attribute_count,
+                                   1);
+    }
+
+    LoadSubmeshes_(&mapping, model);
+
+    model->lod_count = header->lod_count;
+    if (model->lod_count != 0)
+    {
+        const size_t size =
+            model->lod_count * model->submesh_count * sizeof(model_lod_t);
+        model->lods = LetoMalloc(memory_meshes, size);
+        (void)memcpy(model->lods, mapping.data + header->lod_offset, size);
+    }
+
+    LetoUnmapFile(&mapping);
+    return model;
+}
+
+unsigned int LetoDescribeModelVertices(unsigned int vertex_array,
+                                       model_vertex_format_t format,
+                                       unsigned int binding)
+{
+    const model_attribute_t* attributes = float_attributes;
+    GLuint attribute_count =
+        sizeof(float_attributes) / sizeof(float_attributes[0]);
+    if (format == model_vertex_quantized)
+    {
+        attributes = quantized_attributes;
+        attribute_count =
+            sizeof(quantized_attributes) / sizeof(quantized_attributes[0]);
+    }
+    for (GLuint i = 0; i < attribute_count; i++)
+    {
+        glEnableVertexArrayAttrib(vertex_array, i);
+        glVertexArrayAttribFormat(vertex_array, i, attributes[i].size,
+                                  attributes[i].type,
+                                  attributes[i].normalized,
+                                  attributes[i].offset);
+        glVertexArrayAttribBinding(vertex_array, i, binding);
+    }
+    return attribute_count;
+}
+
+size_t LetoGetVertexStride(model_vertex_format_t format)
+{
+    return format == model_vertex_quantized
+               ? sizeof(model_quantized_vertex_t)
+               : sizeof(mesh_vertex_t);
+}
+
+void LetoBindModel(shader_t* shader, const model_t* model)
+{
+    if (shader == NULL || model == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+    if (model->vertex_format != model_vertex_quantized) return;
+
+    (void)LetoSetUniformVec3At(shader, MODEL_MINIMUM_LOCATION,
+                               model->bounds.minimum);
+    (void)LetoSetUniformVec3At(shader, MODEL_MAXIMUM_LOCATION,
+                               model->bounds.maximum);
+}
+
+size_t LetoSelectModelLOD(const model_t* model, float distance,
+                          float projection, float threshold)
+{
+    if (model == NULL)
+    {
+        LetoReport(null_param);
+        return 0;
+    }
+    if (distance <= 0.0f) return 0;
+
+    // Errors only grow down the chain, so the first level past the
+    // threshold ends the search.
+    size_t level = 0;
+    for (size_t i = 1; i < model->lod_count; i++)
+    {
+        const float error =
+            model->lods[i * model->submesh_count].error * projection /
+            distance;
+        if (error > threshold) break;
+        level = i;
+    }
+    return level;
+}
+
+void LetoUnloadModel(model_t* model)
+{
+    if (model == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    LetoForgetGLObject(gl_state_vertex_array, model->vertex_array);
+    LetoForgetGLObject(gl_state_buffer, model->vertex_buffer);
+    LetoForgetGLObject(gl_state_buffer, model->index_buffer);
+    glDeleteVertexArrays(1, &model->vertex_array);
+    glDeleteBuffers(1, &model->vertex_buffer);
+    glDeleteBuffers(1, &model->index_buffer);
+
+    for (size_t i = 0; i < model->submesh_count; i++)
+        LetoReleaseMaterial(model->submeshes[i].material);
+    LetoFree(model->submeshes);
+    LetoFree(model->lods);
+    LetoFree((void*)model->name);
+    LetoFree(model);
+}
@@ -0,0 +1,576 @@
+/**
+ * @file Models.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides Leto's binary mesh container, and the GPU-resident
+ * models loaded from it. Containers are written once from imported meshes
+ * and laid out so that loading one is a single file mapping followed by
+ * the buffer uploads, without any parsing in between.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__MODELS__
+#define __LETO__MODELS__
+
+// The boolean type as described by the C standard.
+#include <stdbool.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+// Imported meshes and materials.
+#include <resources/meshes.h>
+// Shaders, which decode quantized models.
+#include <resources/shaders.h>
+
+/**
+ * @brief The first four bytes of every container, "LMSH" on disk.
+ */
+#define MODEL_MAGIC UINT32_C(0x48534D4C)
+
+/**
+ * @brief The version of the container layout. Loaders refuse any other.
+ */
+#define MODEL_VERSION 3
+
+/**
+ * @brief The path of a mesh's container, formatted with the file name of
+ * the mesh it was imported from, like "cube.obj". Importing a mesh writes
+ * it, and models are loaded from it from then on, until it's deleted,
+ * goes stale or can't be read, which makes the next load import the
+ * mesh again.
+ */
+#define MODEL_PATH ASSET_DIR "/meshes/%s.lmsh"
+
+/**
+ * @brief The alignment of every section within a container. Mappings are
+ * page aligned, so this carries over to the mapped sections.
+ */
+#define MODEL_ALIGNMENT 64
+
+/**
+ * @brief The projected error, in pixels, below which @ref
+ * LetoSelectModelLOD considers a level indistinguishable from full
+ * detail.
+ */
+#define MODEL_LOD_THRESHOLD 1.0f
+
+/**
+ * @brief The uniform locations rss/shaders/quantized gives the corners of
+ * a model's bounds, which its positions are decoded from. They're set by
+ * location, as SPIR-V programs needn't keep uniform names.
+ */
+#define MODEL_MINIMUM_LOCATION 0
+#define MODEL_MAXIMUM_LOCATION 1
+
+/**
+ * @brief The string offset standing in for a string a container doesn't
+ * have, like a texture map a material doesn't use.
+ */
+#define MODEL_NO_STRING UINT32_MAX
+
+/**
+ * @brief The largest position error, in object-space units, that a mesh
+ * may pick up from quantization before it's exported at full precision
+ * instead. 16-bit positions relative to the bounds keep meshes up to
+ * about 650 units across within this.
+ */
+#define MODEL_POSITION_TOLERANCE 0.005f
+
+/**
+ * @brief The largest texture coordinate error a mesh may pick up from
+ * quantization, about a texel of a 1024-wide texture. Half floats keep
+ * coordinates within [-4, 4] inside this; meshes tiling further are
+ * exported at full precision.
+ */
+#define MODEL_TEXTURE_TOLERANCE (1.0f / 1024.0f)
+
+/**
+ * @brief An enumerator describing the layouts a vertex stream can have.
+ */
+typedef enum
+{
+    /**
+     * @brief Full-precision @ref mesh_vertex_t vertices.
+     */
+    model_vertex_float,
+    /**
+     * @brief Compressed @ref model_quantized_vertex_t vertices, decoded by
+     * the vertex shader.
+     */
+    model_vertex_quantized,
+} model_vertex_format_t;
+
+/**
+ * @brief A vertex in the compressed layout, 20 bytes against the 32 of
+ * @ref mesh_vertex_t. Every attribute is read through a normalized or
+ * half-float vertex format, so only the position and normal need any
+ * decoding in the shader.
+ */
+typedef struct
+{
+    /**
+     * @brief The position as unsigned normalized 16-bit values, from the
+     * minimum of the container's bounds at 0 to the maximum at 65535.
+     */
+    uint16_t position[3];
+    uint16_t reserved;
+    /**
+     * @brief The normal, octahedral-encoded into two signed normalized
+     * 16-bit values. Zero normals decode as +Z.
+     */
+    int16_t normal[2];
+    /**
+     * @brief The texture coordinate as two half floats.
+     */
+    uint16_t texture[2];
+    /**
+     * @brief The tangent as signed normalized 10-bit X, Y and Z, with the
+     * handedness in the top two bits, as GL_INT_2_10_10_10_REV. This is 0
+     * for meshes without tangents.
+     */
+    uint32_t tangent;
+} model_quantized_vertex_t;
+
+/**
+ * @brief The header at the start of every container. All offsets are in
+ * bytes from the start of the file, and all values are little-endian.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t version;
+    /**
+     * @brief The layout of the vertex stream, see @ref
+     * model_vertex_format_t.
+     */
+    uint32_t vertex_format;
+    uint32_t vertex_stride;
+    /**
+     * @brief The width of each index in bytes, 2 or 4.
+     */
+    uint32_t index_size;
+    uint32_t material_count;
+    uint32_t submesh_count;
+    /**
+     * @brief The amount of LOD levels, counting full detail, or 0 if the
+     * container has no chain. The LOD table holds one @ref model_lod_t per
+     * submesh for each level.
+     */
+    uint32_t lod_count;
+    uint64_t vertex_count;
+    uint64_t index_count;
+    uint64_t vertex_offset;
+    /**
+     * @brief The stream of the vertices' tangents, one vec4 each, or 0 if
+     * the container has none. Only full-precision containers have this
+     * stream; quantized vertices hold their own tangents. It directly
+     * follows the vertex stream, so both go in one buffer.
+     */
+    uint64_t tangent_offset;
+    uint64_t index_offset;
+    uint64_t material_offset;
+    uint64_t submesh_offset;
+    uint64_t lod_offset;
+    /**
+     * @brief The string table, holding NUL-terminated material names and
+     * texture map names. Strings are referred to by their offset within
+     * it.
+     */
+    uint64_t string_offset;
+    uint64_t string_size;
+    /**
+     * @brief The size of the whole container, used to catch truncated
+     * files before anything is read out of them.
+     */
+    uint64_t file_size;
+    /**
+     * @brief The bounds of every vertex, see @ref mesh_bounds_t.
+     */
+    float minimum[3];
+    float maximum[3];
+    float sphere[4];
+} model_header_t;
+
+/**
+ * @brief A material as stored in a container. This mirrors @ref
+ * material_t, with its strings stored as string table offsets.
+ */
+typedef struct
+{
+    float specular[4];
+    float diffuse[3];
+    float ambient[3];
+    float emission[3];
+    float transmission_filter[3];
+    float transparency;
+    float refraction;
+    uint32_t illumination;
+    uint32_t name;
+    uint32_t maps[material_map_count];
+    uint32_t reserved;
+} model_material_t;
+
+/**
+ * @brief A submesh as stored in a container, see @ref mesh_submesh_t.
+ */
+typedef struct
+{
+    uint64_t first_index;
+    uint64_t index_count;
+    /**
+     * @brief The index of the submesh's material within the container's
+     * material table, or @ref MATERIAL_NONE.
+     */
+    uint32_t material;
+    uint32_t reserved;
+    /**
+     * @brief The bounds of the submesh, see @ref mesh_bounds_t.
+     */
+    float minimum[3];
+    float maximum[3];
+    float sphere[4];
+} model_submesh_t;
+
+/**
+ * @brief A submesh's run within a level of a container's LOD chain, see
+ * @ref mesh_lod_t. Every level shares the vertex stream, and draws its own
+ * runs of the index stream.
+ */
+typedef struct
+{
+    /**
+     * @brief The first index of the run within the index stream.
+     */
+    uint64_t first_index;
+    uint64_t index_count;
+    /**
+     * @brief The geometric error of the level, in object-space units.
+     */
+    float error;
+    uint32_t reserved;
+} model_lod_t;
+
+/**
+ * @brief A mesh that lives on the GPU, loaded from a container.
+ */
+typedef struct
+{
+    /**
+     * @brief The OpenGL vertex array object describing the vertex layout
+     * and binding both buffers.
+     */
+    unsigned int vertex_array;
+    unsigned int vertex_buffer;
+    unsigned int index_buffer;
+    /**
+     * @brief The OpenGL type of the indices, for draw calls.
+     */
+    unsigned int index_type;
+    size_t index_count;
+    /**
+     * @brief The amount of vertices in the vertex stream, tangents aside.
+     */
+    size_t vertex_count;
+    /**
+     * @brief The layout of the vertex buffer, which decides the shader
+     * the model is drawn with.
+     */
+    model_vertex_format_t vertex_format;
+    /**
+     * @brief The bounds of the model. Quantized models need the corners
+     * of the box uploaded to decode their positions.
+     */
+    mesh_bounds_t bounds;
+    /**
+     * @brief The submeshes of the model, whose materials are in the
+     * material library. Each holds a reference to its material, and
+     * carries its bounds.
+     */
+    mesh_submesh_t* submeshes;
+    size_t submesh_count;
+    /**
+     * @brief The LOD chain of the model, laid out like @ref mesh_t::lods,
+     * or NULL if it has none.
+     */
+    model_lod_t* lods;
+    size_t lod_count;
+    const char* name;
+} model_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Pick the vertex layout a mesh is exported with. A mesh is
+ * quantized unless its positions or texture coordinates would lose more
+ * than @ref MODEL_POSITION_TOLERANCE or @ref MODEL_TEXTURE_TOLERANCE.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh.
+ *
+ * RETURN VALUE
+ *
+ * @return The layout to export the mesh with, @ref model_vertex_float if
+ * the mesh is NULL.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the mesh is NULL, this warning is thrown and
+ * @ref model_vertex_float is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+model_vertex_format_t LetoPickVertexFormat(const mesh_t* mesh);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Write an imported mesh out as a container, in the vertex layout
+ * @ref LetoPickVertexFormat picks for it. Only the materials its
+ * submeshes use are written, and its LOD chain is written along with its
+ * indices. Its bounds and tangents are written too, so neither is ever
+ * worked out again at runtime.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh to write.
+ * @param path The path of the container, be it absolute or relative.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the container was written.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If either parameter is NULL, this warning is
+ * thrown and false is returned.
+ * @note For warnings unhandled by this function, see @ref LetoOpenFile.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For errors unhandled by this function, see @ref LetoWriteFile.
+ *
+ */
+bool LetoExportModel(const mesh_t* mesh, const char* path);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Check that a container loads back as the mesh it was written
+ * from. Every section is read through the same checks @ref LetoLoadModel
+ * makes, and compared against the mesh: indices, submeshes, LODs and the
+ * cached bounds must match exactly, as must full-precision vertices and
+ * tangents, and quantized vertices and tangents must decode to within
+ * the tolerances they were picked with.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh the container was written from.
+ * @param path The path of the container, be it absolute or relative.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the container matches the mesh.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If either parameter is NULL, this warning is
+ * thrown and false is returned.
+ * @warning mesh_malformed -- If the container is malformed or differs
+ * from the mesh, this warning is thrown and false is returned.
+ * @note For warnings unhandled by this function, see @ref LetoMapFile.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+bool LetoVerifyModel(const mesh_t* mesh, const char* path);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Load a mesh onto the GPU from its container, see @ref
+ * MODEL_PATH. The file is mapped, its header checked, and its streams
+ * handed straight to OpenGL. The tangents and bounds computed at import
+ * are cached in the container and used as they are, so nothing is
+ * recomputed. A mesh whose container is missing, older than the mesh's
+ * file, or unreadable, like one written for another @ref MODEL_VERSION,
+ * is imported with @ref LetoLoadMesh first, which writes a fresh one. A
+ * GL context must be current.
+ *
+ * PARAMETERS
+ *
+ * @param name The file name of the mesh, like "cube.obj".
+ *
+ * RETURN VALUE
+ *
+ * @return The loaded model, to be freed with @ref LetoUnloadModel, or NULL
+ * if the container couldn't be mapped or is malformed even once
+ * rebuilt.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If the name is NULL, this warning is thrown and
+ * NULL is returned.
+ * @warning mesh_malformed -- If the header is invalid or any section falls
+ * outside the file, this warning is thrown and the container is rebuilt;
+ * if the rebuilt one is too, NULL is returned.
+ * @note For warnings unhandled by this function, see @ref LetoMapFile and
+ * @ref LetoLoadMesh.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+model_t* LetoLoadModel(const char* name);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Describe a vertex layout's attributes to a vertex array, reading
+ * them from one of its buffer bindings. The attributes take locations
+ * from 0 in the order of their fields, as the model shaders expect.
+ *
+ * PARAMETERS
+ *
+ * @param vertex_array The vertex array.
+ * @param format The layout of the vertices.
+ * @param binding The buffer binding the vertices are read from.
+ *
+ * RETURN VALUE
+ *
+ * @return The amount of attributes described, the next free location.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+unsigned int LetoDescribeModelVertices(unsigned int vertex_array,
+                                       model_vertex_format_t format,
+                                       unsigned int binding);
+
+/**
+ * @brief Get the size in bytes of a vertex of a layout.
+ */
+size_t LetoGetVertexStride(model_vertex_format_t format);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Set the uniforms a shader needs to draw a model. Quantized
+ * models have their positions decoded from the corners of their bounds,
+ * which are set as vec3 uniforms at @ref MODEL_MINIMUM_LOCATION and
+ * MODEL_MAXIMUM_LOCATION, as rss/shaders/quantized declares them;
+ * full-precision models need nothing. Uniforms are shadowed, so setting
+ * the same model again costs no GL call.
+ *
+ * PARAMETERS
+ *
+ * @param shader The shader the model is drawn with.
+ * @param model The model.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the shader or model is NULL, this warning is
+ * thrown and nothing is done.
+ * @note For warnings unhandled by this function, see @ref
+ * LetoSetUniformVec3At.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoBindModel(shader_t* shader, const model_t* model);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Pick the coarsest level of a model's LOD chain whose error, once
+ * projected onto the screen, stays within a threshold. An error of E
+ * object-space units at a distance D covers E * projection / D pixels.
+ *
+ * PARAMETERS
+ *
+ * @param model The model.
+ * @param distance The distance from the camera to the model's bounds,
+ * in the model's object-space units.
+ * @param projection The height of the viewport in pixels, divided by
+ * twice the tangent of half the vertical field of view.
+ * @param threshold The largest projected error to allow, in pixels, like
+ * @ref MODEL_LOD_THRESHOLD.
+ *
+ * RETURN VALUE
+ *
+ * @return The level to draw, 0 being full detail. Submesh S of the level
+ * is drawn from the run at level * submesh_count + S of @ref
+ * model_t::lods.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the model is NULL, this warning is thrown and
+ * 0 is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+size_t LetoSelectModelLOD(const model_t* model, float distance,
+                          float projection, float threshold);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Free a model's GPU buffers and everything else it owns.
+ *
+ * PARAMETERS
+ *
+ * @param model The model to free.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the model is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoUnloadModel(model_t* model);
+
+#endif // __LETO__MODELS__
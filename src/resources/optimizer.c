@@ -0,0 +1,729 @@
+/**
+ * @file Optimizer.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Optimizer.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "optimizer.h"        // Public interface parent
+#include <io/reporter.h>      // Error / warning reporter
+#include <stdlib.h>           // Qsort
+#include <string.h>           // Memset
+#include <utilities/memory.h> // Tracked allocations
+
+/**
+ * @brief The state shared by every pass over a mesh. The per-vertex
+ * arrays are sized for the whole mesh and reused for every submesh.
+ */
+typedef struct
+{
+    /**
+     * @brief The mesh's indices, widened to 32 bits.
+     */
+    uint32_t* indices;
+    const mesh_vertex_t* vertices;
+    /**
+     * @brief The triangles around each vertex: those of vertex v are
+     * adjacency[offsets[v]] up to adjacency[offsets[v + 1]].
+     */
+    uint32_t* offsets;
+    uint32_t* adjacency;
+    /**
+     * @brief The amount of triangles around each vertex that are yet to be
+     * emitted, counting only those of the submesh being optimized.
+     */
+    uint32_t* live;
+    /**
+     * @brief When each vertex last entered the simulated cache. A vertex
+     * is cached while fewer than @ref MESH_CACHE_SIZE vertices have
+     * entered since.
+     */
+    uint32_t* cache;
+    uint32_t time;
+    uint8_t* emitted;
+    /**
+     * @brief Tipsify's dead-end stack: every vertex of every emitted
+     * triangle, to fall back on once the current fan runs dry.
+     */
+    uint32_t* dead_ends;
+    size_t dead_end_count;
+} optimizer_t;
+
+/**
+ * @brief A cluster of triangles, for overdraw ordering.
+ */
+typedef struct
+{
+    /**
+     * @brief How far the cluster faces away from the submesh's center.
+     * Clusters are drawn in descending order of this.
+     */
+    float key;
+    uint32_t start;
+    uint32_t count;
+} cluster_t;
+
+/**
+ * @brief Empty the simulated cache.
+ */
+static inline void ResetCache_(optimizer_t* optimizer)
+{
+    optimizer->time += MESH_CACHE_SIZE + 1;
+}
+
+/**
+ * @brief Push a vertex through the simulated cache, returning whether or
+ * not it had to be shaded.
+ */
+static inline bool CacheMiss_(uint32_t* cache, uint32_t* time,
+                              uint32_t vertex, size_t cache_size)
+{
+    if (*time - cache[vertex] < cache_size) return false;
+    cache[vertex] = (*time)++;
+    return true;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Simulate drawing a triangle list through a FIFO vertex cache.
+ *
+ * PARAMETERS
+ *
+ * @param indices The triangle list.
+ * @param index_count The amount of indices.
+ * @param vertex_count The amount of vertices the indices refer to.
+ * @param cache_size The amount of vertices the cache holds.
+ * @param stats The storage for the results.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void AnalyzeIndices_(const uint32_t* indices, size_t index_count,
+                            size_t vertex_count, size_t cache_size,
+                            mesh_cache_stats_t* stats)
+{
+    *stats = (mesh_cache_stats_t){0};
+    if (index_count == 0 || vertex_count == 0) return;
+
+    uint32_t* cache =
+        LetoCalloc(memory_meshes, vertex_count, sizeof(uint32_t));
+    uint32_t time = (uint32_t)cache_size;
+    size_t misses = 0;
+    for (size_t i = 0; i < index_count; i++)
+        misses += CacheMiss_(cache, &time, indices[i], cache_size);
+    LetoFree(cache);
+
+    stats->acmr = (float)misses / (float)(index_count / 3);
+    stats->atvr = (float)misses / (float)vertex_count;
+}
+
+/**
+ * @brief Copy a mesh's indices out, widened to 32 bits.
+ */
+static uint32_t* ReadIndices_(const mesh_t* mesh)
+{
+    uint32_t* indices =
+        LetoMalloc(memory_meshes, mesh->index_count * sizeof(uint32_t));
+    if (mesh->index_size == sizeof(uint32_t))
+        (void)memcpy(indices, mesh->indices,
+                     mesh->index_count * sizeof(uint32_t));
+    else
+    {
+        const uint16_t* narrow = mesh->indices;
+        for (size_t i = 0; i < mesh->index_count; i++)
+            indices[i] = narrow[i];
+    }
+    return indices;
+}
+
+/**
+ * @brief Copy 32-bit indices back into a mesh, narrowing them if the
+ * mesh's indices are 16 bits wide.
+ */
+static void WriteIndices_(mesh_t* mesh, const uint32_t* indices)
+{
+    if (mesh->index_size == sizeof(uint32_t))
+    {
+        (void)memcpy(mesh->indices, indices,
+                     mesh->index_count * sizeof(uint32_t));
+        return;
+    }
+
+    uint16_t* narrow = mesh->indices;
+    for (size_t i = 0; i < mesh->index_count; i++)
+        narrow[i] = (uint16_t)indices[i];
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Build the vertex-to-triangle adjacency of a whole mesh, as a
+ * counting sort of its triangles by vertex.
+ *
+ * PARAMETERS
+ *
+ * @param optimizer The optimizer, whose indices are set.
+ * @param vertex_count The amount of vertices.
+ * @param triangle_count The amount of triangles.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void BuildAdjacency_(optimizer_t* optimizer, size_t vertex_count,
+                            size_t triangle_count)
+{
+    uint32_t* offsets = LetoCalloc(memory_meshes, vertex_count + 1,
+                                   sizeof(uint32_t));
+    uint32_t* adjacency = LetoMalloc(
+        memory_meshes, triangle_count * 3 * sizeof(uint32_t));
+
+    for (size_t i = 0; i < triangle_count * 3; i++)
+        offsets[optimizer->indices[i] + 1]++;
+    for (size_t i = 0; i < vertex_count; i++)
+        offsets[i + 1] += offsets[i];
+
+    // Each list's offset doubles as its cursor while filling, which leaves
+    // every offset at the end of its list; shift them back afterward.
+    for (size_t i = 0; i < triangle_count * 3; i++)
+        adjacency[offsets[optimizer->indices[i]]++] = (uint32_t)(i / 3);
+    for (size_t i = vertex_count; i > 0; i--) offsets[i] = offsets[i - 1];
+    offsets[0] = 0;
+
+    optimizer->offsets = offsets;
+    optimizer->adjacency = adjacency;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Pick the vertex to fan around next, out of those just emitted.
+ * Vertices are scored by how long ago they entered the cache, but only if
+ * fanning around them wouldn't push them out of it; otherwise any vertex
+ * that still has triangles will do. Failing that, we backtrack through
+ * the dead-end stack, and then scan for the next triangle not yet
+ * emitted.
+ *
+ * PARAMETERS
+ *
+ * @param optimizer The optimizer.
+ * @param candidates Where the vertices emitted by the last fan start on
+ * the dead-end stack.
+ * @param cursor The scan position, a triangle of the submesh.
+ * @param end The end of the submesh's triangles.
+ * @param dead_end The storage for whether or not the fan had to be
+ * abandoned for a vertex outside of it.
+ *
+ * RETURN VALUE
+ *
+ * @return The vertex, or -1 if every triangle has been emitted.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static int64_t NextVertex_(optimizer_t* optimizer, size_t candidates,
+                           size_t* cursor, size_t end, bool* dead_end)
+{
+    int64_t best = -1, best_score = -1;
+    for (size_t i = candidates; i < optimizer->dead_end_count; i++)
+    {
+        const uint32_t vertex = optimizer->dead_ends[i];
+        const uint32_t live = optimizer->live[vertex];
+        if (live == 0) continue;
+
+        const int64_t age = optimizer->time - optimizer->cache[vertex];
+        const int64_t score =
+            age + 2 * (int64_t)live <= MESH_CACHE_SIZE ? age : 0;
+        if (score > best_score)
+        {
+            best_score = score;
+            best = vertex;
+        }
+    }
+
+    *dead_end = best == -1;
+    if (best != -1) return best;
+
+    while (optimizer->dead_end_count > 0)
+    {
+        const uint32_t vertex =
+            optimizer->dead_ends[--optimizer->dead_end_count];
+        if (optimizer->live[vertex] > 0) return vertex;
+    }
+    for (; *cursor < end; (*cursor)++)
+        if (!optimizer->emitted[*cursor])
+            return optimizer->indices[*cursor * 3];
+    return -1;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Reorder the triangles of a submesh for the vertex cache with
+ * Tipsify: emit every remaining triangle around a vertex, then move on to
+ * the best vertex of that fan, see @ref NextVertex_.
+ *
+ * PARAMETERS
+ *
+ * @param optimizer The optimizer.
+ * @param first The first triangle of the submesh.
+ * @param count The amount of triangles in the submesh.
+ * @param order The storage for the submesh's triangles, in their new
+ * order.
+ * @param boundaries The storage for where each hard cluster starts within
+ * the new order: at the start, and wherever the fans hit a dead end.
+ *
+ * RETURN VALUE
+ *
+ * @return The amount of hard clusters.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static size_t Tipsify_(optimizer_t* optimizer, size_t first, size_t count,
+                       uint32_t* order, uint32_t* boundaries)
+{
+    const uint32_t* indices = optimizer->indices;
+    const size_t end = first + count;
+    for (size_t i = first * 3; i < end * 3; i++)
+        optimizer->live[indices[i]]++;
+
+    size_t emitted = 0, boundary_count = 0, cursor = first;
+    int64_t fan = indices[first * 3];
+    optimizer->dead_end_count = 0;
+    boundaries[boundary_count++] = 0;
+
+    while (fan >= 0)
+    {
+        const size_t candidates = optimizer->dead_end_count;
+        for (uint32_t i = optimizer->offsets[fan];
+             i < optimizer->offsets[fan + 1]; i++)
+        {
+            const uint32_t triangle = optimizer->adjacency[i];
+            if (triangle < first || triangle >= end ||
+                optimizer->emitted[triangle])
+                continue;
+
+            optimizer->emitted[triangle] = 1;
+            order[emitted++] = triangle;
+            for (size_t j = 0; j < 3; j++)
+            {
+                const uint32_t vertex = indices[triangle * 3 + j];
+                optimizer->dead_ends[optimizer->dead_end_count++] = vertex;
+                optimizer->live[vertex]--;
+                if (optimizer->time - optimizer->cache[vertex] >
+                    MESH_CACHE_SIZE)
+                    optimizer->cache[vertex] = optimizer->time++;
+            }
+        }
+
+        bool dead_end;
+        fan = NextVertex_(optimizer, candidates, &cursor, end, &dead_end);
+        if (fan >= 0 && dead_end) boundaries[boundary_count++] = emitted;
+    }
+
+    return boundary_count;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Split hard clusters further, wherever the triangles so far have
+ * already reached the cache efficiency of the whole cluster (within @ref
+ * MESH_OVERDRAW_THRESHOLD). Restarting the cache there costs little, and
+ * the smaller clusters can be sorted much more finely.
+ *
+ * PARAMETERS
+ *
+ * @param optimizer The optimizer.
+ * @param order The submesh's triangles, in cache order.
+ * @param count The amount of triangles.
+ * @param hard The starts of the hard clusters.
+ * @param hard_count The amount of hard clusters.
+ * @param clusters The storage for the starts of the soft clusters.
+ *
+ * RETURN VALUE
+ *
+ * @return The amount of soft clusters.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static size_t SplitClusters_(optimizer_t* optimizer, const uint32_t* order,
+                             size_t count, const uint32_t* hard,
+                             size_t hard_count, uint32_t* clusters)
+{
+    const uint32_t* indices = optimizer->indices;
+    size_t cluster_count = 0;
+
+    for (size_t i = 0; i < hard_count; i++)
+    {
+        const size_t start = hard[i],
+                     end = i + 1 < hard_count ? hard[i + 1] : count;
+
+        size_t misses = 0;
+        ResetCache_(optimizer);
+        for (size_t j = start * 3; j < end * 3; j++)
+            misses += CacheMiss_(optimizer->cache, &optimizer->time,
+                                 indices[order[j / 3] * 3 + j % 3],
+                                 MESH_CACHE_SIZE);
+        const float threshold =
+            MESH_OVERDRAW_THRESHOLD * (float)misses / (float)(end - start);
+
+        size_t running_misses = 0, running_count = 0;
+        ResetCache_(optimizer);
+        clusters[cluster_count++] = (uint32_t)start;
+        for (size_t j = start; j < end; j++)
+        {
+            for (size_t k = 0; k < 3; k++)
+                running_misses +=
+                    CacheMiss_(optimizer->cache, &optimizer->time,
+                               indices[order[j] * 3 + k], MESH_CACHE_SIZE);
+            running_count++;
+
+            if (j + 1 < end &&
+                (float)running_misses / (float)running_count <= threshold)
+            {
+                clusters[cluster_count++] = (uint32_t)(j + 1);
+                running_misses = running_count = 0;
+                ResetCache_(optimizer);
+            }
+        }
+    }
+
+    return cluster_count;
+}
+
+/**
+ * @brief Compare two clusters for @ref SortClusters_, by descending key
+ * and then by position.
+ */
+static int CompareClusters_(const void* a, const void* b)
+{
+    const cluster_t *first = a, *second = b;
+    if (first->key != second->key)
+        return first->key > second->key ? -1 : 1;
+    return first->start < second->start ? -1 : 1;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Sort the clusters of a submesh for overdraw. Each cluster is
+ * keyed by how far its area-weighted centroid lies along its average
+ * normal from the submesh's centroid; clusters on the outside of the
+ * shape, facing outward, are drawn first.
+ *
+ * PARAMETERS
+ *
+ * @param optimizer The optimizer.
+ * @param order The submesh's triangles, in cache order.
+ * @param count The amount of triangles.
+ * @param starts The starts of the clusters.
+ * @param cluster_count The amount of clusters.
+ * @param output The storage for the submesh's indices, in their final
+ * order.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void SortClusters_(const optimizer_t* optimizer,
+                          const uint32_t* order, size_t count,
+                          const uint32_t* starts, size_t cluster_count,
+                          uint32_t* output)
+{
+    const uint32_t* indices = optimizer->indices;
+    cluster_t* clusters =
+        LetoMalloc(memory_meshes, cluster_count * sizeof(cluster_t));
+    vec3* centroids =
+        LetoMalloc(memory_meshes, cluster_count * sizeof(vec3));
+    vec3* normals =
+        LetoMalloc(memory_meshes, cluster_count * sizeof(vec3));
+    vec3 center = {0.0f, 0.0f, 0.0f};
+    float total_area = 0.0f;
+
+    for (size_t i = 0; i < cluster_count; i++)
+    {
+        const size_t start = starts[i],
+                     end = i + 1 < cluster_count ? starts[i + 1] : count;
+        float area = 0.0f;
+        glm_vec3_zero(centroids[i]);
+        glm_vec3_zero(normals[i]);
+
+        for (size_t j = start; j < end; j++)
+        {
+            const uint32_t* triangle = &indices[order[j] * 3];
+            const float* a = optimizer->vertices[triangle[0]].position;
+            const float* b = optimizer->vertices[triangle[1]].position;
+            const float* c = optimizer->vertices[triangle[2]].position;
+
+            // The cross product is the normal scaled by twice the area,
+            // so summing it weights every normal by its triangle's area.
+            vec3 ab, ac, normal, centroid;
+            glm_vec3_sub((float*)b, (float*)a, ab);
+            glm_vec3_sub((float*)c, (float*)a, ac);
+            glm_vec3_cross(ab, ac, normal);
+            const float weight = glm_vec3_norm(normal);
+
+            glm_vec3_add((float*)a, (float*)b, centroid);
+            glm_vec3_add(centroid, (float*)c, centroid);
+            glm_vec3_muladds(centroid, weight / 3.0f, centroids[i]);
+            glm_vec3_add(normals[i], normal, normals[i]);
+            area += weight;
+        }
+
+        glm_vec3_add(center, centroids[i], center);
+        total_area += area;
+        if (area > 0.0f)
+            glm_vec3_scale(centroids[i], 1.0f / area, centroids[i]);
+        clusters[i] = (cluster_t){0.0f, (uint32_t)start,
+                                  (uint32_t)(end - start)};
+    }
+    if (total_area > 0.0f)
+        glm_vec3_scale(center, 1.0f / total_area, center);
+
+    for (size_t i = 0; i < cluster_count; i++)
+    {
+        vec3 offset;
+        glm_vec3_sub(centroids[i], center, offset);
+        glm_vec3_normalize(normals[i]);
+        clusters[i].key = glm_vec3_dot(offset, normals[i]);
+    }
+    qsort(clusters, cluster_count, sizeof(cluster_t), CompareClusters_);
+
+    for (size_t i = 0; i < cluster_count; i++)
+    {
+        for (size_t j = 0; j < clusters[i].count; j++)
+        {
+            const uint32_t* triangle =
+                &indices[order[clusters[i].start + j] * 3];
+            *output++ = triangle[0];
+            *output++ = triangle[1];
+            *output++ = triangle[2];
+        }
+    }
+
+    LetoFree(clusters);
+    LetoFree(centroids);
+    LetoFree(normals);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Renumber a mesh's vertices in the order its indices first use
+ * them, and move the vertices and any tangents to match.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh.
+ * @param indices The mesh's indices, widened to 32 bits. These are
+ * renumbered.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void ReorderVertices_(mesh_t* mesh, uint32_t* indices)
+{
+    uint32_t* remap =
+        LetoMalloc(memory_meshes, mesh->vertex_count * sizeof(uint32_t));
+    (void)memset(remap, 0xFF, mesh->vertex_count * sizeof(uint32_t));
+    mesh_vertex_t* vertices = LetoMalloc(
+        memory_meshes, mesh->vertex_count * sizeof(mesh_vertex_t));
+    vec4* tangents = NULL;
+    if (mesh->tangents != NULL)
+        tangents =
+            LetoMalloc(memory_meshes, mesh->vertex_count * sizeof(vec4));
+
+    uint32_t next = 0;
+    for (size_t i = 0; i < mesh->index_count; i++)
+    {
+        const uint32_t vertex = indices[i];
+        if (remap[vertex] == UINT32_MAX)
+        {
+            remap[vertex] = next;
+            vertices[next] = mesh->vertices[vertex];
+            if (tangents != NULL)
+                glm_vec4_copy(mesh->tangents[vertex], tangents[next]);
+            next++;
+        }
+        indices[i] = remap[vertex];
+    }
+
+    LetoFree(remap);
+    LetoFree(mesh->vertices);
+    LetoFree(mesh->tangents);
+    mesh->vertices = vertices;
+    mesh->tangents = tangents;
+    mesh->vertex_count = next;
+}
+
+void LetoAnalyzeVertexCache(const mesh_t* mesh, size_t cache_size,
+                            mesh_cache_stats_t* stats)
+{
+    if (mesh == NULL || stats == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    *stats = (mesh_cache_stats_t){0};
+    if (mesh->index_count == 0) return;
+
+    // Lower LOD levels are drawn instead of the full-detail one, never
+    // after it, so only the full-detail one is measured.
+    uint32_t* indices = ReadIndices_(mesh);
+    AnalyzeIndices_(indices, LetoGetDetailIndexCount(mesh),
+                    mesh->vertex_count, cache_size, stats);
+    LetoFree(indices);
+}
+
+void LetoOptimizeMesh(mesh_t* mesh, mesh_optimization_t* report)
+{
+    if (mesh == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+    if (report != NULL) *report = (mesh_optimization_t){0};
+    if (mesh->index_count == 0) return;
+
+    const size_t triangle_count = mesh->index_count / 3;
+    optimizer_t optimizer = {
+        .indices = ReadIndices_(mesh),
+        .vertices = mesh->vertices,
+        .live = LetoCalloc(memory_meshes, mesh->vertex_count,
+                           sizeof(uint32_t)),
+        .cache = LetoCalloc(memory_meshes, mesh->vertex_count,
+                            sizeof(uint32_t)),
+        .time = MESH_CACHE_SIZE + 1,
+        .emitted = LetoCalloc(memory_meshes, triangle_count, 1),
+        .dead_ends = LetoMalloc(memory_meshes,
+                                mesh->index_count * sizeof(uint32_t))};
+    BuildAdjacency_(&optimizer, mesh->vertex_count, triangle_count);
+    const size_t detail_count = LetoGetDetailIndexCount(mesh);
+    if (report != NULL)
+        AnalyzeIndices_(optimizer.indices, detail_count,
+                        mesh->vertex_count, MESH_CACHE_SIZE,
+                        &report->before);
+
+    // Anything outside of the submeshes keeps its order.
+    uint32_t* output =
+        LetoMalloc(memory_meshes, mesh->index_count * sizeof(uint32_t));
+    (void)memcpy(output, optimizer.indices,
+                 mesh->index_count * sizeof(uint32_t));
+    uint32_t* order =
+        LetoMalloc(memory_meshes, triangle_count * sizeof(uint32_t));
+    uint32_t* hard =
+        LetoMalloc(memory_meshes, triangle_count * sizeof(uint32_t));
+    uint32_t* soft =
+        LetoMalloc(memory_meshes, triangle_count * sizeof(uint32_t));
+
+    // A mesh without submeshes is optimized as a whole.
+    const mesh_submesh_t whole = {.index_count = mesh->index_count,
+                                  .material = MATERIAL_NONE};
+    const mesh_submesh_t* submeshes =
+        mesh->submesh_count != 0 ? mesh->submeshes : &whole;
+    const size_t submesh_count =
+        mesh->submesh_count != 0 ? mesh->submesh_count : 1;
+
+    for (size_t i = 0; i < submesh_count; i++)
+    {
+        const size_t first = submeshes[i].first_index / 3,
+                     count = submeshes[i].index_count / 3;
+        if (count == 0) continue;
+
+        const size_t hard_count =
+            Tipsify_(&optimizer, first, count, order, hard);
+        const size_t soft_count = SplitClusters_(&optimizer, order, count,
+                                                 hard, hard_count, soft);
+        SortClusters_(&optimizer, order, count, soft, soft_count,
+                      output + first * 3);
+    }
+
+    LetoFree(order);
+    LetoFree(hard);
+    LetoFree(soft);
+    LetoFree(optimizer.offsets);
+    LetoFree(optimizer.adjacency);
+    LetoFree(optimizer.live);
+    LetoFree(optimizer.cache);
+    LetoFree(optimizer.emitted);
+    LetoFree(optimizer.dead_ends);
+    LetoFree(optimizer.indices);
+
+    ReorderVertices_(mesh, output);
+    WriteIndices_(mesh, output);
+    if (report != NULL)
+        AnalyzeIndices_(output, detail_count, mesh->vertex_count,
+                        MESH_CACHE_SIZE, &report->after);
+    LetoFree(output);
+}
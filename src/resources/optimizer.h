@@ -0,0 +1,106 @@
+/**
+ * @file Optimizer.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the optimization passes run over every imported mesh.
+ * These only ever reorder triangles and vertices, so the mesh renders
+ * exactly as it did before, just with less vertex shading, overdraw and
+ * fetch bandwidth.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__OPTIMIZER__
+#define __LETO__OPTIMIZER__
+
+// Imported meshes.
+#include <resources/meshes.h>
+
+/**
+ * @brief The size of the FIFO post-transform vertex cache that meshes are
+ * optimized for and analyzed against. Modern GPUs don't have a FIFO
+ * cache, but their batching behaves close enough to a small one.
+ */
+#define MESH_CACHE_SIZE 16
+
+/**
+ * @brief How much worse than its hard cluster's cache efficiency a soft
+ * cluster may be, when splitting clusters for overdraw ordering. Smaller
+ * clusters sort better but cost more cache misses at their edges.
+ */
+#define MESH_OVERDRAW_THRESHOLD 1.05f
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Simulate drawing a mesh's full-detail level through a FIFO
+ * vertex cache.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh to analyze.
+ * @param cache_size The amount of vertices the cache holds.
+ * @param stats The storage for the results.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the mesh or stats are NULL, this warning is
+ * thrown and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoAnalyzeVertexCache(const mesh_t* mesh, size_t cache_size,
+                            mesh_cache_stats_t* stats);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Optimize a mesh for drawing, one submesh at a time. Triangles are
+ * first reordered for the vertex cache with Tipsify (Sander et al., "Fast
+ * Triangle Reordering for Vertex Locality and Reduced Overdraw"), whose
+ * dead ends split the submesh into clusters. Those are split further
+ * wherever the cache is already doing well, and then sorted so clusters
+ * facing away from the submesh's center draw first, as they're the ones
+ * most likely to occlude the rest from any direction. Finally, vertices
+ * are renumbered in the order they're first used, so fetches stream
+ * through the vertex buffer.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh to optimize.
+ * @param report The storage for the cache efficiency before and after, or
+ * NULL. Measuring it costs two extra passes over the indices.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the mesh is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoOptimizeMesh(mesh_t* mesh, mesh_optimization_t* report);
+
+#endif // __LETO__OPTIMIZER__
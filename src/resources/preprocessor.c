@@ -0,0 +1,347 @@
+/**
+ * @file Preprocessor.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Preprocessor.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "preprocessor.h"      // Public interface parent
+#include <ctype.h>             // Isalnum
+#include <io/files.h>          // File reading
+#include <io/reporter.h>       // Error / warning reporter
+#include <stdbool.h>           // Booleans
+#include <stdio.h>             // Snprintf
+#include <string.h>            // Memmove, strlen, strstr
+#include <utilities/macros.h>  // Path length
+#include <utilities/memory.h>  // Tracked allocations
+#include <utilities/strings.h> // String creation
+
+/**
+ * @brief The name each keyword is defined as, in bit order.
+ */
+static const char* const keyword_names[SHADER_KEYWORD_COUNT] = {
+    "SKINNED", "FOG", "INSTANCED"};
+
+/**
+ * @brief The state of a stage being preprocessed.
+ */
+typedef struct
+{
+    char* data;
+    size_t size;
+    size_t capacity;
+    /**
+     * @brief The name of each file included so far. A file's source
+     * string number is its index here plus one.
+     */
+    char* includes[SHADER_MAX_INCLUDES];
+    size_t include_count;
+    uint32_t permutation;
+    /**
+     * @brief Where in the output the keyword defines go, once the whole
+     * stage has been expanded.
+     */
+    size_t keyword_offset;
+} preprocessor_t;
+
+/**
+ * @brief Append text to the output, keeping it NUL-terminated.
+ */
+static void Append_(preprocessor_t* state, const char* text, size_t length)
+{
+    if (state->size + length + 1 > state->capacity)
+    {
+        size_t capacity = state->capacity == 0 ? 1024 : state->capacity;
+        while (state->size + length + 1 > capacity) capacity *= 2;
+        state->data = state->data == NULL
+                          ? LetoMalloc(memory_shaders, capacity)
+                          : LetoRealloc(state->data, capacity);
+        state->capacity = capacity;
+    }
+
+    (void)memcpy(state->data + state->size, text, length);
+    state->size += length;
+    state->data[state->size] = 0;
+}
+
+/**
+ * @brief Append a #line directive, on a line of its own.
+ */
+static void AppendLine_(preprocessor_t* state, size_t line,
+                        size_t source_number)
+{
+    if (state->size > 0 && state->data[state->size - 1] != '\n')
+        Append_(state, "\n", 1);
+
+    char directive[64];
+    const int length = snprintf(directive, sizeof(directive),
+                                "#line %zu %zu\n", line, source_number);
+    Append_(state, directive, (size_t)length);
+}
+
+/**
+ * @brief Check whether a character can be part of an identifier.
+ */
+static bool Identifier_(char character)
+{
+    return isalnum((unsigned char)character) || character == '_';
+}
+
+/**
+ * @brief Check whether text mentions a keyword as a whole identifier.
+ */
+static bool Mentions_(const char* text, const char* keyword)
+{
+    const size_t length = strlen(keyword);
+    for (const char* found = strstr(text, keyword); found != NULL;
+         found = strstr(found + 1, keyword))
+    {
+        const bool starts = found == text || !Identifier_(found[-1]);
+        if (starts && !Identifier_(found[length])) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Insert a #define for each keyword of the permutation that the
+ * expanded stage mentions. Keywords a stage never mentions can't change
+ * it, and leaving them out means every permutation differing only in
+ * those preprocesses the stage to the same text.
+ */
+static void InsertKeywords_(preprocessor_t* state)
+{
+    for (size_t i = 0; i < SHADER_KEYWORD_COUNT; i++)
+    {
+        if (!(state->permutation & (1u << i)) ||
+            !Mentions_(state->data, keyword_names[i]))
+            continue;
+
+        char define[64];
+        const size_t length = (size_t)snprintf(
+            define, sizeof(define), "#define %s 1\n", keyword_names[i]);
+        // Appending first makes the room; the define is then moved to
+        // where it belongs.
+        const size_t moved = state->size - state->keyword_offset;
+        Append_(state, define, length);
+        char* at = state->data + state->keyword_offset;
+        (void)memmove(at + length, at, moved);
+        (void)memcpy(at, define, length);
+        state->keyword_offset += length;
+    }
+}
+
+/**
+ * @brief Check whether a line is the given directive, returning the text
+ * after it or NULL if it isn't.
+ */
+static const char* MatchDirective_(const char* line, const char* directive)
+{
+    while (*line == ' ' || *line == '\t') line++;
+    const size_t length = strlen(directive);
+    if (strncmp(line, directive, length) != 0) return NULL;
+    return line + length;
+}
+
+/**
+ * @brief Find the start of the line holding the #version directive, or
+ * NULL if the source has none.
+ */
+static const char* FindVersion_(const char* source)
+{
+    for (const char* line = source; line != NULL;)
+    {
+        if (MatchDirective_(line, "#version") != NULL) return line;
+        line = strchr(line, '\n');
+        if (line != NULL) line++;
+    }
+    return NULL;
+}
+
+static bool Expand_(preprocessor_t* state, const char* source,
+                    size_t source_number, size_t depth);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Replace an #include line with the contents of the file it
+ * names, unless the stage already included that file.
+ *
+ * PARAMETERS
+ *
+ * @param state The stage being preprocessed.
+ * @param arguments The text of the line after "#include".
+ * @param depth How deeply the file is nested.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the include could be resolved.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning file_read -- If the directive is malformed, the file doesn't
+ * exist, includes nest too deeply, or the stage has included too many
+ * files, this warning is thrown and false is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool Include_(preprocessor_t* state, const char* arguments,
+                     size_t depth)
+{
+    while (*arguments == ' ' || *arguments == '\t') arguments++;
+    const char* end =
+        *arguments == '"' ? strchr(arguments + 1, '"') : NULL;
+    const char* newline = strchr(arguments, '\n');
+    if (end == NULL || (newline != NULL && end > newline) ||
+        end == arguments + 1 || depth >= SHADER_MAX_INCLUDE_DEPTH)
+    {
+        LetoReport(file_read);
+        return false;
+    }
+
+    const int length = (int)(end - arguments - 1);
+    char* name =
+        LetoStringCreate(MAX_PATH_LENGTH, "%.*s", length, arguments + 1);
+    for (size_t i = 0; i < state->include_count; i++)
+    {
+        if (strcmp(state->includes[i], name) != 0) continue;
+        LetoStringFree(&name);
+        return true;
+    }
+
+    char* path =
+        LetoStringCreate(MAX_PATH_LENGTH, SHADER_INCLUDE_DIR "/%s", name);
+    if (state->include_count == SHADER_MAX_INCLUDES ||
+        !LetoFileExists(path))
+    {
+        LetoReport(file_read);
+        LetoStringFree(&path);
+        LetoStringFree(&name);
+        return false;
+    }
+
+    state->includes[state->include_count++] = name;
+    char* contents = (char*)LetoReadFilePV(true, "%s", path);
+    LetoStringFree(&path);
+
+    const size_t source_number = state->include_count;
+    AppendLine_(state, 1, source_number);
+    const bool expanded =
+        Expand_(state, contents, source_number, depth + 1);
+    LetoFree(contents);
+    return expanded;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Copy a source to the output line by line, resolving its
+ * includes. The top-level stage also marks where the permutation's
+ * keywords go: after its #version line if it has one, and at the very
+ * top otherwise.
+ *
+ * PARAMETERS
+ *
+ * @param state The stage being preprocessed.
+ * @param source The source to copy.
+ * @param source_number The source string number of the source.
+ * @param depth How deeply the source is nested, 0 for the stage itself.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not every include could be resolved.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ * @note For warnings unhandled by this function, see @ref Include_.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool Expand_(preprocessor_t* state, const char* source,
+                    size_t source_number, size_t depth)
+{
+    const char* version = depth == 0 ? FindVersion_(source) : NULL;
+    if (depth == 0 && version == NULL)
+    {
+        state->keyword_offset = state->size;
+        AppendLine_(state, 1, 0);
+    }
+
+    size_t line = 1;
+    for (const char* cursor = source; *cursor != 0; line++)
+    {
+        const char* newline = strchr(cursor, '\n');
+        const size_t length =
+            newline != NULL ? (size_t)(newline - cursor) + 1
+                            : strlen(cursor);
+
+        const char* arguments = MatchDirective_(cursor, "#include");
+        if (arguments != NULL)
+        {
+            const size_t size = state->size;
+            if (!Include_(state, arguments, depth)) return false;
+            // Skipped includes leave a blank line rather than a
+            // directive, keeping the output a little smaller.
+            if (state->size == size) Append_(state, "\n", 1);
+            else AppendLine_(state, line + 1, source_number);
+        }
+        else Append_(state, cursor, length);
+
+        if (cursor == version)
+        {
+            if (newline == NULL) Append_(state, "\n", 1);
+            state->keyword_offset = state->size;
+            AppendLine_(state, line + 1, source_number);
+        }
+        cursor += length;
+    }
+    return true;
+}
+
+char* LetoPreprocessShader(const char* source, uint32_t permutation)
+{
+    if (source == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+
+    const uint32_t known = (1u << SHADER_KEYWORD_COUNT) - 1;
+    if (permutation & ~known)
+    {
+        LetoReport(invalid_param);
+        permutation &= known;
+    }
+
+    preprocessor_t state = {.permutation = permutation};
+    // Empty sources still hand back an empty string.
+    Append_(&state, "", 0);
+    const bool expanded = Expand_(&state, source, 0, 0);
+    if (expanded) InsertKeywords_(&state);
+
+    for (size_t i = 0; i < state.include_count; i++)
+        LetoStringFree(&state.includes[i]);
+    if (!expanded)
+    {
+        LetoFree(state.data);
+        return NULL;
+    }
+    return state.data;
+}
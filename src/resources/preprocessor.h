@@ -0,0 +1,106 @@
+/**
+ * @file Preprocessor.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides Leto's shader preprocessor, which runs over every stage
+ * before it reaches the driver. It pulls in #include files from the
+ * shared shader library and defines the keywords of whichever
+ * permutation of the shader is being built.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__PREPROCESSOR__
+#define __LETO__PREPROCESSOR__
+
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+
+/**
+ * @brief The shared library that #include "file" directives are resolved
+ * against.
+ */
+#define SHADER_INCLUDE_DIR ASSET_DIR "/shaders/include"
+
+/**
+ * @brief How deeply includes may nest before the preprocessor gives up,
+ * which also stops include cycles.
+ */
+#define SHADER_MAX_INCLUDE_DEPTH 16
+
+/**
+ * @brief The most distinct files a single stage may include.
+ */
+#define SHADER_MAX_INCLUDES 32
+
+/**
+ * @brief The keywords a shader can be built with. A permutation is any
+ * bitwise OR of these; each set keyword is defined to 1 at the top of
+ * every stage that mentions it, so sources can pick features with
+ * #ifdef. Stages loaded from SPIR-V get keywords as specialization
+ * constants instead, so sources built both ways should include
+ * "keywords.glsl" and branch on its booleans.
+ */
+typedef enum
+{
+    shader_skinned = 1u << 0,
+    shader_fog = 1u << 1,
+    shader_instanced = 1u << 2,
+} shader_keyword_t;
+
+/**
+ * @brief The amount of keywords in @ref shader_keyword_t.
+ */
+#define SHADER_KEYWORD_COUNT 3
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Preprocess a stage's source. The keyword defines of the
+ * permutation go in straight after the #version line, which GLSL needs
+ * to come first, though only for keywords the stage or its includes
+ * mention; a stage that ignores a keyword comes out the same with or
+ * without it, so that its separable program can be shared. Every
+ * #include "file" line is replaced by the contents of that file from
+ * @ref SHADER_INCLUDE_DIR, itself preprocessed. A file is only included
+ * once per stage, however often it's asked for. #line directives are
+ * placed so that driver errors still name the right line; the stage
+ * itself is source string 0, and each included file is numbered from 1
+ * in the order it was first included.
+ *
+ * PARAMETERS
+ *
+ * @param source The NUL-terminated source of the stage.
+ * @param permutation The keywords to define.
+ *
+ * RETURN VALUE
+ *
+ * @return The preprocessed source, to be freed with @ref LetoFree, or
+ * NULL if it couldn't be preprocessed.
+ *
+ * WARNINGS
+ *
+ * Three warnings can be thrown by this function.
+ * @warning null_param -- If the source is NULL, this warning is thrown
+ * and NULL is returned.
+ * @warning invalid_param -- If the permutation has bits set beyond the
+ * known keywords, this warning is thrown and those bits are ignored.
+ * @warning file_read -- If an included file doesn't exist, includes nest
+ * too deeply, or a stage includes too many files, this warning is thrown
+ * and NULL is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+char* LetoPreprocessShader(const char* source, uint32_t permutation);
+
+#endif // __LETO__PREPROCESSOR__
@@ -0,0 +1,312 @@
+/**
+ * @file Reflection.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Reflection.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "reflection.h"        // Public interface parent
+#include <gl.h>                // OpenGL function pointers
+#include <io/reporter.h>       // Error / warning reporter
+#include <stdlib.h>            // Qsort, bsearch
+#include <string.h>            // Strlen, strcmp
+#include <utilities/memory.h>  // Tracked allocations
+#include <utilities/strings.h> // String interning
+
+/**
+ * @brief The program interface each kind of resource is read from.
+ */
+static const GLenum interfaces[resource_kind_count] = {
+    GL_UNIFORM, GL_UNIFORM_BLOCK, GL_SHADER_STORAGE_BLOCK,
+    GL_PROGRAM_INPUT};
+
+/**
+ * @brief Order resources by the address of their id.
+ */
+static int CompareResources_(const void* a, const void* b)
+{
+    const uintptr_t first = (uintptr_t)((const shader_resource_t*)a)->id;
+    const uintptr_t second = (uintptr_t)((const shader_resource_t*)b)->id;
+    return (first > second) - (first < second);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Read the name of a resource and intern it, dropping the "[0]"
+ * the driver gives the name of an array.
+ *
+ * PARAMETERS
+ *
+ * @param program The program.
+ * @param interface The program interface of the resource.
+ * @param index The index of the resource within the interface.
+ * @param length The length of the name, including its terminator.
+ *
+ * RETURN VALUE
+ *
+ * @return The resource's id.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static resource_id_t ReadName_(GLuint program, GLenum interface,
+                               GLuint index, GLint length)
+{
+    char* name = LetoMalloc(memory_strings, (size_t)length + 1);
+    GLsizei written = 0;
+    glGetProgramResourceName(program, interface, index, length + 1,
+                             &written, name);
+    if (written > 3 && strcmp(name + written - 3, "[0]") == 0)
+        written -= 3;
+
+    resource_id_t id = LetoStringIntern(name, (size_t)written);
+    LetoFree(name);
+    return id;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Read a single resource out of the driver.
+ *
+ * PARAMETERS
+ *
+ * @param program The program.
+ * @param kind The kind of resource.
+ * @param index The index of the resource within its interface.
+ * @param resource The storage for the resource.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the resource should be kept. Built-in inputs
+ * aren't.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning unnamed_resource -- If a uniform has no name, this warning is
+ * thrown and the uniform is kept anyway.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool ReadResource_(GLuint program, resource_kind_t kind,
+                          GLuint index, shader_resource_t* resource)
+{
+    const GLenum interface = interfaces[kind];
+    *resource = (shader_resource_t){.location = -1, .size = 1,
+                                    .block = -1};
+
+    if (kind == resource_uniform_block || kind == resource_storage_block)
+    {
+        const GLenum properties[] = {GL_NAME_LENGTH, GL_BUFFER_BINDING,
+                                     GL_BUFFER_DATA_SIZE};
+        GLint values[3];
+        glGetProgramResourceiv(program, interface, index, 3, properties, 3,
+                               NULL, values);
+        resource->id = ReadName_(program, interface, index, values[0]);
+        resource->location = values[1];
+        resource->size = values[2];
+        return true;
+    }
+
+    if (kind == resource_attribute)
+    {
+        const GLenum properties[] = {GL_NAME_LENGTH, GL_TYPE, GL_LOCATION,
+                                     GL_ARRAY_SIZE};
+        GLint values[4];
+        glGetProgramResourceiv(program, interface, index, 4, properties, 4,
+                               NULL, values);
+        // Built-ins are the only inputs without a location.
+        if (values[2] == -1) return false;
+        resource->id = ReadName_(program, interface, index, values[0]);
+        resource->type = (uint32_t)values[1];
+        resource->location = values[2];
+        resource->size = values[3];
+        return true;
+    }
+
+    const GLenum properties[] = {GL_NAME_LENGTH, GL_TYPE,
+                                 GL_LOCATION,    GL_ARRAY_SIZE,
+                                 GL_BLOCK_INDEX, GL_OFFSET};
+    GLint values[6];
+    glGetProgramResourceiv(program, interface, index, 6, properties, 6,
+                           NULL, values);
+    resource->id = ReadName_(program, interface, index, values[0]);
+    // SPIR-V programs may drop names, which leaves the uniform settable
+    // only by its location.
+    if (*resource->id == '\0') LetoReport(unnamed_resource);
+    resource->type = (uint32_t)values[1];
+    resource->location = values[2];
+    resource->size = values[3];
+    resource->block = values[4];
+    if (values[4] != -1) resource->offset = (uint32_t)values[5];
+    return true;
+}
+
+uint32_t LetoUniformSize(uint32_t type)
+{
+    switch (type)
+    {
+        case GL_FLOAT:
+        case GL_INT:
+        case GL_UNSIGNED_INT:
+        case GL_BOOL:
+        case GL_SAMPLER_1D:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_3D:
+        case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_2D_SHADOW:
+        case GL_SAMPLER_2D_ARRAY:
+        case GL_SAMPLER_2D_ARRAY_SHADOW:
+        case GL_SAMPLER_CUBE_SHADOW:
+        case GL_SAMPLER_2D_MULTISAMPLE:
+        case GL_SAMPLER_BUFFER:
+        case GL_INT_SAMPLER_2D:
+        case GL_UNSIGNED_INT_SAMPLER_2D:
+        case GL_IMAGE_2D:
+        case GL_IMAGE_3D:
+        case GL_IMAGE_2D_ARRAY:          return 4;
+        case GL_FLOAT_VEC2:
+        case GL_INT_VEC2:
+        case GL_UNSIGNED_INT_VEC2:
+        case GL_BOOL_VEC2:               return 8;
+        case GL_FLOAT_VEC3:
+        case GL_INT_VEC3:
+        case GL_UNSIGNED_INT_VEC3:
+        case GL_BOOL_VEC3:               return 12;
+        case GL_FLOAT_VEC4:
+        case GL_INT_VEC4:
+        case GL_UNSIGNED_INT_VEC4:
+        case GL_BOOL_VEC4:
+        case GL_FLOAT_MAT2:              return 16;
+        case GL_FLOAT_MAT3:              return 36;
+        case GL_FLOAT_MAT4:              return 64;
+        default:                         return 0;
+    }
+}
+
+resource_id_t LetoResourceId(const char* name)
+{
+    if (name == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+    return LetoStringIntern(name, strlen(name));
+}
+
+void LetoReflectProgram(unsigned int program,
+                        shader_reflection_t* reflection)
+{
+    if (reflection == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+    *reflection = (shader_reflection_t){0};
+
+    for (size_t kind = 0; kind < resource_kind_count; kind++)
+    {
+        GLint count = 0;
+        glGetProgramInterfaceiv(program, interfaces[kind],
+                                GL_ACTIVE_RESOURCES, &count);
+        if (count <= 0) continue;
+
+        shader_resource_t* resources = LetoMalloc(
+            memory_shaders, (size_t)count * sizeof(shader_resource_t));
+        size_t kept = 0;
+        for (GLint i = 0; i < count; i++)
+            kept += ReadResource_(program, (resource_kind_t)kind,
+                                  (GLuint)i, &resources[kept]);
+
+        qsort(resources, kept, sizeof(shader_resource_t),
+              CompareResources_);
+        reflection->resources[kind] = resources;
+        reflection->counts[kind] = kept;
+    }
+
+    // Default block uniforms each get room for their last value.
+    for (size_t i = 0; i < reflection->counts[resource_uniform]; i++)
+    {
+        shader_resource_t* uniform =
+            &reflection->resources[resource_uniform][i];
+        if (uniform->location == -1) continue;
+        uniform->offset = (uint32_t)reflection->shadow_size;
+        reflection->shadow_size +=
+            (size_t)LetoUniformSize(uniform->type) * (size_t)uniform->size;
+    }
+    if (reflection->shadow_size > 0)
+        reflection->shadow =
+            LetoMalloc(memory_shaders, reflection->shadow_size);
+}
+
+void LetoFreeReflection(shader_reflection_t* reflection)
+{
+    if (reflection == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    for (size_t kind = 0; kind < resource_kind_count; kind++)
+        LetoFree(reflection->resources[kind]);
+    LetoFree(reflection->shadow);
+    *reflection = (shader_reflection_t){0};
+}
+
+shader_resource_t*
+LetoFindResource(const shader_reflection_t* reflection,
+                 resource_kind_t kind, resource_id_t id)
+{
+    if (reflection == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+    if (kind >= resource_kind_count || reflection->counts[kind] == 0)
+        return NULL;
+
+    const shader_resource_t key = {.id = id};
+    return bsearch(&key, reflection->resources[kind],
+                   reflection->counts[kind], sizeof(shader_resource_t),
+                   CompareResources_);
+}
+
+shader_resource_t*
+LetoFindUniformAt(const shader_reflection_t* reflection, int32_t location)
+{
+    if (reflection == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+    if (location == -1) return NULL;
+
+    for (size_t i = 0; i < reflection->counts[resource_uniform]; i++)
+    {
+        shader_resource_t* uniform =
+            &reflection->resources[resource_uniform][i];
+        if (uniform->location == location) return uniform;
+    }
+    return NULL;
+}
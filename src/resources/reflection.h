@@ -0,0 +1,224 @@
+/**
+ * @file Reflection.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the reflection of linked shader programs. Every
+ * uniform, uniform block, shader storage block and vertex input of a
+ * program is read out of the driver once, right after linking, so that
+ * nothing needs to ask the driver for a location by name afterward.
+ * Resources are looked up by id, an interned name that's worked out once
+ * ahead of time rather than on every use.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__REFLECTION__
+#define __LETO__REFLECTION__
+
+// The boolean type as described by the C standard.
+#include <stdbool.h>
+// Standard macro definitions, like size_t.
+#include <stddef.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+
+/**
+ * @brief The id of a shader resource, which is its name interned with
+ * @ref LetoStringIntern. Ids of the same name are equal across every
+ * shader, so one id can be made at startup and used with any of them.
+ */
+typedef const char* resource_id_t;
+
+/**
+ * @brief The kinds of resource a program is reflected for.
+ */
+typedef enum
+{
+    resource_uniform,
+    resource_uniform_block,
+    resource_storage_block,
+    resource_attribute,
+    /**
+     * @defgroup Resource kind counter.
+     */
+    resource_kind_count,
+} resource_kind_t;
+
+/**
+ * @brief A single reflected resource of a program.
+ */
+typedef struct
+{
+    /**
+     * @brief The resource's name without any trailing "[0]", interned.
+     */
+    resource_id_t id;
+    /**
+     * @brief The GL type of a uniform or attribute, like GL_FLOAT_VEC3.
+     * Blocks have none.
+     */
+    uint32_t type;
+    /**
+     * @brief The location of a uniform or attribute, or the binding point
+     * of a block. Uniforms that live within a block have no location, and
+     * this is -1.
+     */
+    int32_t location;
+    /**
+     * @brief The amount of elements of an array uniform or attribute, 1
+     * otherwise. For blocks, this is the size of the block's data in
+     * bytes.
+     */
+    int32_t size;
+    /**
+     * @brief The driver's index of the uniform block a uniform lives
+     * within, or -1 if it's in the default block.
+     */
+    int32_t block;
+    /**
+     * @brief The offset of a block uniform within its block, or of a
+     * default block uniform's shadowed value within @ref
+     * shader_reflection_t.shadow.
+     */
+    uint32_t offset;
+    /**
+     * @brief Whether or not a default block uniform's shadowed value holds
+     * what was last uploaded. Uniforms that have never been set aren't
+     * shadowed, as the driver knows their values and Leto doesn't.
+     */
+    bool shadowed;
+} shader_resource_t;
+
+/**
+ * @brief Everything reflected from a program. Each kind of resource is
+ * sorted by id, so finding one is a binary search.
+ */
+typedef struct
+{
+    shader_resource_t* resources[resource_kind_count];
+    size_t counts[resource_kind_count];
+    /**
+     * @brief The value of every default block uniform as last uploaded,
+     * so uploads of the same value can be skipped.
+     */
+    uint8_t* shadow;
+    size_t shadow_size;
+} shader_reflection_t;
+
+/**
+ * @brief Get the size of a single element of a uniform type in bytes, or
+ * 0 for types Leto can't set. Samplers and images are set like ints.
+ */
+uint32_t LetoUniformSize(uint32_t type);
+
+/**
+ * @brief Get the id of a resource name. This interns the name, so it's
+ * best done once, ahead of time.
+ */
+resource_id_t LetoResourceId(const char* name);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Reflect every uniform, uniform block, shader storage block and
+ * vertex input of a linked program. Built-in inputs, like gl_VertexID,
+ * are left out. A GL context must be current.
+ *
+ * PARAMETERS
+ *
+ * @param program The linked program.
+ * @param reflection The storage for the reflection, to be freed with
+ * @ref LetoFreeReflection.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the reflection storage is NULL, this warning
+ * is thrown and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoReflectProgram(unsigned int program,
+                        shader_reflection_t* reflection);
+
+/**
+ * @brief Free everything a reflection holds, leaving it empty.
+ */
+void LetoFreeReflection(shader_reflection_t* reflection);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Find a reflected resource by its id.
+ *
+ * PARAMETERS
+ *
+ * @param reflection The reflection to search.
+ * @param kind The kind of resource.
+ * @param id The resource's id.
+ *
+ * RETURN VALUE
+ *
+ * @return The resource, or NULL if the program has no such resource.
+ * Resources the driver found unused and optimized away don't exist.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the reflection is NULL, this warning is
+ * thrown and NULL is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+shader_resource_t*
+LetoFindResource(const shader_reflection_t* reflection,
+                 resource_kind_t kind, resource_id_t id);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Find a default block uniform by its location. This is a linear
+ * search, meant for uniforms whose names can't be relied on, like those
+ * of SPIR-V programs, which are given explicit locations instead.
+ *
+ * PARAMETERS
+ *
+ * @param reflection The reflection to search.
+ * @param location The uniform's location.
+ *
+ * RETURN VALUE
+ *
+ * @return The uniform, or NULL if the program has none at the location.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the reflection is NULL, this warning is
+ * thrown and NULL is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+shader_resource_t*
+LetoFindUniformAt(const shader_reflection_t* reflection, int32_t location);
+
+#endif // __LETO__REFLECTION__
@@ -15,13 +15,129 @@
  * distribution of the Leto source code.
  */
 
-#include "shaders.h"           // Public interface parent
-#include <gl.h>                // OpenGL function pointers
-#include <io/files.h>          // File utilities
-#include <io/reporter.h>       // Error and warning reporter
-#include <stdio.h>             // Standard I/O functionality
-#include <stdlib.h>            // Malloc / free
-#include <utilities/strings.h> // String utilities
+#include "shaders.h"                // Public interface parent
+#include <diagnostic/time.h>        // Build timing
+#include <gl.h>                     // OpenGL function pointers
+#include <glfw3.h>                  // Extension loading
+#include <interface/state.h>        // OpenGL state shadow
+#include <io/files.h>               // File utilities
+#include <io/reporter.h>            // Error and warning reporter
+#include <resources/binaries.h>     // Program binary cache
+#include <resources/preprocessor.h> // Includes and permutations
+#include <resources/spirv.h>        // Precompiled stages
+#include <resources/statistics.h>   // Build statistics
+#include <stdio.h>                  // Standard I/O functionality
+#include <string.h>                 // Strcmp
+#include <utilities/macros.h>       // Path length
+#include <utilities/memory.h>       // Tracked allocations
+#include <utilities/pools.h>        // Object pools
+#include <utilities/strings.h>      // String utilities
+
+// GL_KHR_parallel_shader_compile isn't in the generated loader, so its
+// enums and entry point are declared here and loaded by hand. The ARB
+// version shares every value.
+#if !defined(GL_KHR_parallel_shader_compile)
+    #define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+    #define GL_COMPLETION_STATUS_KHR 0x91B1
+typedef void(GLAD_API_PTR* PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(
+    GLuint count);
+#endif
+
+/**
+ * @brief The amount of compiler threads asked for when parallel
+ * compilation is available. This value lets the driver decide.
+ */
+#define SHADER_COMPILER_THREADS 0xFFFFFFFFu
+
+/**
+ * @brief The smallest amount of slots the shader registry has, once it
+ * has any. This is always a power of two.
+ */
+#define SHADER_REGISTRY_MINIMUM 16
+
+/**
+ * @brief A slot of the shader registry, an open-addressed hash table of
+ * every loaded shader keyed on its interned name and permutation.
+ */
+typedef struct
+{
+    /**
+     * @brief The interned name of the shader, or NULL if the slot is
+     * empty. Interned names are compared by pointer.
+     */
+    const char* name;
+    uint32_t permutation;
+    pool_handle_t handle;
+} shader_slot_t;
+
+/**
+ * @brief The pool every shader node is allocated from. This is created on
+ * the first load and lives until @ref LetoFreeShaderRegistry, so no
+ * handle is ever handed out twice.
+ */
+static pool_t* shader_pool = NULL;
+
+/**
+ * @brief The stage file names a shader's folder is searched for, the
+ * stage each makes and its bit within a program pipeline, in the order
+ * they're kept in a batch.
+ */
+static const struct
+{
+    const char* file;
+    GLenum type;
+    GLbitfield bit;
+} stage_files[SHADER_MAX_STAGES] = {
+    {"vert.vs", GL_VERTEX_SHADER, GL_VERTEX_SHADER_BIT},
+    {"tesc.tcs", GL_TESS_CONTROL_SHADER, GL_TESS_CONTROL_SHADER_BIT},
+    {"tese.tes", GL_TESS_EVALUATION_SHADER, GL_TESS_EVALUATION_SHADER_BIT},
+    {"geom.gs", GL_GEOMETRY_SHADER, GL_GEOMETRY_SHADER_BIT},
+    {"frag.fs", GL_FRAGMENT_SHADER, GL_FRAGMENT_SHADER_BIT},
+    {"comp.cs", GL_COMPUTE_SHADER, GL_COMPUTE_SHADER_BIT}};
+
+/**
+ * @brief The slots of the shader registry, which grows whenever it gets
+ * three quarters full.
+ */
+static shader_slot_t* registry = NULL;
+
+/**
+ * @brief The amount of slots in @ref registry, a power of two.
+ */
+static size_t registry_capacity = 0;
+
+/**
+ * @brief The amount of occupied slots in @ref registry.
+ */
+static size_t registry_count = 0;
+
+/**
+ * @brief Every separable stage in use. Stages are only looked up while
+ * shaders are submitted, so a plain list does.
+ */
+static shader_stage_t** stage_list = NULL;
+
+/**
+ * @brief The amount of stages in @ref stage_list.
+ */
+static size_t stage_count = 0;
+
+/**
+ * @brief The amount of stages @ref stage_list has room for.
+ */
+static size_t stage_capacity = 0;
+
+/**
+ * @brief Whether or not the driver's support for parallel compilation
+ * has been looked for yet.
+ */
+static bool parallel_checked = false;
+
+/**
+ * @brief Whether or not the driver compiles in the background, so that
+ * programs can be polled for completion without blocking.
+ */
+static bool parallel_compile = false;
 
 /**
  * DESCRIPTION
@@ -117,45 +233,729 @@ static void CheckShaderLinkage_(const unsigned int shader)
     }
 }
 
-shader_t* LetoLoadShader(const char* name)
+/**
+ * DESCRIPTION
+ *
+ * @brief Turn on GL_KHR_parallel_shader_compile (or its ARB twin) if the
+ * driver has it, letting the driver pick its own amount of compiler
+ * threads. This is only checked once, the first time it's needed.
+ *
+ * PARAMETERS
+ *
+ * Nothing of note.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void EnableParallelCompile_(void)
 {
-    if (name == NULL)
+    if (parallel_checked) return;
+    parallel_checked = true;
+
+    const struct
+    {
+        const char* extension;
+        const char* function;
+    } variants[] = {{"GL_KHR_parallel_shader_compile",
+                     "glMaxShaderCompilerThreadsKHR"},
+                    {"GL_ARB_parallel_shader_compile",
+                     "glMaxShaderCompilerThreadsARB"}};
+
+    for (size_t i = 0; i < sizeof(variants) / sizeof(variants[0]); i++)
+    {
+        if (!glfwExtensionSupported(variants[i].extension)) continue;
+        PFNGLMAXSHADERCOMPILERTHREADSKHRPROC set_threads =
+            (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)glfwGetProcAddress(
+                variants[i].function);
+        if (set_threads == NULL) continue;
+
+        set_threads(SHADER_COMPILER_THREADS);
+        parallel_compile = true;
+        return;
+    }
+}
+
+/**
+ * @brief Get the home slot of an interned name and permutation. The
+ * name's address is as good a key as its contents, and far cheaper.
+ */
+static size_t HomeSlot_(const char* name, uint32_t permutation)
+{
+    uint64_t key = (uint64_t)(uintptr_t)name ^ (uint64_t)permutation;
+    key *= UINT64_C(0x9E3779B97F4A7C15);
+    return (size_t)(key >> 32) & (registry_capacity - 1);
+}
+
+/**
+ * @brief Find the slot of a loaded shader, or the empty slot it would go
+ * in. The registry must have slots.
+ */
+static size_t FindSlot_(const char* name, uint32_t permutation)
+{
+    size_t slot = HomeSlot_(name, permutation);
+    while (registry[slot].name != NULL &&
+           (registry[slot].name != name ||
+            registry[slot].permutation != permutation))
+        slot = (slot + 1) & (registry_capacity - 1);
+    return slot;
+}
+
+/**
+ * @brief Double the registry's slots, or give it its first, and re-slot
+ * every shader.
+ */
+static void GrowRegistry_(void)
+{
+    shader_slot_t* old_registry = registry;
+    const size_t old_capacity = registry_capacity;
+
+    registry_capacity = old_capacity == 0 ? SHADER_REGISTRY_MINIMUM
+                                          : old_capacity * 2;
+    registry = LetoCalloc(memory_shaders, registry_capacity,
+                          sizeof(shader_slot_t));
+    for (size_t i = 0; i < old_capacity; i++)
+    {
+        if (old_registry[i].name == NULL) continue;
+        registry[FindSlot_(old_registry[i].name,
+                           old_registry[i].permutation)] = old_registry[i];
+    }
+    LetoFree(old_registry);
+}
+
+/**
+ * @brief Add a shader to the registry.
+ */
+static void Register_(const shader_t* shader)
+{
+    if ((registry_count + 1) * 4 > registry_capacity * 3) GrowRegistry_();
+    registry[FindSlot_(shader->name, shader->permutation)] =
+        (shader_slot_t){shader->name, shader->permutation,
+                        shader->pool_handle};
+    registry_count++;
+}
+
+/**
+ * @brief Remove a shader from the registry. Every shader after it in its
+ * run of slots is moved back wherever that keeps it findable, so there's
+ * never a need for tombstones.
+ */
+static void Unregister_(const shader_t* shader)
+{
+    const size_t mask = registry_capacity - 1;
+    size_t hole = FindSlot_(shader->name, shader->permutation);
+    if (registry[hole].name == NULL) return;
+
+    for (size_t slot = (hole + 1) & mask; registry[slot].name != NULL;
+         slot = (slot + 1) & mask)
+    {
+        // A shader may fill the hole unless its home slot lies in the
+        // cyclic range (hole, slot].
+        const size_t home =
+            HomeSlot_(registry[slot].name, registry[slot].permutation);
+        if (((slot - home) & mask) < ((slot - hole) & mask)) continue;
+        registry[hole] = registry[slot];
+        hole = slot;
+    }
+    registry[hole].name = NULL;
+    registry_count--;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Read and preprocess every stage file in a shader's folder.
+ *
+ * PARAMETERS
+ *
+ * @param name The name of the shader's folder.
+ * @param permutation The keywords to preprocess the stages with.
+ * @param sources The storage for each stage's preprocessed source, NULL
+ * for stages the shader doesn't have. These are freed with @ref
+ * LetoFree.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the shader has any stages, all of which were
+ * preprocessed. On failure, no sources are kept.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning file_read -- If the folder holds no stage files, this warning
+ * is thrown and false is returned.
+ * @note For warnings unhandled by this function, see @ref
+ * LetoPreprocessShader.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool ReadStages_(const char* name, uint32_t permutation,
+                        char* sources[SHADER_MAX_STAGES])
+{
+    bool found = false, preprocessed = true;
+    for (size_t i = 0; i < SHADER_MAX_STAGES; i++)
+    {
+        sources[i] = NULL;
+        char* path =
+            LetoStringCreate(MAX_PATH_LENGTH, ASSET_DIR "/shaders/%s/%s",
+                             name, stage_files[i].file);
+        if (preprocessed && LetoFileExists(path))
+        {
+            char* raw = (char*)LetoReadFilePV(true, "%s", path);
+            sources[i] = LetoPreprocessShader(raw, permutation);
+            LetoFree(raw);
+            preprocessed = sources[i] != NULL;
+            found = true;
+        }
+        LetoStringFree(&path);
+    }
+
+    if (!found) LetoReport(file_read);
+    if (found && preprocessed) return true;
+    for (size_t i = 0; i < SHADER_MAX_STAGES; i++) LetoFree(sources[i]);
+    return false;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Start compiling and linking a program from the sources of its
+ * stages, without waiting on or checking any of it. If every stage has a
+ * SPIR-V module that specializes for the permutation, those are used in
+ * place of the sources, as a program can't mix the two. The program is
+ * linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set, so its binary can
+ * be cached afterwards.
+ *
+ * PARAMETERS
+ *
+ * @param name The name of the shader's folder.
+ * @param permutation The shader's keywords.
+ * @param sources The source of each stage, NULL for stages the program
+ * doesn't have.
+ * @param stages The storage for the ID of each stage, 0 for stages the
+ * program doesn't have, which are checked once the program's done.
+ * @param separable Whether or not the program is a separable stage.
+ * @param statistics The build's statistics, which get the program, the
+ * time spent issuing each compile and the link, and the origin.
+ *
+ * RETURN VALUE
+ *
+ * @return The program being linked.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static unsigned int SubmitProgram_(const char* name, uint32_t permutation,
+                                   const char* const* sources,
+                                   unsigned int* stages, bool separable,
+                                   shader_statistics_t* statistics)
+{
+    bool precompiled = true;
+    for (size_t i = 0; i < SHADER_MAX_STAGES && precompiled; i++)
+    {
+        if (sources[i] == NULL) continue;
+        const uint64_t start = LetoGetTimeNs();
+        stages[i] = LetoLoadSpirvStage(name, stage_files[i].file,
+                                       stage_files[i].type, permutation);
+        statistics->compile_ns[i] += LetoGetTimeNs() - start;
+        precompiled = stages[i] != 0;
+    }
+
+    for (size_t i = 0; i < SHADER_MAX_STAGES && !precompiled; i++)
+    {
+        if (sources[i] == NULL) continue;
+        const uint64_t start = LetoGetTimeNs();
+        if (stages[i] != 0) glDeleteShader(stages[i]);
+        stages[i] = glCreateShader(stage_files[i].type);
+        glShaderSource(stages[i], 1, &sources[i], NULL);
+        glCompileShader(stages[i]);
+        statistics->compile_ns[i] += LetoGetTimeNs() - start;
+    }
+    statistics->origin =
+        precompiled ? shader_origin_spirv : shader_origin_glsl;
+
+    unsigned int program = glCreateProgram();
+    statistics->program = program;
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
+                        GL_TRUE);
+    glProgramParameteri(program, GL_PROGRAM_SEPARABLE,
+                        separable ? GL_TRUE : GL_FALSE);
+    for (size_t i = 0; i < SHADER_MAX_STAGES; i++)
+        if (stages[i] != 0) glAttachShader(program, stages[i]);
+    const uint64_t start = LetoGetTimeNs();
+    glLinkProgram(program);
+    statistics->link_ns += LetoGetTimeNs() - start;
+    return program;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Get the separable stage for a preprocessed source, sharing the
+ * one already in use if there is one. Otherwise the stage is loaded from
+ * its cached binary, or submitted like @ref SubmitProgram_.
+ *
+ * PARAMETERS
+ *
+ * @param name The name of the shader's folder.
+ * @param keywords The shader's keywords.
+ * @param index The index of the stage within @ref stage_files.
+ * @param source The stage's preprocessed source.
+ * @param building The storage for the ID of the stage being compiled, or
+ * 0 if it's shared or was loaded from its binary.
+ *
+ * RETURN VALUE
+ *
+ * @return The stage.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static shader_stage_t* AcquireStage_(const char* name, uint32_t keywords,
+                                     size_t index, const char* source,
+                                     unsigned int* building)
+{
+    const char* parts[2] = {stage_files[index].file, source};
+    const uint64_t hash = LetoHashSources(parts, 2);
+    *building = 0;
+    for (size_t i = 0; i < stage_count; i++)
+    {
+        if (stage_list[i]->hash != hash) continue;
+        stage_list[i]->references++;
+        return stage_list[i];
+    }
+
+    if (stage_count == stage_capacity)
+    {
+        stage_capacity = stage_capacity == 0 ? 16 : stage_capacity * 2;
+        stage_list =
+            stage_list == NULL
+                ? LetoMalloc(memory_shaders,
+                             stage_capacity * sizeof(shader_stage_t*))
+                : LetoRealloc(stage_list,
+                              stage_capacity * sizeof(shader_stage_t*));
+    }
+    shader_stage_t* stage =
+        LetoMalloc(memory_shaders, sizeof(shader_stage_t));
+    *stage = (shader_stage_t){.hash = hash, .references = 1};
+    stage_list[stage_count++] = stage;
+
+    shader_statistics_t* stage_statistics = LetoCreateShaderStatistics(
+        name, stage_files[index].file, keywords | SHADER_SEPARABLE,
+        shader_origin_binary);
+    stage_statistics->source_size[index] = strlen(source);
+
+    char* path =
+        LetoStringCreate(MAX_PATH_LENGTH, BINARY_STAGE_PATH, name,
+                         stage_files[index].file, (unsigned int)keywords);
+    const uint64_t start = LetoGetTimeNs();
+    stage->id = LetoLoadProgramBinary(path, hash, true);
+    stage_statistics->link_ns = LetoGetTimeNs() - start;
+    stage_statistics->program = stage->id;
+    LetoStringFree(&path);
+    if (stage->id != 0)
+    {
+        LetoReflectProgram(stage->id, &stage->reflection);
+        LetoCompleteShaderStatistics(stage_statistics, stage->id, NULL,
+                                     &stage->reflection);
+        return stage;
+    }
+
+    const char* sources[SHADER_MAX_STAGES] = {0};
+    unsigned int stages[SHADER_MAX_STAGES] = {0};
+    sources[index] = source;
+    stage->id = SubmitProgram_(name, keywords, sources, stages, true,
+                               stage_statistics);
+    *building = stages[index];
+    return stage;
+}
+
+/**
+ * @brief Drop a reference to a separable stage, deleting it with the
+ * last.
+ */
+static void ReleaseStage_(shader_stage_t* stage)
+{
+    if (--stage->references > 0) return;
+
+    for (size_t i = 0; i < stage_count; i++)
+    {
+        if (stage_list[i] != stage) continue;
+        stage_list[i] = stage_list[--stage_count];
+        break;
+    }
+    LetoFreeReflection(&stage->reflection);
+    glDeleteProgram(stage->id);
+    LetoFree(stage);
+}
+
+/**
+ * @brief Put together the program pipeline of a finished separable
+ * shader.
+ */
+static void AssemblePipeline_(shader_t* shader)
+{
+    glCreateProgramPipelines(1, &shader->id);
+    for (size_t i = 0; i < SHADER_MAX_STAGES; i++)
+        if (shader->stages[i] != NULL)
+            glUseProgramStages(shader->id, stage_files[i].bit,
+                               shader->stages[i]->id);
+}
+
+/**
+ * @brief Check the stages a batch built for a separable shader, and
+ * reflect, record and cache each.
+ */
+static void FinishStages_(const shader_t* shader,
+                          const unsigned int* stages)
+{
+    const uint32_t keywords = shader->permutation & ~SHADER_SEPARABLE;
+    for (size_t i = 0; i < SHADER_MAX_STAGES; i++)
+    {
+        if (stages[i] == 0) continue;
+
+        shader_stage_t* stage = shader->stages[i];
+        shader_statistics_t* statistics =
+            LetoFindShaderStatistics(stage->id);
+        uint64_t start = LetoGetTimeNs();
+        CheckShaderCompilation_(stages[i]);
+        statistics->compile_ns[i] += LetoGetTimeNs() - start;
+        start = LetoGetTimeNs();
+        CheckShaderLinkage_(stage->id);
+        statistics->link_ns += LetoGetTimeNs() - start;
+        LetoReflectProgram(stage->id, &stage->reflection);
+
+        // Only the stage's own slot is set, which is all the statistics
+        // look at.
+        unsigned int built[SHADER_MAX_STAGES] = {0};
+        built[i] = stages[i];
+        LetoCompleteShaderStatistics(statistics, stage->id, built,
+                                     &stage->reflection);
+        char* path = LetoStringCreate(MAX_PATH_LENGTH, BINARY_STAGE_PATH,
+                                      shader->name, stage_files[i].file,
+                                      (unsigned int)keywords);
+        (void)LetoStoreProgramBinary(stage->id, path, stage->hash);
+        LetoStringFree(&path);
+        glDeleteShader(stages[i]);
+    }
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Load a whole shader's program from its cached binary, or submit
+ * it like @ref SubmitProgram_, and start its statistics.
+ *
+ * PARAMETERS
+ *
+ * @param shader The shader, without a program yet.
+ * @param sources The preprocessed source of each stage, NULL for stages
+ * the shader doesn't have.
+ * @param hash The hash of the sources.
+ * @param stages The storage for the ID of each stage being compiled.
+ *
+ * RETURN VALUE
+ *
+ * @return The program, loaded or being linked.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static unsigned int LoadProgram_(shader_t* shader,
+                                 const char* const* sources, uint64_t hash,
+                                 unsigned int* stages)
+{
+    shader_statistics_t* program_statistics =
+        LetoCreateShaderStatistics(shader->name, NULL, shader->permutation,
+                                   shader_origin_binary);
+    for (size_t i = 0; i < SHADER_MAX_STAGES; i++)
+        program_statistics->source_size[i] =
+            sources[i] != NULL ? strlen(sources[i]) : 0;
+
+    // Warm starts take the cached binary and never touch the compiler.
+    char* path = LetoStringCreate(MAX_PATH_LENGTH, BINARY_PATH,
+                                  shader->name,
+                                  (unsigned int)shader->permutation);
+    const uint64_t start = LetoGetTimeNs();
+    unsigned int program = LetoLoadProgramBinary(path, hash, false);
+    program_statistics->link_ns = LetoGetTimeNs() - start;
+    program_statistics->program = program;
+    LetoStringFree(&path);
+
+    // Binaries arrive linked, so they can be reflected right away.
+    if (program != 0)
+    {
+        LetoReflectProgram(program, &shader->reflection);
+        LetoCompleteShaderStatistics(program_statistics, program, NULL,
+                                     &shader->reflection);
+        return program;
+    }
+
+    return SubmitProgram_(shader->name, shader->permutation, sources,
+                          stages, false, program_statistics);
+}
+
+/**
+ * @brief Check whether a shader of a batch is being built from source.
+ */
+static bool Building_(const shader_batch_t* batch, size_t index)
+{
+    for (size_t i = 0; i < SHADER_MAX_STAGES; i++)
+        if (batch->stages[index * SHADER_MAX_STAGES + i] != 0) return true;
+    return false;
+}
+
+shader_batch_t* LetoSubmitShaders(const char* const* names,
+                                  const uint32_t* permutations,
+                                  size_t count, shader_t** shaders)
+{
+    if (names == NULL || shaders == NULL)
     {
         LetoReport(null_param);
         return NULL;
     }
+    EnableParallelCompile_();
 
-    char* vraw =
-        (char*)LetoReadFilePV(true, ASSET_DIR "/shaders/%s/vert.vs", name);
-    char* fraw =
-        (char*)LetoReadFilePV(true, ASSET_DIR "/shaders/%s/frag.fs", name);
-    const char *vcode = vraw, *fcode = fraw;
+    shader_batch_t* batch =
+        LetoMalloc(memory_shaders, sizeof(shader_batch_t));
+    *batch = (shader_batch_t){
+        .shaders = LetoMalloc(memory_shaders, count * sizeof(shader_t*)),
+        .stages = LetoCalloc(memory_shaders, count * SHADER_MAX_STAGES,
+                             sizeof(unsigned int)),
+        .hashes = LetoMalloc(memory_shaders, count * sizeof(uint64_t)),
+        .count = count};
 
-    unsigned int vid = glCreateShader(GL_VERTEX_SHADER),
-                 fid = glCreateShader(GL_FRAGMENT_SHADER);
+    for (size_t i = 0; i < count; i++)
+    {
+        const uint32_t permutation =
+            permutations != NULL ? permutations[i] : 0;
+        shaders[i] = batch->shaders[i] = NULL;
+        if (names[i] == NULL)
+        {
+            LetoReport(null_param);
+            continue;
+        }
 
-    glShaderSource(vid, 1, &vcode, NULL);
-    glCompileShader(vid);
-    CheckShaderCompilation_(vid);
+        const char* name = LetoStringIntern(names[i], strlen(names[i]));
+        shader_t* created_node = LetoFindShaderInterned(name, permutation);
+        if (created_node != NULL)
+        {
+            created_node->references++;
+            shaders[i] = batch->shaders[i] = created_node;
+            continue;
+        }
 
-    glShaderSource(fid, 1, &fcode, NULL);
-    glCompileShader(fid);
-    CheckShaderCompilation_(fid);
+        const uint32_t keywords = permutation & ~SHADER_SEPARABLE;
+        char* sources[SHADER_MAX_STAGES];
+        if (!ReadStages_(name, keywords, sources)) continue;
+        batch->hashes[i] = LetoHashSources((const char* const*)sources,
+                                           SHADER_MAX_STAGES);
 
-    free(vraw), free(fraw);
+        if (shader_pool == NULL)
+            shader_pool = LetoCreatePoolT(memory_shaders, shader_t, 16);
+        pool_handle_t handle = LetoPoolAllocate(shader_pool);
+        created_node = LetoPoolGetT(shader_t, shader_pool, handle);
+        if (created_node == NULL) LetoReport(failed_buffer);
+        created_node->name = name;
+        created_node->permutation = permutation;
+        created_node->references = 1;
+        created_node->pool_handle = handle;
+        created_node->reflection = (shader_reflection_t){0};
+        unsigned int* stages = &batch->stages[i * SHADER_MAX_STAGES];
 
-    shader_t* created_node = calloc(sizeof(shader_t), 1);
-    if (created_node == NULL) LetoReport(failed_buffer);
-    created_node->name = name;
+        // Separable shaders get their pipeline once their stages are
+        // done, as a stage may be shared with a shader still building it.
+        created_node->id = 0;
+        for (size_t j = 0; j < SHADER_MAX_STAGES; j++)
+            created_node->stages[j] =
+                (permutation & SHADER_SEPARABLE) && sources[j] != NULL
+                    ? AcquireStage_(name, keywords, j, sources[j],
+                                    &stages[j])
+                    : NULL;
 
-    created_node->id = glCreateProgram();
-    glAttachShader(created_node->id, vid);
-    glAttachShader(created_node->id, fid);
-    glLinkProgram(created_node->id);
-    CheckShaderLinkage_(created_node->id);
+        // The driver copies the sources it's given, so they can go
+        // straight away whether or not they were compiled.
+        if (!(permutation & SHADER_SEPARABLE))
+            created_node->id = LoadProgram_(
+                created_node, (const char* const*)sources,
+                batch->hashes[i], stages);
+        for (size_t j = 0; j < SHADER_MAX_STAGES; j++)
+            LetoFree(sources[j]);
 
-    glDeleteShader(vid), glDeleteShader(fid);
-    return created_node;
+        Register_(created_node);
+        shaders[i] = batch->shaders[i] = created_node;
+    }
+    return batch;
+}
+
+bool LetoPollShaders(const shader_batch_t* batch)
+{
+    if (batch == NULL)
+    {
+        LetoReport(null_param);
+        return true;
+    }
+    if (!parallel_compile) return true;
+
+    for (size_t i = 0; i < batch->count * SHADER_MAX_STAGES; i++)
+    {
+        if (batch->stages[i] == 0) continue;
+
+        // A separable shader's stages are each a program of their own.
+        const shader_t* shader = batch->shaders[i / SHADER_MAX_STAGES];
+        const shader_stage_t* stage =
+            shader->stages[i % SHADER_MAX_STAGES];
+        GLint complete = GL_FALSE;
+        glGetProgramiv(stage != NULL ? stage->id : shader->id,
+                       GL_COMPLETION_STATUS_KHR, &complete);
+        if (!complete) return false;
+    }
+    return true;
+}
+
+void LetoFinishShaders(shader_batch_t* batch)
+{
+    if (batch == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    for (size_t i = 0; i < batch->count; i++)
+    {
+        const unsigned int* stages = &batch->stages[i * SHADER_MAX_STAGES];
+        shader_t* shader = batch->shaders[i];
+        if (shader != NULL && (shader->permutation & SHADER_SEPARABLE))
+        {
+            FinishStages_(shader, stages);
+            continue;
+        }
+        if (!Building_(batch, i)) continue;
+
+        shader_statistics_t* statistics =
+            LetoFindShaderStatistics(shader->id);
+        for (size_t j = 0; j < SHADER_MAX_STAGES; j++)
+        {
+            if (stages[j] == 0) continue;
+            const uint64_t start = LetoGetTimeNs();
+            CheckShaderCompilation_(stages[j]);
+            statistics->compile_ns[j] += LetoGetTimeNs() - start;
+        }
+        const uint64_t start = LetoGetTimeNs();
+        CheckShaderLinkage_(shader->id);
+        statistics->link_ns += LetoGetTimeNs() - start;
+        LetoReflectProgram(shader->id, &shader->reflection);
+        LetoCompleteShaderStatistics(statistics, shader->id, stages,
+                                     &shader->reflection);
+        char* path = LetoStringCreate(MAX_PATH_LENGTH, BINARY_PATH,
+                                      shader->name,
+                                      (unsigned int)shader->permutation);
+        (void)LetoStoreProgramBinary(shader->id, path, batch->hashes[i]);
+        LetoStringFree(&path);
+        for (size_t j = 0; j < SHADER_MAX_STAGES; j++)
+            if (stages[j] != 0) glDeleteShader(stages[j]);
+    }
+
+    // Every stage of the batch is checked before any pipeline is put
+    // together, as shaders of the batch may share them.
+    for (size_t i = 0; i < batch->count; i++)
+    {
+        shader_t* shader = batch->shaders[i];
+        if (shader != NULL && (shader->permutation & SHADER_SEPARABLE) &&
+            shader->id == 0)
+            AssemblePipeline_(shader);
+    }
+
+    LetoFree(batch->shaders);
+    LetoFree(batch->stages);
+    LetoFree(batch->hashes);
+    LetoFree(batch);
+}
+
+shader_t* LetoLoadShader(const char* name)
+{
+    return LetoGetShaderVariant(name, 0);
+}
+
+shader_t* LetoGetShaderVariant(const char* name, uint32_t permutation)
+{
+    if (name == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+
+    shader_t* shader = NULL;
+    LetoFinishShaders(LetoSubmitShaders(&name, &permutation, 1, &shader));
+    return shader;
+}
+
+shader_t* LetoFindShader(const char* name, uint32_t permutation)
+{
+    if (name == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+
+    // A name that was never interned was never loaded.
+    const char* interned = LetoStringFindInterned(name, strlen(name));
+    if (interned == NULL) return NULL;
+    return LetoFindShaderInterned(interned, permutation);
+}
+
+shader_t* LetoFindShaderInterned(const char* name, uint32_t permutation)
+{
+    if (name == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+    if (registry_count == 0) return NULL;
+
+    const shader_slot_t* slot = &registry[FindSlot_(name, permutation)];
+    if (slot->name == NULL) return NULL;
+    return LetoPoolGetT(shader_t, shader_pool, slot->handle);
+}
+
+shader_t* LetoResolveShader(pool_handle_t handle)
+{
+    if (shader_pool == NULL)
+    {
+        LetoReport(stale_handle);
+        return NULL;
+    }
+    return LetoPoolGetT(shader_t, shader_pool, handle);
 }
 
 void LetoUnloadShader(shader_t* node)
@@ -166,8 +966,56 @@ void LetoUnloadShader(shader_t* node)
         return;
     }
 
-    glDeleteProgram(node->id);
-    free(node);
+    if (--node->references > 0) return;
+
+    Unregister_(node);
+    LetoFreeReflection(&node->reflection);
+    if (node->permutation & SHADER_SEPARABLE)
+    {
+        for (size_t i = 0; i < SHADER_MAX_STAGES; i++)
+            if (node->stages[i] != NULL) ReleaseStage_(node->stages[i]);
+        LetoForgetGLObject(gl_state_pipeline, node->id);
+        glDeleteProgramPipelines(1, &node->id);
+    }
+    else glDeleteProgram(node->id);
+    LetoPoolFree(shader_pool, node->pool_handle);
+}
+
+void LetoFreeShaderRegistry(void)
+{
+    for (size_t i = 0; i < registry_capacity; i++)
+    {
+        if (registry[i].name == NULL) continue;
+        shader_t* shader =
+            LetoPoolGetT(shader_t, shader_pool, registry[i].handle);
+        LetoFreeReflection(&shader->reflection);
+        if (shader->permutation & SHADER_SEPARABLE)
+        {
+            LetoForgetGLObject(gl_state_pipeline, shader->id);
+            glDeleteProgramPipelines(1, &shader->id);
+        }
+        else glDeleteProgram(shader->id);
+    }
+
+    // Every stage still in use belongs to a shader freed above.
+    for (size_t i = 0; i < stage_count; i++)
+    {
+        LetoFreeReflection(&stage_list[i]->reflection);
+        glDeleteProgram(stage_list[i]->id);
+        LetoFree(stage_list[i]);
+    }
+    LetoFree(stage_list);
+    stage_list = NULL;
+    stage_count = stage_capacity = 0;
+    LetoFreeShaderStatistics();
+
+    LetoFree(registry);
+    registry = NULL;
+    registry_capacity = registry_count = 0;
+    if (shader_pool == NULL) return;
+
+    LetoDestroyPool(shader_pool);
+    shader_pool = NULL;
 }
 
 void LetoUseShader(const shader_t* shader)
@@ -178,6 +1026,17 @@ void LetoUseShader(const shader_t* shader)
         return;
     }
 
-    glUseProgram(shader->id);
-    if (glGetError() != GL_NO_ERROR) LetoReport(gl_shader_bad);
+    // A pipeline is only used while no program is current.
+    if (shader->permutation & SHADER_SEPARABLE)
+    {
+        LetoUseProgram(0);
+        LetoBindProgramPipeline(shader->id);
+    }
+    else LetoUseProgram(shader->id);
+}
+
+const char* LetoGetShaderStageFile(size_t stage)
+{
+    if (stage >= SHADER_MAX_STAGES) return NULL;
+    return stage_files[stage].file;
 }
@@ -18,8 +18,62 @@
 #ifndef __LETO__SHADERS__
 #define __LETO__SHADERS__
 
+// The boolean type as described by the C standard.
+#include <stdbool.h>
+// Standard macro definitions, like size_t.
+#include <stddef.h>
 // Fixed-width integers as described by the C standard.
 #include <stdint.h>
+// Pool handles for shader storage.
+#include <utilities/pools.h>
+// Shader keywords for permutations.
+#include <resources/preprocessor.h>
+// Reflected uniforms, blocks and attributes.
+#include <resources/reflection.h>
+
+/**
+ * @brief The amount of stages a shader can have, one per file it may
+ * hold: vert.vs, tesc.tcs, tese.tes, geom.gs, frag.fs and comp.cs.
+ */
+#define SHADER_MAX_STAGES 6
+
+/**
+ * @brief Not a keyword, but OR'd into a permutation all the same: build
+ * the shader as a program pipeline of separable stages rather than as a
+ * single program. Each stage is compiled, linked and cached on its own,
+ * and shared by every shader whose preprocessed stage is the same, so a
+ * shader's variants only build the stages their keywords change. Stages
+ * are only matched up when the pipeline is bound, so their interfaces
+ * should match by location, and any stage writing gl_Position should
+ * redeclare gl_PerVertex.
+ */
+#define SHADER_SEPARABLE (1u << 31)
+
+/**
+ * @brief A separable program of a single stage, shared by every separable
+ * shader with the same preprocessed source for that stage.
+ */
+typedef struct
+{
+    /**
+     * @brief The OpenGL ID of the stage's separable program.
+     */
+    unsigned int id;
+    /**
+     * @brief The hash of the stage's file name and preprocessed source,
+     * which the stage is shared by.
+     */
+    uint64_t hash;
+    /**
+     * @brief How many separable shaders use the stage.
+     */
+    uint32_t references;
+    /**
+     * @brief Every resource of the stage's program. Uniforms are the
+     * program's state, so each stage keeps its own shadows.
+     */
+    shader_reflection_t reflection;
+} shader_stage_t;
 
 /**
  * @brief A shader wrapper that contains an associated name value.
@@ -27,26 +81,196 @@
 typedef struct
 {
     /**
-     * @brief The OpenGL ID of the shader. @warning This should not be
-     * changed, as doing so will more likely than not cause an OpenGL
-     * error.
+     * @brief The OpenGL ID of the shader's program, or of its program
+     * pipeline if it's separable. @warning This should not be changed,
+     * as doing so will more likely than not cause an OpenGL error.
      */
     unsigned int id;
     /**
-     * @brief The name of the shader's containing folder.
+     * @brief The name of the shader's containing folder, interned with
+     * @ref LetoStringIntern.
      */
     const char* name;
+    /**
+     * @brief The keywords the shader was built with, see @ref
+     * shader_keyword_t, and @ref SHADER_SEPARABLE if it's separable.
+     */
+    uint32_t permutation;
+    /**
+     * @brief How many loads share the shader. Each is undone by a call to
+     * @ref LetoUnloadShader, and the last frees it.
+     */
+    uint32_t references;
+    /**
+     * @brief Every resource of the linked program, read once it's done
+     * linking. See @ref LetoSetUniformFloat and its siblings. Separable
+     * shaders leave this empty, as their resources are reflected per
+     * stage.
+     */
+    shader_reflection_t reflection;
+    /**
+     * @brief The stages of a separable shader, NULL for the stages it
+     * doesn't have and for every stage of a shader that isn't separable.
+     */
+    shader_stage_t* stages[SHADER_MAX_STAGES];
+    /**
+     * @brief The handle of the shader within the shader pool. This is
+     * used to return the shader to the pool when it's unloaded.
+     */
+    pool_handle_t pool_handle;
 } shader_t;
 
+/**
+ * @brief A set of shaders whose programs have been submitted to the
+ * driver, but not yet checked. See @ref LetoSubmitShaders.
+ */
+typedef struct
+{
+    /**
+     * @brief The shader made for each name, or NULL for NULL names.
+     */
+    shader_t** shaders;
+    /**
+     * @brief The @ref SHADER_MAX_STAGES stages of each shader still being
+     * built, 0 for each stage it hasn't. Shaders loaded from their cached
+     * binary or already loaded beforehand have none, as do the separable
+     * stages that were shared rather than built.
+     */
+    unsigned int* stages;
+    /**
+     * @brief The hash of each shader's sources, to cache its binary under
+     * once it's linked.
+     */
+    uint64_t* hashes;
+    size_t count;
+} shader_batch_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Submit a set of shaders to the driver. Every shader is read,
+ * preprocessed with @ref LetoPreprocessShader, and either loaded from its
+ * cached binary or has all its compiles and its link issued, and nothing
+ * is waited on or checked, so the driver works on every program at once.
+ * Drivers with GL_KHR_parallel_shader_compile do so on background
+ * threads. A shader's stages are whichever of its folder's stage files
+ * exist, see @ref SHADER_MAX_STAGES. Shaders already in the registry with
+ * the same name and permutation are shared rather than built again.
+ * Separable shaders, see @ref SHADER_SEPARABLE, instead submit each stage
+ * no other separable shader has, and get their pipeline once they're
+ * finished. The shaders mustn't be used before @ref LetoFinishShaders.
+ *
+ * PARAMETERS
+ *
+ * @param names The name of each shader's folder. These strings are
+ * interned, so they needn't outlive the call, and are @b NOT sanitized.
+ * @param permutations The keywords to build each shader with, see @ref
+ * shader_keyword_t, along with @ref SHADER_SEPARABLE for shaders to
+ * build separably, or NULL to build every shader as a single program
+ * without any.
+ * @param count The amount of shaders.
+ * @param shaders The storage for the shaders, to be freed with @ref
+ * LetoUnloadShader.
+ *
+ * RETURN VALUE
+ *
+ * @return The submitted batch, to be passed to @ref LetoFinishShaders.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If the names or shader storage are NULL, this
+ * warning is thrown and NULL is returned. If a single name is NULL, this
+ * warning is thrown and its shader is NULL.
+ * @warning file_read -- If a shader's folder holds no stage files, this
+ * warning is thrown and its shader is NULL.
+ * @note For possible warnings unhandled by this function, see @ref
+ * LetoReadFilePV and @ref LetoPreprocessShader. Shaders that fail to
+ * preprocess are NULL.
+ *
+ * ERRORS
+ *
+ * One error can be thrown by this function.
+ * @exception failed_buffer -- If the shader pool can't hand out another
+ * shader, this error is thrown and the process quits.
+ *
+ */
+shader_batch_t* LetoSubmitShaders(const char* const* names,
+                                  const uint32_t* permutations,
+                                  size_t count, shader_t** shaders);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Check, without blocking, whether the driver has finished every
+ * program of a batch, so that other loading can carry on in the
+ * meantime.
+ *
+ * PARAMETERS
+ *
+ * @param batch The batch.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not every program is done. Without parallel
+ * compilation the driver can't be asked without blocking, so this is
+ * always true and @ref LetoFinishShaders does the waiting.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the batch is NULL, this warning is thrown and
+ * true is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+bool LetoPollShaders(const shader_batch_t* batch);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Finish a batch: wait for every program, check their compiles and
+ * links, cache the binaries of the ones built from source, put together
+ * the pipelines of separable shaders, and free the batch.
+ *
+ * PARAMETERS
+ *
+ * @param batch The batch to finish.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the batch is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * One error can be thrown by this function.
+ * @exception gl_shader_comp -- If any stage fails to compile or any
+ * program fails to link, the driver's log is printed and this error is
+ * thrown.
+ *
+ */
+void LetoFinishShaders(shader_batch_t* batch);
+
 /**
  * DESCRIPTION
  *
  * @brief Load a shader from its text file(s) into the program's memory.
- * This file will automatically detect any and all files within the given
- * directory, and uses file extensions to figure out what capabilities the
- * shader has (compute shader, etc.).
- * @todo Implement shader type decision and support for more than just
- * vertex and fragment shaders.
+ * Every stage file within the given directory is picked up, and its file
+ * name decides its stage (vert.vs, tesc.tcs, tese.tes, geom.gs, frag.fs
+ * and comp.cs). This is a batch of one without any keywords, see @ref
+ * LetoSubmitShaders. Linked programs are cached on disk
+ * through @ref LetoStoreProgramBinary, so later runs with the same
+ * sources and driver load the binary instead of compiling; any binary
+ * the driver rejects falls back to the sources.
  *
  * PARAMETERS
  *
@@ -86,12 +310,134 @@ typedef struct
  */
 shader_t* LetoLoadShader(const char* name);
 
+/**
+ * DESCRIPTION
+ *
+ * @brief Get a permutation of a shader, building it on first use. Each
+ * variant is only compiled once something asks for it, and is shared
+ * from then on, so only the permutations a scene actually uses are ever
+ * built.
+ *
+ * PARAMETERS
+ *
+ * @param name The name of the shader's folder. This string is @b NOT
+ * sanitized.
+ * @param permutation The keywords to build the shader with, see @ref
+ * shader_keyword_t, and @ref SHADER_SEPARABLE to build it separably.
+ *
+ * RETURN VALUE
+ *
+ * @return The shader, to be freed with @ref LetoUnloadShader, or NULL if
+ * it couldn't be loaded.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the name is NULL, this warning is thrown and
+ * NULL is returned.
+ * @note For possible warnings unhandled by this function, see @ref
+ * LetoSubmitShaders.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For possible errors unhandled by this function, see @ref
+ * LetoFinishShaders.
+ *
+ */
+shader_t* LetoGetShaderVariant(const char* name, uint32_t permutation);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Look up a loaded shader in the registry by name. This costs a
+ * hash of the name; code that looks shaders up often should keep the
+ * shader's handle and use @ref LetoResolveShader instead.
+ *
+ * PARAMETERS
+ *
+ * @param name The name of the shader's folder.
+ * @param permutation The shader's permutation.
+ *
+ * RETURN VALUE
+ *
+ * @return The shader, or NULL if it isn't loaded.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the name is NULL, this warning is thrown and
+ * NULL is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+shader_t* LetoFindShader(const char* name, uint32_t permutation);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Look up a loaded shader in the registry by its interned name,
+ * like a shader's own @ref shader_t.name. No string is read or hashed.
+ *
+ * PARAMETERS
+ *
+ * @param name The interned name of the shader's folder.
+ * @param permutation The shader's permutation.
+ *
+ * RETURN VALUE
+ *
+ * @return The shader, or NULL if it isn't loaded.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the name is NULL, this warning is thrown and
+ * NULL is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+shader_t* LetoFindShaderInterned(const char* name, uint32_t permutation);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Get a shader from its handle, its @ref shader_t.pool_handle.
+ * Handles stay valid for as long as their shader is loaded and are never
+ * reused, so they can be held onto in place of the shader's name.
+ *
+ * PARAMETERS
+ *
+ * @param handle The shader's handle.
+ *
+ * RETURN VALUE
+ *
+ * @return The shader, or NULL if it has been unloaded.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning stale_handle -- If the shader has been unloaded, this warning
+ * is thrown and NULL is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+shader_t* LetoResolveShader(pool_handle_t handle);
+
 /**
  * DESCRIPTION
  *
  * @brief Unload a shader from memory, and free all information associated
- * with it. This function is basically a wrapper around two @ref free
- * calls.
+ * with it. Shaders shared between several loads are only freed once the
+ * last of them is unloaded.
  *
  * PARAMETERS
  *
@@ -114,10 +460,20 @@ shader_t* LetoLoadShader(const char* name);
  */
 void LetoUnloadShader(shader_t* node);
 
+/**
+ * @brief Free the shader registry and pool, along with any shaders still
+ * loaded and the statistics of every build. No shader or shader handle
+ * may be used afterward.
+ */
+void LetoFreeShaderRegistry(void);
+
 /**
  * DESCRIPTION
  *
- * @brief Use an OpenGL shader via its containing shader node.
+ * @brief Use an OpenGL shader via its containing shader node. Separable
+ * shaders bind their program pipeline, which only takes effect with no
+ * program in use, so that is cleared first. Bindings go through the
+ * state shadow, so using the shader already in use costs no GL call.
  *
  * PARAMETERS
  *
@@ -135,11 +491,17 @@ void LetoUnloadShader(shader_t* node);
  *
  * ERRORS
  *
- * One error can be thrown by this function.
- * @exception opengl_malformed_shader - If the shader inside the node is
- * not valid, this error is thrown and the process exits.
+ * Nothing to note. An invalid shader is reported by the driver's debug
+ * messages in debug builds, see @file State.h.
  *
  */
 void LetoUseShader(const shader_t* shader);
 
+/**
+ * @brief Get the file name of a stage, like "vert.vs", by its index
+ * within a shader's @ref SHADER_MAX_STAGES stages, or NULL if there's no
+ * such stage.
+ */
+const char* LetoGetShaderStageFile(size_t stage);
+
 #endif // __LETO__SHADERS___
@@ -0,0 +1,948 @@
+/**
+ * @file Simplifier.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Simplifier.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "simplifier.h"       // Public interface parent
+#include <io/reporter.h>      // Error / warning reporter
+#include <math.h>             // Sqrt
+#include <stdlib.h>           // Qsort
+#include <string.h>           // Memcpy, memcmp, memset
+#include <utilities/memory.h> // Tracked allocations
+
+/**
+ * @brief How a vertex is allowed to move while simplifying.
+ */
+typedef enum
+{
+    /**
+     * @brief Surrounded by triangles, so it can collapse onto any of its
+     * neighbours.
+     */
+    vertex_manifold,
+    /**
+     * @brief On an open border, so it can only collapse along the border,
+     * onto another border or locked vertex.
+     */
+    vertex_border,
+    /**
+     * @brief On an attribute seam, a boundary between submeshes, or
+     * non-manifold geometry, so it never moves.
+     */
+    vertex_locked,
+} vertex_kind_t;
+
+/**
+ * @brief The sum of the squared distances to a set of planes, as a
+ * symmetric 4x4 matrix.
+ */
+typedef struct
+{
+    /**
+     * @brief The upper triangle of the matrix, row by row.
+     */
+    double matrix[10];
+    /**
+     * @brief The total weight of the planes, so the error can be taken as
+     * a mean squared distance.
+     */
+    double weight;
+} quadric_t;
+
+/**
+ * @brief A candidate edge collapse, moving one vertex onto another.
+ */
+typedef struct
+{
+    uint32_t from;
+    uint32_t to;
+    /**
+     * @brief The mean squared distance of the collapsed vertex from the
+     * planes around both.
+     */
+    float cost;
+} collapse_t;
+
+/**
+ * @brief The state of a mesh being simplified. Topology and quadrics are
+ * kept per position rather than per vertex, so the vertices of a seam are
+ * treated as the one point they are.
+ */
+typedef struct
+{
+    const mesh_vertex_t* vertices;
+    size_t vertex_count;
+    /**
+     * @brief The lowest-numbered vertex sharing each vertex's position.
+     */
+    uint32_t* roots;
+    /**
+     * @brief The @ref vertex_kind_t of each root.
+     */
+    uint8_t* kinds;
+    quadric_t* quadrics;
+    /**
+     * @brief The live triangles, and the submesh each came from.
+     */
+    uint32_t* triangles;
+    uint32_t* tags;
+    size_t triangle_count;
+    /**
+     * @brief The triangles around each root, as offsets into @ref
+     * simplifier_t::adjacency. This is rebuilt before every pass.
+     */
+    uint32_t* offsets;
+    uint32_t* adjacency;
+    /**
+     * @brief The vertex each vertex collapsed onto this pass, if any.
+     */
+    uint32_t* remap;
+    /**
+     * @brief Whether each root has been involved in a collapse this pass.
+     */
+    uint8_t* touched;
+    collapse_t* collapses;
+} simplifier_t;
+
+/**
+ * @brief Hash the bits of a position.
+ */
+static uint32_t HashPosition_(const float position[3])
+{
+    uint32_t bits[3];
+    (void)memcpy(bits, position, sizeof(bits));
+
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < 3; i++) hash = (hash ^ bits[i]) * 16777619u;
+    return hash ^ (hash >> 15);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Find the root of every vertex: the first vertex with exactly
+ * the same position.
+ *
+ * PARAMETERS
+ *
+ * @param simplifier The simplifier, whose vertices are set.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void FindRoots_(simplifier_t* simplifier)
+{
+    size_t capacity = 1;
+    while (capacity < simplifier->vertex_count * 2) capacity <<= 1;
+    uint32_t* table =
+        LetoMalloc(memory_meshes, capacity * sizeof(uint32_t));
+    (void)memset(table, 0xFF, capacity * sizeof(uint32_t));
+
+    for (uint32_t i = 0; i < simplifier->vertex_count; i++)
+    {
+        const float* position = simplifier->vertices[i].position;
+        size_t slot = HashPosition_(position) & (capacity - 1);
+        while (table[slot] != UINT32_MAX &&
+               memcmp(simplifier->vertices[table[slot]].position,
+                      position, sizeof(vec3)) != 0)
+            slot = (slot + 1) & (capacity - 1);
+
+        if (table[slot] == UINT32_MAX) table[slot] = i;
+        simplifier->roots[i] = table[slot];
+    }
+
+    LetoFree(table);
+}
+
+/**
+ * @brief Get the root of a corner of a live triangle.
+ */
+static uint32_t Corner_(const simplifier_t* simplifier, size_t triangle,
+                        size_t corner)
+{
+    return simplifier->roots[simplifier->triangles[triangle * 3 + corner]];
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Build the root-to-triangle adjacency of the live triangles, as
+ * a counting sort of their corners by root.
+ *
+ * PARAMETERS
+ *
+ * @param simplifier The simplifier.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void BuildAdjacency_(simplifier_t* simplifier)
+{
+    uint32_t* offsets = simplifier->offsets;
+    const size_t vertex_count = simplifier->vertex_count;
+    (void)memset(offsets, 0, (vertex_count + 1) * sizeof(uint32_t));
+
+    for (size_t i = 0; i < simplifier->triangle_count; i++)
+        for (size_t j = 0; j < 3; j++)
+            offsets[Corner_(simplifier, i, j)]++;
+
+    uint32_t sum = 0;
+    for (size_t i = 0; i < vertex_count; i++)
+    {
+        const uint32_t count = offsets[i];
+        offsets[i] = sum;
+        sum += count;
+    }
+    offsets[vertex_count] = sum;
+
+    // Filling moves every offset to the start of the next root, so they
+    // get shifted back afterwards.
+    for (uint32_t i = 0; i < simplifier->triangle_count; i++)
+        for (size_t j = 0; j < 3; j++)
+            simplifier->adjacency[offsets[Corner_(simplifier, i, j)]++] =
+                i;
+    for (size_t i = vertex_count; i > 0; i--) offsets[i] = offsets[i - 1];
+    offsets[0] = 0;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Count the live triangles with the directed edge from one root to
+ * another.
+ *
+ * PARAMETERS
+ *
+ * @param simplifier The simplifier, whose adjacency is current.
+ * @param from The root the edge starts at.
+ * @param to The root the edge ends at.
+ * @param tag The storage for the submesh of the last such triangle, or
+ * NULL.
+ *
+ * RETURN VALUE
+ *
+ * @return The amount of triangles with the edge.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static size_t CountEdges_(const simplifier_t* simplifier, uint32_t from,
+                          uint32_t to, uint32_t* tag)
+{
+    size_t count = 0;
+    for (size_t i = simplifier->offsets[from];
+         i < simplifier->offsets[from + 1]; i++)
+    {
+        const uint32_t triangle = simplifier->adjacency[i];
+        for (size_t j = 0; j < 3; j++)
+        {
+            if (Corner_(simplifier, triangle, j) == from &&
+                Corner_(simplifier, triangle, (j + 1) % 3) == to)
+            {
+                count++;
+                if (tag != NULL) *tag = simplifier->tags[triangle];
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Decide how each root may move, from the edges around it. An
+ * edge with no twin is a border; an edge shared by more than two
+ * triangles, or whose twin is in another submesh, locks both its ends.
+ *
+ * PARAMETERS
+ *
+ * @param simplifier The simplifier, whose adjacency is current.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void Classify_(simplifier_t* simplifier)
+{
+    uint8_t* kinds = simplifier->kinds;
+    uint32_t* borders = LetoCalloc(memory_meshes, simplifier->vertex_count,
+                                   sizeof(uint32_t));
+
+    (void)memset(kinds, vertex_manifold, simplifier->vertex_count);
+    for (size_t i = 0; i < simplifier->vertex_count; i++)
+        if (simplifier->roots[i] != i)
+            kinds[simplifier->roots[i]] = vertex_locked;
+
+    for (size_t i = 0; i < simplifier->triangle_count; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+        {
+            const uint32_t a = Corner_(simplifier, i, j),
+                           b = Corner_(simplifier, i, (j + 1) % 3);
+            uint32_t tag = UINT32_MAX;
+            const size_t forward = CountEdges_(simplifier, a, b, NULL),
+                         backward = CountEdges_(simplifier, b, a, &tag);
+
+            if (forward > 1 || backward > 1 ||
+                (backward == 1 && tag != simplifier->tags[i]))
+                kinds[a] = kinds[b] = vertex_locked;
+            else if (backward == 0)
+            {
+                borders[a]++;
+                if (kinds[a] == vertex_manifold) kinds[a] = vertex_border;
+                if (kinds[b] == vertex_manifold) kinds[b] = vertex_border;
+            }
+        }
+    }
+
+    // A vertex where two borders meet, like the tip of a bowtie, can't
+    // slide along either without tearing the other.
+    for (size_t i = 0; i < simplifier->vertex_count; i++)
+        if (borders[i] > 1) kinds[i] = vertex_locked;
+    LetoFree(borders);
+}
+
+/**
+ * @brief Add a weighted plane, given as its normal and distance, to a
+ * quadric.
+ */
+static void AddPlane_(quadric_t* quadric, const double plane[4],
+                      double weight)
+{
+    size_t k = 0;
+    for (size_t i = 0; i < 4; i++)
+        for (size_t j = i; j < 4; j++)
+            quadric->matrix[k++] += plane[i] * plane[j] * weight;
+    quadric->weight += weight;
+}
+
+/**
+ * @brief Add one quadric to another.
+ */
+static void AddQuadric_(quadric_t* quadric, const quadric_t* other)
+{
+    for (size_t i = 0; i < 10; i++) quadric->matrix[i] += other->matrix[i];
+    quadric->weight += other->weight;
+}
+
+/**
+ * @brief Get the weighted sum of the squared distances from a position to
+ * the planes of a quadric.
+ */
+static double Evaluate_(const quadric_t* quadric, const float position[3])
+{
+    const double* m = quadric->matrix;
+    const double x = position[0], y = position[1], z = position[2];
+    return m[0] * x * x + 2 * m[1] * x * y + 2 * m[2] * x * z +
+           2 * m[3] * x + m[4] * y * y + 2 * m[5] * y * z + 2 * m[6] * y +
+           m[7] * z * z + 2 * m[8] * z + m[9];
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Build the quadric of every root from the planes of the triangles
+ * around it, weighted by their area. Border edges also add a plane
+ * through the edge, perpendicular to its triangle, which keeps borders
+ * from being pulled inwards.
+ *
+ * PARAMETERS
+ *
+ * @param simplifier The simplifier, whose roots are classified.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void BuildQuadrics_(simplifier_t* simplifier)
+{
+    for (size_t i = 0; i < simplifier->triangle_count; i++)
+    {
+        const uint32_t* triangle = &simplifier->triangles[i * 3];
+        vec3 ab, ac, normal;
+        glm_vec3_sub((float*)simplifier->vertices[triangle[1]].position,
+                     (float*)simplifier->vertices[triangle[0]].position,
+                     ab);
+        glm_vec3_sub((float*)simplifier->vertices[triangle[2]].position,
+                     (float*)simplifier->vertices[triangle[0]].position,
+                     ac);
+        glm_vec3_cross(ab, ac, normal);
+        const float length = glm_vec3_norm(normal);
+        if (length == 0.0f) continue;
+        glm_vec3_scale(normal, 1.0f / length, normal);
+
+        const float* origin = simplifier->vertices[triangle[0]].position;
+        const double plane[4] = {normal[0], normal[1], normal[2],
+                                 -glm_vec3_dot(normal, (float*)origin)};
+        for (size_t j = 0; j < 3; j++)
+            AddPlane_(&simplifier->quadrics[Corner_(simplifier, i, j)],
+                      plane, length * 0.5);
+
+        for (size_t j = 0; j < 3; j++)
+        {
+            const uint32_t a = Corner_(simplifier, i, j),
+                           b = Corner_(simplifier, i, (j + 1) % 3);
+            if (simplifier->kinds[a] == vertex_manifold ||
+                CountEdges_(simplifier, b, a, NULL) != 0)
+                continue;
+
+            const float* start =
+                simplifier->vertices[triangle[j]].position;
+            vec3 edge, side;
+            glm_vec3_sub(
+                (float*)simplifier->vertices[triangle[(j + 1) % 3]]
+                    .position,
+                (float*)start, edge);
+            glm_vec3_cross(edge, normal, side);
+            const float edge_length = glm_vec3_norm(edge);
+            if (edge_length == 0.0f) continue;
+            glm_vec3_scale(side, 1.0f / edge_length, side);
+
+            const double border[4] = {side[0], side[1], side[2],
+                                      -glm_vec3_dot(side, (float*)start)};
+            const double weight =
+                edge_length * edge_length * MESH_LOD_BORDER_WEIGHT;
+            AddPlane_(&simplifier->quadrics[a], border, weight);
+            AddPlane_(&simplifier->quadrics[b], border, weight);
+        }
+    }
+}
+
+/**
+ * @brief Check whether one vertex may collapse onto another, following
+ * the rules of @ref vertex_kind_t.
+ */
+static bool CanCollapse_(const simplifier_t* simplifier, uint32_t from,
+                         uint32_t to)
+{
+    const uint32_t a = simplifier->roots[from], b = simplifier->roots[to];
+    if (a == b || simplifier->kinds[a] == vertex_locked) return false;
+    if (simplifier->kinds[a] == vertex_manifold) return true;
+
+    return simplifier->kinds[b] != vertex_manifold &&
+           (CountEdges_(simplifier, a, b, NULL) == 0 ||
+            CountEdges_(simplifier, b, a, NULL) == 0);
+}
+
+/**
+ * @brief Get the mean squared error of moving a vertex onto another.
+ */
+static float Cost_(const simplifier_t* simplifier, uint32_t from,
+                   uint32_t to)
+{
+    const quadric_t* a = &simplifier->quadrics[simplifier->roots[from]];
+    const quadric_t* b = &simplifier->quadrics[simplifier->roots[to]];
+    const float* position = simplifier->vertices[to].position;
+
+    const double weight = a->weight + b->weight;
+    if (weight == 0.0) return 0.0f;
+    const double error =
+        (Evaluate_(a, position) + Evaluate_(b, position)) / weight;
+    return error > 0.0 ? (float)error : 0.0f;
+}
+
+/**
+ * @brief Order collapses by ascending cost.
+ */
+static int CompareCollapses_(const void* a, const void* b)
+{
+    const float cost_a = ((const collapse_t*)a)->cost,
+                cost_b = ((const collapse_t*)b)->cost;
+    return (cost_a > cost_b) - (cost_a < cost_b);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Check whether moving a vertex onto another would turn any of the
+ * triangles around it over. Triangles that would collapse are skipped.
+ *
+ * PARAMETERS
+ *
+ * @param simplifier The simplifier, whose adjacency is current.
+ * @param from The vertex to move.
+ * @param to The vertex to move it onto.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not any triangle would flip.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool Flips_(const simplifier_t* simplifier, uint32_t from,
+                   uint32_t to)
+{
+    const uint32_t a = simplifier->roots[from], b = simplifier->roots[to];
+    for (size_t i = simplifier->offsets[a]; i < simplifier->offsets[a + 1];
+         i++)
+    {
+        const uint32_t triangle = simplifier->adjacency[i];
+        float* corners[3];
+        size_t moved = 0;
+        bool collapses = false;
+        for (size_t j = 0; j < 3; j++)
+        {
+            const uint32_t vertex =
+                simplifier->triangles[triangle * 3 + j];
+            corners[j] = (float*)simplifier->vertices[vertex].position;
+            if (simplifier->roots[vertex] == a) moved = j;
+            if (simplifier->roots[vertex] == b) collapses = true;
+        }
+        if (collapses) continue;
+
+        vec3 ab, ac, before, after;
+        glm_vec3_sub(corners[1], corners[0], ab);
+        glm_vec3_sub(corners[2], corners[0], ac);
+        glm_vec3_cross(ab, ac, before);
+
+        corners[moved] = (float*)simplifier->vertices[to].position;
+        glm_vec3_sub(corners[1], corners[0], ab);
+        glm_vec3_sub(corners[2], corners[0], ac);
+        glm_vec3_cross(ab, ac, after);
+
+        if (glm_vec3_dot(before, after) <= 0.0f) return true;
+    }
+    return false;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Run one pass of edge collapses. Every allowed collapse is
+ * gathered and sorted by cost, then applied cheapest first, skipping any
+ * that touch a vertex already changed this pass, until the target is
+ * reached or the costs exceed the limit. Collapsed triangles are then
+ * dropped.
+ *
+ * PARAMETERS
+ *
+ * @param simplifier The simplifier.
+ * @param target The amount of triangles to aim for.
+ * @param limit The highest cost to accept.
+ * @param error The largest error of any collapse so far. This is
+ * updated.
+ *
+ * RETURN VALUE
+ *
+ * @return The amount of collapses applied.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static size_t Pass_(simplifier_t* simplifier, size_t target, float limit,
+                    float* error)
+{
+    BuildAdjacency_(simplifier);
+
+    // Only the cheaper direction of each edge is worth trying. Edges
+    // between manifold vertices always have a twin, so they're only
+    // looked at from one side.
+    size_t count = 0;
+    for (size_t i = 0; i < simplifier->triangle_count; i++)
+    {
+        for (size_t j = 0; j < 3; j++)
+        {
+            const uint32_t u = simplifier->triangles[i * 3 + j],
+                           v = simplifier->triangles[i * 3 + (j + 1) % 3];
+            const uint32_t a = simplifier->roots[u],
+                           b = simplifier->roots[v];
+            if (a > b && simplifier->kinds[a] == vertex_manifold &&
+                simplifier->kinds[b] == vertex_manifold)
+                continue;
+
+            collapse_t best = {0, 0, limit};
+            bool found = false;
+            const uint32_t ends[2][2] = {{u, v}, {v, u}};
+            for (size_t k = 0; k < 2; k++)
+            {
+                if (!CanCollapse_(simplifier, ends[k][0], ends[k][1]))
+                    continue;
+                const float cost =
+                    Cost_(simplifier, ends[k][0], ends[k][1]);
+                if (cost > best.cost) continue;
+                best = (collapse_t){ends[k][0], ends[k][1], cost};
+                found = true;
+            }
+            if (found) simplifier->collapses[count++] = best;
+        }
+    }
+    qsort(simplifier->collapses, count, sizeof(collapse_t),
+          CompareCollapses_);
+
+    (void)memset(simplifier->touched, 0, simplifier->vertex_count);
+    for (uint32_t i = 0; i < simplifier->vertex_count; i++)
+        simplifier->remap[i] = i;
+
+    // Each collapse removes two triangles, or one along a border.
+    const size_t needed = simplifier->triangle_count - target;
+    size_t applied = 0, removed = 0;
+    for (size_t i = 0; i < count && removed < needed; i++)
+    {
+        const collapse_t* collapse = &simplifier->collapses[i];
+        const uint32_t a = simplifier->roots[collapse->from],
+                       b = simplifier->roots[collapse->to];
+        if (simplifier->touched[a] || simplifier->touched[b] ||
+            Flips_(simplifier, collapse->from, collapse->to))
+            continue;
+
+        // The whole ring is marked, so later flip checks this pass never
+        // see a triangle that has already moved.
+        for (size_t j = simplifier->offsets[a];
+             j < simplifier->offsets[a + 1]; j++)
+            for (size_t k = 0; k < 3; k++)
+                simplifier->touched[Corner_(
+                    simplifier, simplifier->adjacency[j], k)] = 1;
+        simplifier->touched[b] = 1;
+
+        simplifier->remap[collapse->from] = collapse->to;
+        AddQuadric_(&simplifier->quadrics[b], &simplifier->quadrics[a]);
+        const float distance = sqrtf(collapse->cost);
+        if (distance > *error) *error = distance;
+
+        applied++;
+        removed += simplifier->kinds[a] == vertex_border ? 1 : 2;
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < simplifier->triangle_count; i++)
+    {
+        uint32_t* triangle = &simplifier->triangles[i * 3];
+        const uint32_t corners[3] = {simplifier->remap[triangle[0]],
+                                     simplifier->remap[triangle[1]],
+                                     simplifier->remap[triangle[2]]};
+        const uint32_t a = simplifier->roots[corners[0]],
+                       b = simplifier->roots[corners[1]],
+                       c = simplifier->roots[corners[2]];
+        if (a == b || b == c || a == c) continue;
+
+        (void)memcpy(&simplifier->triangles[kept * 3], corners,
+                     sizeof(corners));
+        simplifier->tags[kept++] = simplifier->tags[i];
+    }
+    simplifier->triangle_count = kept;
+    return applied;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Append the live triangles to the chain's indices as a new level,
+ * grouped by submesh.
+ *
+ * PARAMETERS
+ *
+ * @param simplifier The simplifier.
+ * @param mesh The mesh being simplified.
+ * @param chain The chain's indices so far. This may be reallocated.
+ * @param chain_size The amount of indices in the chain. This is updated.
+ * @param lods The level's runs, one per submesh.
+ * @param error The error of the level.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void EmitLevel_(const simplifier_t* simplifier, const mesh_t* mesh,
+                       uint32_t** chain, size_t* chain_size,
+                       mesh_lod_t* lods, float error)
+{
+    const size_t first = mesh->index_count + *chain_size;
+    *chain_size += simplifier->triangle_count * 3;
+    const size_t size = *chain_size * sizeof(uint32_t);
+    *chain = *chain == NULL ? LetoMalloc(memory_meshes, size)
+                            : LetoRealloc(*chain, size);
+
+    for (size_t i = 0; i < mesh->submesh_count; i++)
+        lods[i] = (mesh_lod_t){0, 0, error};
+    for (size_t i = 0; i < simplifier->triangle_count; i++)
+        lods[simplifier->tags[i]].index_count += 3;
+
+    size_t cursor = first;
+    for (size_t i = 0; i < mesh->submesh_count; i++)
+    {
+        lods[i].first_index = cursor;
+        cursor += lods[i].index_count;
+    }
+
+    // A stable counting sort, so each submesh keeps the vertex cache
+    // order its triangles had.
+    size_t* cursors =
+        LetoMalloc(memory_meshes, mesh->submesh_count * sizeof(size_t));
+    for (size_t i = 0; i < mesh->submesh_count; i++)
+        cursors[i] = lods[i].first_index - mesh->index_count;
+    for (size_t i = 0; i < simplifier->triangle_count; i++)
+    {
+        size_t* target = &cursors[simplifier->tags[i]];
+        (void)memcpy(*chain + *target, &simplifier->triangles[i * 3],
+                     3 * sizeof(uint32_t));
+        *target += 3;
+    }
+    LetoFree(cursors);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Set up a simplifier over the full-detail triangles of a mesh.
+ * Triangles that are already degenerate are left out.
+ *
+ * PARAMETERS
+ *
+ * @param simplifier The simplifier to set up.
+ * @param mesh The mesh.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void CreateSimplifier_(simplifier_t* simplifier, const mesh_t* mesh)
+{
+    const size_t vertex_count = mesh->vertex_count,
+                 triangle_count = mesh->index_count / 3;
+    *simplifier = (simplifier_t){
+        .vertices = mesh->vertices,
+        .vertex_count = vertex_count,
+        .roots =
+            LetoMalloc(memory_meshes, vertex_count * sizeof(uint32_t)),
+        .kinds = LetoMalloc(memory_meshes, vertex_count),
+        .quadrics =
+            LetoCalloc(memory_meshes, vertex_count, sizeof(quadric_t)),
+        .triangles = LetoMalloc(memory_meshes,
+                                triangle_count * 3 * sizeof(uint32_t)),
+        .tags =
+            LetoMalloc(memory_meshes, triangle_count * sizeof(uint32_t)),
+        .offsets = LetoMalloc(memory_meshes,
+                              (vertex_count + 1) * sizeof(uint32_t)),
+        .adjacency = LetoMalloc(memory_meshes,
+                                triangle_count * 3 * sizeof(uint32_t)),
+        .remap =
+            LetoMalloc(memory_meshes, vertex_count * sizeof(uint32_t)),
+        .touched = LetoMalloc(memory_meshes, vertex_count),
+        .collapses = LetoMalloc(memory_meshes,
+                                triangle_count * 3 * sizeof(collapse_t))};
+    FindRoots_(simplifier);
+
+    for (uint32_t i = 0; i < mesh->submesh_count; i++)
+    {
+        const mesh_submesh_t* submesh = &mesh->submeshes[i];
+        for (size_t j = submesh->first_index;
+             j < submesh->first_index + submesh->index_count; j += 3)
+        {
+            uint32_t* triangle =
+                &simplifier->triangles[simplifier->triangle_count * 3];
+            for (size_t k = 0; k < 3; k++)
+                triangle[k] =
+                    mesh->index_size == sizeof(uint32_t)
+                        ? ((const uint32_t*)mesh->indices)[j + k]
+                        : ((const uint16_t*)mesh->indices)[j + k];
+
+            const uint32_t a = simplifier->roots[triangle[0]],
+                           b = simplifier->roots[triangle[1]],
+                           c = simplifier->roots[triangle[2]];
+            if (a == b || b == c || a == c) continue;
+            simplifier->tags[simplifier->triangle_count++] = i;
+        }
+    }
+}
+
+/**
+ * @brief Free everything a simplifier owns.
+ */
+static void DestroySimplifier_(simplifier_t* simplifier)
+{
+    LetoFree(simplifier->roots);
+    LetoFree(simplifier->kinds);
+    LetoFree(simplifier->quadrics);
+    LetoFree(simplifier->triangles);
+    LetoFree(simplifier->tags);
+    LetoFree(simplifier->offsets);
+    LetoFree(simplifier->adjacency);
+    LetoFree(simplifier->remap);
+    LetoFree(simplifier->touched);
+    LetoFree(simplifier->collapses);
+}
+
+/**
+ * @brief Get the length of the diagonal of the box bounding a mesh.
+ */
+static float Diagonal_(const mesh_t* mesh)
+{
+    vec3 minimum, maximum;
+    glm_vec3_copy((float*)mesh->vertices[0].position, minimum);
+    glm_vec3_copy((float*)mesh->vertices[0].position, maximum);
+    for (size_t i = 1; i < mesh->vertex_count; i++)
+    {
+        glm_vec3_minv(minimum, (float*)mesh->vertices[i].position,
+                      minimum);
+        glm_vec3_maxv(maximum, (float*)mesh->vertices[i].position,
+                      maximum);
+    }
+    return glm_vec3_distance(minimum, maximum);
+}
+
+void LetoGenerateLODs(mesh_t* mesh, size_t level_count, float ratio)
+{
+    if (mesh == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+    if (!(ratio > 0.0f && ratio < 1.0f))
+    {
+        LetoReport(invalid_param);
+        return;
+    }
+    if (mesh->lods != NULL || mesh->submesh_count == 0 ||
+        mesh->index_count == 0 || level_count < 2)
+        return;
+
+    simplifier_t simplifier;
+    CreateSimplifier_(&simplifier, mesh);
+    BuildAdjacency_(&simplifier);
+    Classify_(&simplifier);
+    BuildQuadrics_(&simplifier);
+
+    const float limit_distance = MESH_LOD_MAX_ERROR * Diagonal_(mesh);
+    const float limit = limit_distance * limit_distance;
+
+    const size_t submesh_count = mesh->submesh_count;
+    mesh_lod_t* lods = LetoMalloc(memory_meshes, level_count *
+                                                     submesh_count *
+                                                     sizeof(mesh_lod_t));
+    for (size_t i = 0; i < submesh_count; i++)
+        lods[i] = (mesh_lod_t){mesh->submeshes[i].first_index,
+                               mesh->submeshes[i].index_count, 0.0f};
+
+    uint32_t* chain = NULL;
+    size_t chain_size = 0, levels = 1;
+    size_t previous = simplifier.triangle_count;
+    float error = 0.0f;
+    while (levels < level_count)
+    {
+        const size_t target = (size_t)((float)previous * ratio);
+        while (simplifier.triangle_count > target)
+            if (Pass_(&simplifier, target, limit, &error) == 0) break;
+
+        // A level that barely differs from the last isn't worth its
+        // memory, and means the error limit has been reached.
+        if (simplifier.triangle_count == 0 ||
+            simplifier.triangle_count * 10 > previous * 9)
+            break;
+
+        EmitLevel_(&simplifier, mesh, &chain, &chain_size,
+                   &lods[levels * submesh_count], error);
+        previous = simplifier.triangle_count;
+        levels++;
+    }
+    DestroySimplifier_(&simplifier);
+
+    if (levels == 1)
+    {
+        LetoFree(lods);
+        return;
+    }
+
+    const size_t index_count = mesh->index_count + chain_size;
+    mesh->indices =
+        LetoRealloc(mesh->indices, index_count * mesh->index_size);
+    for (size_t i = 0; i < chain_size; i++)
+    {
+        if (mesh->index_size == sizeof(uint32_t))
+            ((uint32_t*)mesh->indices)[mesh->index_count + i] = chain[i];
+        else
+            ((uint16_t*)mesh->indices)[mesh->index_count + i] =
+                (uint16_t)chain[i];
+    }
+    LetoFree(chain);
+
+    mesh->index_count = index_count;
+    mesh->lods = lods;
+    mesh->lod_count = levels;
+}
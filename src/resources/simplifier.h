@@ -0,0 +1,94 @@
+/**
+ * @file Simplifier.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the quadric error metric simplifier that builds the LOD
+ * chain of every imported mesh. Simplification only ever collapses edges
+ * onto existing vertices, so every level draws from the same vertex
+ * buffer as the full-detail mesh.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__SIMPLIFIER__
+#define __LETO__SIMPLIFIER__
+
+// Imported meshes.
+#include <resources/meshes.h>
+
+/**
+ * @brief The most levels an imported mesh's LOD chain is given, counting
+ * full detail.
+ */
+#define MESH_LOD_LEVELS 5
+
+/**
+ * @brief The fraction of its previous level's triangles each level of an
+ * imported mesh's LOD chain aims for.
+ */
+#define MESH_LOD_RATIO 0.5f
+
+/**
+ * @brief The largest error any level may have, as a fraction of the
+ * diagonal of the mesh's bounds. Past this, shapes stop being
+ * recognizable, so the chain ends early.
+ */
+#define MESH_LOD_MAX_ERROR 0.05f
+
+/**
+ * @brief How heavily the planes holding borders in place are weighted
+ * against the mesh's own surface. Higher values keep open edges, like the
+ * sides of a road, closer to where they were.
+ */
+#define MESH_LOD_BORDER_WEIGHT 10.0f
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Build a mesh's LOD chain with quadric error metric edge
+ * collapses (Garland & Heckbert, "Surface Simplification Using Quadric
+ * Error Metrics"). Each level starts from the previous one, and the
+ * chain ends early once a level can't shed a tenth of its triangles
+ * within @ref MESH_LOD_MAX_ERROR. Vertices on an attribute seam, on a
+ * boundary between submeshes, or on non-manifold geometry never move,
+ * and vertices on an open border only slide along it, so lower levels
+ * keep their UV layout and never crack along material boundaries. The
+ * new indices are appended to the mesh's own, and the chain is stored
+ * in @ref mesh_t::lods.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh to simplify. Meshes that already have a chain are
+ * left alone.
+ * @param level_count The most levels to give the mesh, counting full
+ * detail.
+ * @param ratio The fraction of its previous level's triangles each level
+ * aims for, between 0 and 1.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If the mesh is NULL, this warning is thrown and
+ * nothing is done.
+ * @warning invalid_param -- If the ratio isn't between 0 and 1, this
+ * warning is thrown and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoGenerateLODs(mesh_t* mesh, size_t level_count, float ratio);
+
+#endif // __LETO__SIMPLIFIER__
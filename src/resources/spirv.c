@@ -0,0 +1,106 @@
+/**
+ * @file Spirv.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Spirv.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "spirv.h"                  // Public interface parent
+#include <gl.h>                     // OpenGL function pointers
+#include <io/files.h>               // File mapping
+#include <io/reporter.h>            // Error / warning reporter
+#include <resources/preprocessor.h> // Keyword count
+#include <utilities/macros.h>       // Path length
+#include <utilities/memory.h>       // Tracked allocations
+#include <utilities/strings.h>      // String creation
+
+/**
+ * @brief Whether or not the driver's support for SPIR-V has been looked
+ * for yet.
+ */
+static bool spirv_checked = false;
+
+/**
+ * @brief Whether or not the driver takes SPIR-V modules.
+ */
+static bool spirv_supported = false;
+
+bool LetoSpirvSupported(void)
+{
+    if (spirv_checked) return spirv_supported;
+    spirv_checked = true;
+
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_SHADER_BINARY_FORMATS, &count);
+    if (count <= 0) return false;
+
+    GLint* formats =
+        LetoMalloc(memory_shaders, (size_t)count * sizeof(GLint));
+    glGetIntegerv(GL_SHADER_BINARY_FORMATS, formats);
+    for (GLint i = 0; i < count && !spirv_supported; i++)
+        spirv_supported = formats[i] == GL_SHADER_BINARY_FORMAT_SPIR_V;
+    LetoFree(formats);
+    return spirv_supported;
+}
+
+unsigned int LetoLoadSpirvStage(const char* name, const char* file,
+                                unsigned int type, uint32_t permutation)
+{
+    if (name == NULL || file == NULL)
+    {
+        LetoReport(null_param);
+        return 0;
+    }
+    if (!LetoSpirvSupported()) return 0;
+
+    // Shaders built without the SPIR-V target simply have no modules.
+    char* path = LetoStringCreate(MAX_PATH_LENGTH, SPIRV_PATH, name, file);
+    mapping_t mapping;
+    const bool mapped =
+        LetoFileExists(path) && LetoMapFile(path, &mapping);
+    LetoStringFree(&path);
+    if (!mapped) return 0;
+
+    GLuint stage = 0;
+    if (mapping.size >= sizeof(uint32_t) && mapping.size % 4 == 0 &&
+        *(const uint32_t*)mapping.data == SPIRV_MAGIC)
+    {
+        stage = glCreateShader(type);
+        glShaderBinary(1, &stage, GL_SHADER_BINARY_FORMAT_SPIR_V,
+                       mapping.data, (GLsizei)mapping.size);
+    }
+    LetoUnmapFile(&mapping);
+    if (stage == 0) return 0;
+
+    GLuint indices[SHADER_KEYWORD_COUNT];
+    GLuint values[SHADER_KEYWORD_COUNT];
+    GLuint count = 0;
+    for (GLuint i = 0; i < SHADER_KEYWORD_COUNT; i++)
+    {
+        if (!(permutation & (1u << i))) continue;
+        indices[count] = i;
+        values[count++] = GL_TRUE;
+    }
+
+    // Specializing is what stands in for compiling, and unlike a compile
+    // it's cheap enough to check straight away.
+    glSpecializeShader(stage, "main", count, indices, values);
+    GLint specialized = GL_FALSE;
+    glGetShaderiv(stage, GL_COMPILE_STATUS, &specialized);
+    if (!specialized)
+    {
+        glDeleteShader(stage);
+        return 0;
+    }
+    return stage;
+}
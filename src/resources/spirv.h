@@ -0,0 +1,85 @@
+/**
+ * @file Spirv.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the loading of shader stages precompiled to SPIR-V.
+ * The LetoShaders build target compiles every stage in rss/shaders ahead
+ * of time, so on drivers that take SPIR-V modules (GL 4.6, or
+ * GL_ARB_gl_spirv) a stage only needs specializing rather than compiling
+ * from GLSL. Keywords reach a module as specialization constants, the ID
+ * of each being the bit index of its keyword, rather than as defines; see
+ * rss/shaders/include/keywords.glsl. Modules keep their debug names, but
+ * a driver needn't report them, so reflecting a program built from
+ * modules may not find its resources by id on every driver.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__SPIRV__
+#define __LETO__SPIRV__
+
+// The boolean type as described by the C standard.
+#include <stdbool.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+
+/**
+ * @brief The path of a stage's SPIR-V module, formatted with the name of
+ * its shader's folder and the name of its GLSL file.
+ */
+#define SPIRV_PATH ASSET_DIR "/shaders/%s/%s.spv"
+
+/**
+ * @brief The first word of every SPIR-V module.
+ */
+#define SPIRV_MAGIC UINT32_C(0x07230203)
+
+/**
+ * @brief Check, once, whether the driver takes SPIR-V modules. A GL
+ * context must be current.
+ */
+bool LetoSpirvSupported(void);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Create a stage from its SPIR-V module and specialize it for a
+ * permutation. Each keyword of the permutation sets the specialization
+ * constant with its bit index to true; a module with no such constant
+ * can't express that permutation, and fails to specialize.
+ *
+ * PARAMETERS
+ *
+ * @param name The name of the shader's folder.
+ * @param file The name of the stage's GLSL file, like "vert.vs".
+ * @param type The GL type of the stage, like GL_VERTEX_SHADER.
+ * @param permutation The keywords to specialize the stage with.
+ *
+ * RETURN VALUE
+ *
+ * @return The specialized stage, or 0 if the driver doesn't take SPIR-V,
+ * the stage has no module, or it failed to specialize. The caller should
+ * then compile the stage from GLSL instead.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the name or file is NULL, this warning is
+ * thrown and 0 is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+unsigned int LetoLoadSpirvStage(const char* name, const char* file,
+                                unsigned int type, uint32_t permutation);
+
+#endif // __LETO__SPIRV__
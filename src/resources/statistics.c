@@ -0,0 +1,262 @@
+/**
+ * @file Statistics.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Statistics.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "statistics.h"       // Public interface parent
+#include <ctype.h>            // Isdigit, isspace
+#include <gl.h>               // OpenGL function pointers
+#include <io/reporter.h>      // Error / warning reporter
+#include <stdio.h>            // Printf
+#include <stdlib.h>           // Qsort, strtoll
+#include <string.h>           // Memcpy, strlen, strncmp
+#include <utilities/memory.h> // Tracked allocations
+
+/**
+ * @brief The name of each origin, for the report.
+ */
+static const char* const origin_names[] = {"glsl", "spirv", "binary"};
+
+/**
+ * @brief Every program build recorded so far, each allocated on its own
+ * so that builders can hold onto their statistics as the list grows.
+ */
+static shader_statistics_t** records = NULL;
+
+/**
+ * @brief The amount of records in @ref records.
+ */
+static size_t record_count = 0;
+
+/**
+ * @brief The amount of records @ref records has room for.
+ */
+static size_t record_capacity = 0;
+
+/**
+ * @brief Append a driver log to a program's logs under a heading, if the
+ * log isn't empty.
+ */
+static void AppendLog_(shader_statistics_t* statistics,
+                       const char* heading, const char* log, size_t length)
+{
+    while (length > 0 && isspace((unsigned char)log[length - 1])) length--;
+    if (length == 0) return;
+
+    const size_t size =
+        statistics->log != NULL ? strlen(statistics->log) : 0;
+    const size_t heading_length = strlen(heading);
+    const size_t new_size = size + heading_length + length + 4;
+    statistics->log = statistics->log == NULL
+                          ? LetoMalloc(memory_shaders, new_size)
+                          : LetoRealloc(statistics->log, new_size);
+
+    char* cursor = statistics->log + size;
+    if (size > 0) *cursor++ = '\n';
+    (void)memcpy(cursor, heading, heading_length);
+    cursor += heading_length;
+    *cursor++ = ':';
+    *cursor++ = '\n';
+    (void)memcpy(cursor, log, length);
+    cursor[length] = 0;
+}
+
+/**
+ * @brief Find the largest instruction count written in a log, as "123
+ * instructions" or "123 inst", or -1 if it holds none. Drivers that
+ * write them at all write one per stage, or one per compiled width.
+ */
+static int64_t ParseInstructions_(const char* log)
+{
+    int64_t instructions = -1;
+    for (const char* cursor = log; *cursor != 0; cursor++)
+    {
+        if (!isdigit((unsigned char)*cursor) ||
+            (cursor != log && isdigit((unsigned char)cursor[-1])))
+            continue;
+
+        char* end;
+        const long long count = strtoll(cursor, &end, 10);
+        while (*end == ' ') end++;
+        if (strncmp(end, "inst", 4) == 0 && count > instructions)
+            instructions = count;
+    }
+    return instructions;
+}
+
+/**
+ * @brief Get the total time a build took.
+ */
+static uint64_t TotalTime_(const shader_statistics_t* statistics)
+{
+    uint64_t total = statistics->link_ns;
+    for (size_t i = 0; i < SHADER_MAX_STAGES; i++)
+        total += statistics->compile_ns[i];
+    return total;
+}
+
+/**
+ * @brief Order records from the slowest build to the fastest.
+ */
+static int CompareTime_(const void* first, const void* second)
+{
+    const uint64_t first_time =
+        TotalTime_(*(const shader_statistics_t* const*)first);
+    const uint64_t second_time =
+        TotalTime_(*(const shader_statistics_t* const*)second);
+    return (first_time < second_time) - (first_time > second_time);
+}
+
+shader_statistics_t* LetoCreateShaderStatistics(const char* name,
+                                                const char* stage,
+                                                uint32_t permutation,
+                                                shader_origin_t origin)
+{
+    if (record_count == record_capacity)
+    {
+        record_capacity = record_capacity == 0 ? 16 : record_capacity * 2;
+        const size_t size = record_capacity * sizeof(shader_statistics_t*);
+        records = records == NULL ? LetoMalloc(memory_shaders, size)
+                                  : LetoRealloc(records, size);
+    }
+
+    shader_statistics_t* statistics =
+        LetoMalloc(memory_shaders, sizeof(shader_statistics_t));
+    *statistics = (shader_statistics_t){.name = name,
+                                        .stage = stage,
+                                        .permutation = permutation,
+                                        .origin = origin,
+                                        .instructions = -1};
+    records[record_count++] = statistics;
+    return statistics;
+}
+
+void LetoCompleteShaderStatistics(shader_statistics_t* statistics,
+                                  unsigned int program,
+                                  const unsigned int* stages,
+                                  const shader_reflection_t* reflection)
+{
+    if (statistics == NULL || reflection == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    GLint length = 0;
+    for (size_t i = 0; stages != NULL && i < SHADER_MAX_STAGES; i++)
+    {
+        if (stages[i] == 0) continue;
+        glGetShaderiv(stages[i], GL_INFO_LOG_LENGTH, &length);
+        if (length <= 1) continue;
+
+        char* log = LetoMalloc(memory_shaders, (size_t)length);
+        glGetShaderInfoLog(stages[i], length, &length, log);
+        AppendLog_(statistics, LetoGetShaderStageFile(i), log,
+                   (size_t)length);
+        LetoFree(log);
+    }
+
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+    if (length > 1)
+    {
+        char* log = LetoMalloc(memory_shaders, (size_t)length);
+        glGetProgramInfoLog(program, length, &length, log);
+        AppendLog_(statistics, "link", log, (size_t)length);
+        LetoFree(log);
+    }
+
+    GLint binary_size = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &binary_size);
+    statistics->binary_size = binary_size > 0 ? (size_t)binary_size : 0;
+    statistics->uniforms = reflection->counts[resource_uniform];
+    if (statistics->log != NULL)
+        statistics->instructions = ParseInstructions_(statistics->log);
+}
+
+shader_statistics_t* LetoFindShaderStatistics(unsigned int program)
+{
+    // Builds are looked for while they're finished, which is soon after
+    // they started, so the search starts from the latest.
+    for (size_t i = record_count; i > 0; i--)
+        if (records[i - 1]->program == program) return records[i - 1];
+    return NULL;
+}
+
+void LetoReportShaderStatistics(void)
+{
+    if (record_count == 0) return;
+
+    shader_statistics_t** sorted =
+        LetoMalloc(memory_shaders, record_count * sizeof(*sorted));
+    (void)memcpy(sorted, records, record_count * sizeof(*sorted));
+    qsort(sorted, record_count, sizeof(*sorted), CompareTime_);
+
+    printf("\n%-16s %10s %-8s %8s %12s %10s %-6s %8s %8s %6s\n", "shader",
+           "perm", "stage", "source", "compile(ms)", "link(ms)", "origin",
+           "uniforms", "binary", "inst");
+    for (size_t i = 0; i < record_count; i++)
+    {
+        const shader_statistics_t* statistics = sorted[i];
+        bool first = true;
+        // Each stage gets a row, and the first also carries everything
+        // that belongs to the whole program.
+        for (size_t j = 0; j < SHADER_MAX_STAGES; j++)
+        {
+            if (statistics->source_size[j] == 0) continue;
+            if (!first)
+            {
+                printf("%-16s %10s %-8s %8zu %12.3f\n", "", "",
+                       LetoGetShaderStageFile(j),
+                       statistics->source_size[j],
+                       (double)statistics->compile_ns[j] / 1e6);
+                continue;
+            }
+
+            printf("%-16s %#10x %-8s %8zu %12.3f %10.3f %-6s %8zu %8zu ",
+                   statistics->name, statistics->permutation,
+                   LetoGetShaderStageFile(j),
+                   statistics->source_size[j],
+                   (double)statistics->compile_ns[j] / 1e6,
+                   (double)statistics->link_ns / 1e6,
+                   origin_names[statistics->origin], statistics->uniforms,
+                   statistics->binary_size);
+            if (statistics->instructions < 0) printf("%6s\n", "-");
+            else printf("%6lld\n", (long long)statistics->instructions);
+            first = false;
+        }
+    }
+
+    for (size_t i = 0; i < record_count; i++)
+    {
+        if (sorted[i]->log == NULL) continue;
+        printf("\n%s %#x%s%s\n%s\n", sorted[i]->name,
+               sorted[i]->permutation, sorted[i]->stage != NULL ? " " : "",
+               sorted[i]->stage != NULL ? sorted[i]->stage : "",
+               sorted[i]->log);
+    }
+    LetoFree(sorted);
+}
+
+void LetoFreeShaderStatistics(void)
+{
+    for (size_t i = 0; i < record_count; i++)
+    {
+        LetoFree(records[i]->log);
+        LetoFree(records[i]);
+    }
+    LetoFree(records);
+    records = NULL;
+    record_count = record_capacity = 0;
+}
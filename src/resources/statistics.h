@@ -0,0 +1,196 @@
+/**
+ * @file Statistics.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the statistics recorded for every program Leto builds,
+ * whether a whole shader or a separable stage, and a report of them
+ * sorted by how long each took. Compiles and links are timed by the time
+ * spent issuing them plus the time spent waiting on their results; a
+ * driver compiling in the background overlaps the rest with other work,
+ * so times are what loading actually waited for rather than the driver's
+ * full effort.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__STATISTICS__
+#define __LETO__STATISTICS__
+
+// Standard macro definitions, like size_t.
+#include <stddef.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+// Stage counts and reflection.
+#include <resources/shaders.h>
+
+/**
+ * @brief Where a program was built from.
+ */
+typedef enum
+{
+    /**
+     * @brief Compiled from GLSL, as on a cache miss.
+     */
+    shader_origin_glsl,
+    /**
+     * @brief Specialized from precompiled SPIR-V modules.
+     */
+    shader_origin_spirv,
+    /**
+     * @brief Loaded from its cached binary, a cache hit.
+     */
+    shader_origin_binary
+} shader_origin_t;
+
+/**
+ * @brief The statistics of a single program build.
+ */
+typedef struct
+{
+    /**
+     * @brief The interned name of the shader's folder.
+     */
+    const char* name;
+    /**
+     * @brief The file name of the stage if the program is a separable
+     * stage, and NULL if it's a whole shader.
+     */
+    const char* stage;
+    uint32_t permutation;
+    /**
+     * @brief The program built, or 0 until there is one.
+     */
+    unsigned int program;
+    shader_origin_t origin;
+    /**
+     * @brief The preprocessed size of each stage in bytes, 0 for stages
+     * the program doesn't have.
+     */
+    size_t source_size[SHADER_MAX_STAGES];
+    /**
+     * @brief The time spent on each stage's compile in nanoseconds, see
+     * @file Statistics.h. SPIR-V stages count their specializing.
+     */
+    uint64_t compile_ns[SHADER_MAX_STAGES];
+    /**
+     * @brief The time spent on the program's link in nanoseconds, or on
+     * loading its binary.
+     */
+    uint64_t link_ns;
+    /**
+     * @brief The amount of active uniforms in the default block.
+     */
+    size_t uniforms;
+    /**
+     * @brief The size of the program's binary in bytes, the closest
+     * measure of its cost every driver gives, or 0 if it gave none.
+     */
+    size_t binary_size;
+    /**
+     * @brief The instruction count of the program's largest stage, or -1
+     * if the driver didn't write one into its logs.
+     */
+    int64_t instructions;
+    /**
+     * @brief The driver's compile and link logs, or NULL if they were
+     * empty.
+     */
+    char* log;
+} shader_statistics_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Start the statistics of a program build. Its timings and sizes
+ * are filled in by whoever builds the program, and the rest by @ref
+ * LetoCompleteShaderStatistics once it's linked.
+ *
+ * PARAMETERS
+ *
+ * @param name The interned name of the shader's folder.
+ * @param stage The file name of the separable stage being built, or NULL
+ * for a whole shader.
+ * @param permutation The shader's permutation.
+ * @param origin Where the program is built from.
+ *
+ * RETURN VALUE
+ *
+ * @return The statistics, which are kept until @ref
+ * LetoFreeShaderStatistics.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+shader_statistics_t* LetoCreateShaderStatistics(const char* name,
+                                                const char* stage,
+                                                uint32_t permutation,
+                                                shader_origin_t origin);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Fill in what can be asked of a linked program: the logs of its
+ * stages and link, its binary size, its uniform count and, if the driver
+ * wrote one into those logs, its instruction count. The stages must not
+ * have been deleted yet.
+ *
+ * PARAMETERS
+ *
+ * @param statistics The program's statistics.
+ * @param program The linked program.
+ * @param stages The @ref SHADER_MAX_STAGES stages the program was built
+ * from, 0 for those it doesn't have, or NULL for a cached binary.
+ * @param reflection The program's reflection.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the statistics or reflection are NULL, this
+ * warning is thrown and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoCompleteShaderStatistics(shader_statistics_t* statistics,
+                                  unsigned int program,
+                                  const unsigned int* stages,
+                                  const shader_reflection_t* reflection);
+
+/**
+ * @brief Find the statistics of the latest build of a program, or NULL
+ * if it has none. Program IDs are reused once deleted, so only the
+ * latest build is ever found.
+ */
+shader_statistics_t* LetoFindShaderStatistics(unsigned int program);
+
+/**
+ * @brief Print the statistics of every program built so far, slowest
+ * first, followed by every non-empty driver log.
+ */
+void LetoReportShaderStatistics(void);
+
+/**
+ * @brief Free the statistics of every program built so far.
+ */
+void LetoFreeShaderStatistics(void);
+
+#endif // __LETO__STATISTICS__
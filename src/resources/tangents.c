@@ -0,0 +1,387 @@
+/**
+ * @file Tangents.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Tangents.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "tangents.h"         // Public interface parent
+#include <float.h>            // Float limits
+#include <io/reporter.h>      // Error / warning reporter
+#include <math.h>             // Acosf
+#include <string.h>           // Memset
+#include <utilities/memory.h> // Tracked allocations
+
+/**
+ * @brief The amount of triangles worked on at once, one per lane of a
+ * cglm vec4.
+ */
+#define LANES 4
+
+/**
+ * @brief The handedness of a corner whose triangle has no area in texture
+ * space, and so no tangent of its own.
+ */
+#define DEGENERATE 2
+
+/**
+ * @brief A 3D vector for each of @ref LANES triangles, with each
+ * component in its own vec4 so cglm's SIMD routines work on every
+ * triangle at once.
+ */
+typedef struct
+{
+    vec4 x;
+    vec4 y;
+    vec4 z;
+} lanes_t;
+
+/**
+ * @brief Find A - B across every lane.
+ */
+static void Subtract_(const lanes_t* a, const lanes_t* b, lanes_t* dest)
+{
+    glm_vec4_sub((float*)a->x, (float*)b->x, dest->x);
+    glm_vec4_sub((float*)a->y, (float*)b->y, dest->y);
+    glm_vec4_sub((float*)a->z, (float*)b->z, dest->z);
+}
+
+/**
+ * @brief Find the dot product of A and B across every lane.
+ */
+static void Dot_(const lanes_t* a, const lanes_t* b, vec4 dest)
+{
+    glm_vec4_mul((float*)a->x, (float*)b->x, dest);
+    glm_vec4_muladd((float*)a->y, (float*)b->y, dest);
+    glm_vec4_muladd((float*)a->z, (float*)b->z, dest);
+}
+
+/**
+ * @brief Normalize every lane, zeroing the ones too short to have a
+ * direction.
+ */
+static void Normalize_(lanes_t* vector)
+{
+    vec4 length, scale;
+    Dot_(vector, vector, length);
+    glm_vec4_sqrt(length, length);
+    for (size_t i = 0; i < LANES; i++)
+        scale[i] = length[i] > FLT_EPSILON ? 1.0f / length[i] : 0.0f;
+    glm_vec4_mul(vector->x, scale, vector->x);
+    glm_vec4_mul(vector->y, scale, vector->y);
+    glm_vec4_mul(vector->z, scale, vector->z);
+}
+
+/**
+ * @brief Project every lane onto the plane of the matching unit normal,
+ * and normalize the result.
+ */
+static void Project_(lanes_t* vector, const lanes_t* normal)
+{
+    vec4 distance;
+    Dot_(normal, vector, distance);
+    glm_vec4_negate(distance);
+    glm_vec4_muladd((float*)normal->x, distance, vector->x);
+    glm_vec4_muladd((float*)normal->y, distance, vector->y);
+    glm_vec4_muladd((float*)normal->z, distance, vector->z);
+    Normalize_(vector);
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Work out the tangents one batch of triangles contributes to
+ * their corners, and add them to the per-vertex sums.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh.
+ * @param indices The mesh's indices, widened to 32 bits.
+ * @param first The first triangle of the batch.
+ * @param count The amount of triangles in the batch, at most @ref LANES.
+ * @param sums The tangent sums, two per vertex: one for corners of each
+ * handedness.
+ * @param handedness The storage for the handedness of every corner: 0 for
+ * right-handed, 1 for left-handed, or @ref DEGENERATE.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void AccumulateBatch_(const mesh_t* mesh, const uint32_t* indices,
+                             size_t first, size_t count, vec4* sums,
+                             uint8_t* handedness)
+{
+    // Lanes past the end of the mesh repeat the batch's first triangle,
+    // and are ignored once it comes to adding them up.
+    lanes_t positions[3], normals[3];
+    vec4 u[3], v[3];
+    for (size_t i = 0; i < LANES; i++)
+    {
+        const uint32_t* triangle =
+            &indices[(first + (i < count ? i : 0)) * 3];
+        for (size_t j = 0; j < 3; j++)
+        {
+            const mesh_vertex_t* vertex = &mesh->vertices[triangle[j]];
+            positions[j].x[i] = vertex->position[0];
+            positions[j].y[i] = vertex->position[1];
+            positions[j].z[i] = vertex->position[2];
+            normals[j].x[i] = vertex->normal[0];
+            normals[j].y[i] = vertex->normal[1];
+            normals[j].z[i] = vertex->normal[2];
+            u[j][i] = vertex->texture[0];
+            v[j][i] = vertex->texture[1];
+        }
+    }
+
+    // The direction in which U grows across the triangle, scaled by its
+    // texture-space area, whose sign gives the handedness.
+    lanes_t ab, ac, tangent;
+    vec4 ab_u, ab_v, ac_u, ac_v, area;
+    Subtract_(&positions[1], &positions[0], &ab);
+    Subtract_(&positions[2], &positions[0], &ac);
+    glm_vec4_sub(u[1], u[0], ab_u);
+    glm_vec4_sub(v[1], v[0], ab_v);
+    glm_vec4_sub(u[2], u[0], ac_u);
+    glm_vec4_sub(v[2], v[0], ac_v);
+    glm_vec4_mul(ab_u, ac_v, area);
+    glm_vec4_mulsub(ab_v, ac_u, area);
+
+    glm_vec4_mul(ac_v, ab.x, tangent.x);
+    glm_vec4_mul(ac_v, ab.y, tangent.y);
+    glm_vec4_mul(ac_v, ab.z, tangent.z);
+    glm_vec4_mulsub(ab_v, ac.x, tangent.x);
+    glm_vec4_mulsub(ab_v, ac.y, tangent.y);
+    glm_vec4_mulsub(ab_v, ac.z, tangent.z);
+
+    for (size_t j = 0; j < 3; j++)
+    {
+        Normalize_(&normals[j]);
+
+        // Each corner weighs in by its angle, measured in the plane of its
+        // normal.
+        lanes_t corner = tangent, next, previous;
+        vec4 cosine;
+        Project_(&corner, &normals[j]);
+        Subtract_(&positions[(j + 1) % 3], &positions[j], &next);
+        Subtract_(&positions[(j + 2) % 3], &positions[j], &previous);
+        Project_(&next, &normals[j]);
+        Project_(&previous, &normals[j]);
+        Dot_(&next, &previous, cosine);
+        glm_vec4_clamp(cosine, -1.0f, 1.0f);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const size_t index = (first + i) * 3 + j;
+            if (area[i] == 0.0f)
+            {
+                handedness[index] = DEGENERATE;
+                continue;
+            }
+
+            // Mirrored triangles have their U direction come out
+            // backwards, so the area's sign turns it around.
+            handedness[index] = area[i] > 0.0f ? 0 : 1;
+            const float angle = acosf(cosine[i]);
+            vec4 contribution = {corner.x[i], corner.y[i], corner.z[i],
+                                 0.0f};
+            glm_vec4_muladds(contribution,
+                             handedness[index] == 0 ? angle : -angle,
+                             sums[(size_t)indices[index] * 2 +
+                                  handedness[index]]);
+        }
+    }
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Turn a vertex's summed tangent into its final tangent. A vertex
+ * no triangle gave a direction still gets one perpendicular to its
+ * normal, so the frame is never degenerate.
+ *
+ * PARAMETERS
+ *
+ * @param sum The summed tangent.
+ * @param normal The normal of the vertex.
+ * @param left_handed Whether the bitangent is flipped.
+ * @param tangent The storage for the tangent.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void FinishTangent_(vec4 sum, const vec3 normal, bool left_handed,
+                           vec4 tangent)
+{
+    glm_vec3_copy(sum, tangent);
+    if (glm_vec3_norm2(tangent) <= FLT_EPSILON)
+    {
+        vec3 unit;
+        glm_vec3_normalize_to((float*)normal, unit);
+        glm_vec3_copy(fabsf(unit[0]) < 0.9f ? GLM_XUP : GLM_YUP, tangent);
+        glm_vec3_muladds(unit, -glm_vec3_dot(unit, tangent), tangent);
+    }
+    glm_vec3_normalize(tangent);
+    tangent[3] = left_handed ? -1.0f : 1.0f;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Split every vertex used by corners of both handednesses in two,
+ * appending a copy for the left-handed corners and pointing them at it.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh, whose vertices are grown.
+ * @param indices The mesh's indices, widened to 32 bits. These are
+ * remapped.
+ * @param handedness The handedness of every corner.
+ * @param used The storage for the handednesses each vertex is used with,
+ * as a bit for each.
+ * @param twins The storage for the copy of each vertex, or UINT32_MAX for
+ * vertices that weren't split.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void SplitVertices_(mesh_t* mesh, uint32_t* indices,
+                           const uint8_t* handedness, uint8_t* used,
+                           uint32_t* twins)
+{
+    (void)memset(used, 0, mesh->vertex_count);
+    for (size_t i = 0; i < mesh->index_count; i++)
+        if (handedness[i] != DEGENERATE)
+            used[indices[i]] |= (uint8_t)(1 << handedness[i]);
+
+    size_t vertex_count = mesh->vertex_count;
+    for (size_t i = 0; i < mesh->vertex_count; i++)
+        twins[i] = used[i] == 3 ? (uint32_t)vertex_count++ : UINT32_MAX;
+    if (vertex_count == mesh->vertex_count) return;
+
+    mesh->vertices = LetoRealloc(mesh->vertices,
+                                 vertex_count * sizeof(mesh_vertex_t));
+    for (size_t i = 0; i < mesh->vertex_count; i++)
+        if (twins[i] != UINT32_MAX)
+            mesh->vertices[twins[i]] = mesh->vertices[i];
+    for (size_t i = 0; i < mesh->index_count; i++)
+        if (handedness[i] == 1 && twins[indices[i]] != UINT32_MAX)
+            indices[i] = twins[indices[i]];
+    mesh->vertex_count = vertex_count;
+}
+
+void LetoGenerateTangents(mesh_t* mesh)
+{
+    if (mesh == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+    if (mesh->tangents != NULL || mesh->lods != NULL ||
+        mesh->index_count == 0)
+        return;
+
+    bool textured = false;
+    for (size_t i = 0; i < mesh->vertex_count && !textured; i++)
+        textured = mesh->vertices[i].texture[0] != 0.0f ||
+                   mesh->vertices[i].texture[1] != 0.0f;
+    if (!textured) return;
+
+    uint32_t* indices =
+        LetoMalloc(memory_meshes, mesh->index_count * sizeof(uint32_t));
+    for (size_t i = 0; i < mesh->index_count; i++)
+        indices[i] = mesh->index_size == sizeof(uint32_t)
+                         ? ((const uint32_t*)mesh->indices)[i]
+                         : ((const uint16_t*)mesh->indices)[i];
+
+    const size_t original_count = mesh->vertex_count;
+    const size_t triangle_count = mesh->index_count / 3;
+    vec4* sums =
+        LetoCalloc(memory_meshes, original_count * 2, sizeof(vec4));
+    uint8_t* handedness = LetoMalloc(memory_meshes, mesh->index_count);
+    for (size_t i = 0; i < triangle_count; i += LANES)
+        AccumulateBatch_(mesh, indices, i,
+                         triangle_count - i < LANES ? triangle_count - i
+                                                    : LANES,
+                         sums, handedness);
+
+    uint8_t* used = LetoMalloc(memory_meshes, original_count);
+    uint32_t* twins =
+        LetoMalloc(memory_meshes, original_count * sizeof(uint32_t));
+    SplitVertices_(mesh, indices, handedness, used, twins);
+    LetoFree(handedness);
+
+    // A vertex that wasn't split keeps whichever handedness its corners
+    // had, right-handed if none had any.
+    mesh->tangents =
+        LetoMalloc(memory_meshes, mesh->vertex_count * sizeof(vec4));
+    for (size_t i = 0; i < original_count; i++)
+    {
+        const float* normal = mesh->vertices[i].normal;
+        const bool left_handed = used[i] == 2;
+        FinishTangent_(sums[i * 2 + left_handed], normal, left_handed,
+                       mesh->tangents[i]);
+        if (twins[i] != UINT32_MAX)
+            FinishTangent_(sums[i * 2 + 1], normal, true,
+                           mesh->tangents[twins[i]]);
+    }
+    LetoFree(used);
+    LetoFree(twins);
+    LetoFree(sums);
+
+    // Splitting can push a mesh past what 16-bit indices can reach.
+    if (mesh->index_size == sizeof(uint16_t) &&
+        mesh->vertex_count > UINT16_MAX + 1)
+    {
+        LetoFree(mesh->indices);
+        mesh->indices = indices;
+        mesh->index_size = sizeof(uint32_t);
+        return;
+    }
+    if (mesh->index_size == sizeof(uint32_t))
+        (void)memcpy(mesh->indices, indices,
+                     mesh->index_count * sizeof(uint32_t));
+    else
+        for (size_t i = 0; i < mesh->index_count; i++)
+            ((uint16_t*)mesh->indices)[i] = (uint16_t)indices[i];
+    LetoFree(indices);
+}
@@ -0,0 +1,63 @@
+/**
+ * @file Tangents.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the generation of per-vertex tangent frames for imported
+ * meshes, following the conventions of MikkTSpace, which most normal
+ * maps are baked against, without being bit-exact with it.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__TANGENTS__
+#define __LETO__TANGENTS__
+
+// Imported meshes.
+#include <resources/meshes.h>
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Give a mesh's vertices tangents following MikkTSpace's
+ * conventions. Each triangle's texture-space U direction is projected
+ * onto the plane of each corner's normal, and these are summed per
+ * vertex weighted by the angle of the corner. The handedness of a
+ * tangent comes from the winding of its triangles in texture space; a
+ * vertex shared by triangles of both handednesses, like one on the seam
+ * of a mirrored UV layout, is split in two so each keeps its own frame.
+ * The per-triangle work runs on four triangles at a time, one per SIMD
+ * lane. Unlike MikkTSpace, vertices are only ever split on handedness,
+ * never on diverging tangents, so results can differ from a baker's
+ * where a vertex's triangles disagree sharply, and in the last bits
+ * elsewhere.
+ *
+ * PARAMETERS
+ *
+ * @param mesh The mesh. Meshes that already have tangents or an LOD chain
+ * are left alone, as are meshes without any texture coordinates.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the mesh is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoGenerateTangents(mesh_t* mesh);
+
+#endif // __LETO__TANGENTS__
@@ -0,0 +1,204 @@
+/**
+ * @file Uniforms.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Uniforms.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "uniforms.h"    // Public interface parent
+#include <gl.h>          // OpenGL function pointers
+#include <io/reporter.h> // Error / warning reporter
+#include <string.h>      // Memcmp, memcpy
+
+/**
+ * @brief Check whether a uniform of a type can be set by the int setter.
+ */
+static bool IntLike_(GLenum type)
+{
+    if (type == GL_FLOAT || type == GL_UNSIGNED_INT) return false;
+    return LetoUniformSize(type) == sizeof(int32_t);
+}
+
+/**
+ * @brief Upload a value to a uniform of a program, by the setter's type.
+ */
+static void Upload_(GLuint program, GLint location, GLenum type,
+                    const void* value)
+{
+    switch (type)
+    {
+        case GL_FLOAT:
+            glProgramUniform1fv(program, location, 1, value);
+            break;
+        case GL_INT:
+            glProgramUniform1iv(program, location, 1, value);
+            break;
+        case GL_UNSIGNED_INT:
+            glProgramUniform1uiv(program, location, 1, value);
+            break;
+        case GL_FLOAT_VEC2:
+            glProgramUniform2fv(program, location, 1, value);
+            break;
+        case GL_FLOAT_VEC3:
+            glProgramUniform3fv(program, location, 1, value);
+            break;
+        case GL_FLOAT_VEC4:
+            glProgramUniform4fv(program, location, 1, value);
+            break;
+        case GL_FLOAT_MAT3:
+            glProgramUniformMatrix3fv(program, location, 1, GL_FALSE,
+                                      value);
+            break;
+        case GL_FLOAT_MAT4:
+            glProgramUniformMatrix4fv(program, location, 1, GL_FALSE,
+                                      value);
+            break;
+        default: break;
+    }
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Check a value against a uniform's shadow in a program, and
+ * record and upload it there if it's new.
+ *
+ * PARAMETERS
+ *
+ * @param reflection The program's reflection.
+ * @param program The program.
+ * @param id The uniform's id, or NULL to find it by location.
+ * @param location The uniform's location, used if the id is NULL.
+ * @param type The type of the setter; GL_INT stands in for every type the
+ * int setter takes.
+ * @param value The value.
+ * @param size The size of the value.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the value was uploaded.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning invalid_param -- If the uniform isn't of the given type, this
+ * warning is thrown and false is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool Shadow_(shader_reflection_t* reflection, GLuint program,
+                    resource_id_t id, GLint location, GLenum type,
+                    const void* value, size_t size)
+{
+    shader_resource_t* uniform =
+        id != NULL ? LetoFindResource(reflection, resource_uniform, id)
+                   : LetoFindUniformAt(reflection, location);
+    if (uniform == NULL || uniform->location == -1) return false;
+    if (type == GL_INT ? !IntLike_(uniform->type) : uniform->type != type)
+    {
+        LetoReport(invalid_param);
+        return false;
+    }
+
+    uint8_t* shadow = reflection->shadow + uniform->offset;
+    if (uniform->shadowed && memcmp(shadow, value, size) == 0)
+        return false;
+    (void)memcpy(shadow, value, size);
+    uniform->shadowed = true;
+    Upload_(program, uniform->location, type, value);
+    return true;
+}
+
+/**
+ * @brief Set a uniform of a shader, by id or, if that's NULL, location. A
+ * separable shader's uniform is set in every stage that declares it, as
+ * each is a program of its own.
+ */
+static bool Set_(shader_t* shader, resource_id_t id, GLint location,
+                 GLenum type, const void* value, size_t size)
+{
+    if (shader == NULL || value == NULL)
+    {
+        LetoReport(null_param);
+        return false;
+    }
+    if (!(shader->permutation & SHADER_SEPARABLE))
+        return Shadow_(&shader->reflection, shader->id, id, location, type,
+                       value, size);
+
+    bool uploaded = false;
+    for (size_t i = 0; i < SHADER_MAX_STAGES; i++)
+    {
+        shader_stage_t* stage = shader->stages[i];
+        if (stage == NULL) continue;
+        uploaded |= Shadow_(&stage->reflection, stage->id, id, location,
+                            type, value, size);
+    }
+    return uploaded;
+}
+
+bool LetoSetUniformFloat(shader_t* shader, resource_id_t id, float value)
+{
+    return Set_(shader, id, -1, GL_FLOAT, &value, sizeof(value));
+}
+
+bool LetoSetUniformInt(shader_t* shader, resource_id_t id, int32_t value)
+{
+    return Set_(shader, id, -1, GL_INT, &value, sizeof(value));
+}
+
+bool LetoSetUniformUint(shader_t* shader, resource_id_t id,
+                        uint32_t value)
+{
+    return Set_(shader, id, -1, GL_UNSIGNED_INT, &value, sizeof(value));
+}
+
+bool LetoSetUniformVec2(shader_t* shader, resource_id_t id,
+                        const float value[2])
+{
+    return Set_(shader, id, -1, GL_FLOAT_VEC2, value, 2 * sizeof(float));
+}
+
+bool LetoSetUniformVec3(shader_t* shader, resource_id_t id,
+                        const float value[3])
+{
+    return Set_(shader, id, -1, GL_FLOAT_VEC3, value, 3 * sizeof(float));
+}
+
+bool LetoSetUniformVec3At(shader_t* shader, int32_t location,
+                          const float value[3])
+{
+    return Set_(shader, NULL, location, GL_FLOAT_VEC3, value,
+                3 * sizeof(float));
+}
+
+bool LetoSetUniformVec4(shader_t* shader, resource_id_t id,
+                        const float value[4])
+{
+    return Set_(shader, id, -1, GL_FLOAT_VEC4, value, 4 * sizeof(float));
+}
+
+bool LetoSetUniformMat3(shader_t* shader, resource_id_t id,
+                        const float value[9])
+{
+    return Set_(shader, id, -1, GL_FLOAT_MAT3, value, 9 * sizeof(float));
+}
+
+bool LetoSetUniformMat4(shader_t* shader, resource_id_t id,
+                        const float value[16])
+{
+    return Set_(shader, id, -1, GL_FLOAT_MAT4, value, 16 * sizeof(float));
+}
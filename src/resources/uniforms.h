@@ -0,0 +1,118 @@
+/**
+ * @file Uniforms.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides typed setters for the uniforms of a shader's default
+ * block. Uniforms are found by id in the shader's reflection rather than
+ * by asking the driver, and each setter remembers what it last uploaded,
+ * so setting a uniform to the value it already holds costs nothing. Every
+ * upload goes straight to the shader's program, so it needn't be in use;
+ * a separable shader's uniforms are set in each stage declaring them.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__UNIFORMS__
+#define __LETO__UNIFORMS__
+
+// The boolean type as described by the C standard.
+#include <stdbool.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+// Shaders and their reflection.
+#include <resources/shaders.h>
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Set a float uniform. The other setters, for every type Leto can
+ * set, work the same way; each only sets uniforms of its own type, and
+ * array uniforms have their first element set.
+ *
+ * PARAMETERS
+ *
+ * @param shader The shader.
+ * @param id The uniform's id, see @ref LetoResourceId.
+ * @param value The value.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the value was uploaded. Values the uniform
+ * already holds aren't, nor are values for uniforms the shader doesn't
+ * have, as happens to uniforms the driver found unused.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If the shader or value is NULL, this warning is
+ * thrown and false is returned.
+ * @warning invalid_param -- If the uniform isn't of the setter's type,
+ * this warning is thrown and false is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+bool LetoSetUniformFloat(shader_t* shader, resource_id_t id, float value);
+
+/**
+ * @brief Set an int, bool, sampler or image uniform. See @ref
+ * LetoSetUniformFloat.
+ */
+bool LetoSetUniformInt(shader_t* shader, resource_id_t id, int32_t value);
+
+/**
+ * @brief Set an unsigned int uniform. See @ref LetoSetUniformFloat.
+ */
+bool LetoSetUniformUint(shader_t* shader, resource_id_t id,
+                        uint32_t value);
+
+/**
+ * @brief Set a vec2 uniform. See @ref LetoSetUniformFloat.
+ */
+bool LetoSetUniformVec2(shader_t* shader, resource_id_t id,
+                        const float value[2]);
+
+/**
+ * @brief Set a vec3 uniform. See @ref LetoSetUniformFloat.
+ */
+bool LetoSetUniformVec3(shader_t* shader, resource_id_t id,
+                        const float value[3]);
+
+/**
+ * @brief Set a vec3 uniform by the location its shader gives it with
+ * layout(location = N), for uniforms whose names can't be relied on, as
+ * SPIR-V programs needn't keep them. See @ref LetoSetUniformFloat.
+ */
+bool LetoSetUniformVec3At(shader_t* shader, int32_t location,
+                          const float value[3]);
+
+/**
+ * @brief Set a vec4 uniform. See @ref LetoSetUniformFloat.
+ */
+bool LetoSetUniformVec4(shader_t* shader, resource_id_t id,
+                        const float value[4]);
+
+/**
+ * @brief Set a mat3 uniform from a column-major matrix, like CGLM's. See
+ * @ref LetoSetUniformFloat.
+ */
+bool LetoSetUniformMat3(shader_t* shader, resource_id_t id,
+                        const float value[9]);
+
+/**
+ * @brief Set a mat4 uniform from a column-major matrix, like CGLM's. See
+ * @ref LetoSetUniformFloat.
+ */
+bool LetoSetUniformMat4(shader_t* shader, resource_id_t id,
+                        const float value[16]);
+
+#endif // __LETO__UNIFORMS__
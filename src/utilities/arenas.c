@@ -0,0 +1,301 @@
+/**
+ * @file Arenas.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Arenas.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "arenas.h"              // Public interface parent
+#include <diagnostic/platform.h> // Platform macros
+#include <io/reporter.h>         // Error / warning reporter
+#include <stdbool.h>             // Boolean type
+
+#if defined(__LETO__LINUX__)
+    #include <inttypes.h> // Pointer scanning macros
+    #include <stdio.h>    // Reading /proc/self/smaps
+    #include <sys/mman.h> // mmap, madvise
+#elif defined(__LETO__WINDOWS__)
+    #define WIN32_LEAN_AND_MEAN
+    #include <Windows.h>
+#endif
+
+/**
+ * @brief Round a value up to the next multiple of a power-of-two
+ * alignment.
+ */
+#define ALIGN_UP(value, alignment)                                        \
+    (((value) + ((alignment) - 1)) & ~((size_t)(alignment) - 1))
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Reserve (but don't commit) a range of address space aligned to
+ * @ref ARENA_COMMIT_SIZE. On Linux we over-reserve by one chunk and trim
+ * the ends, as mmap only guarantees page alignment.
+ *
+ * PARAMETERS
+ *
+ * @param size The size of the range. This must be a multiple of @ref
+ * ARENA_COMMIT_SIZE.
+ *
+ * RETURN VALUE
+ *
+ * @return The start of the reserved range.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * One error can be thrown by this function.
+ * @exception failed_buffer -- If the range can't be reserved, this error
+ * is thrown and the process exits.
+ *
+ */
+static uint8_t* ReserveRange_(size_t size)
+{
+#if defined(__LETO__LINUX__)
+    const size_t padded = size + ARENA_COMMIT_SIZE;
+    uint8_t* raw =
+        mmap(NULL, padded, PROT_NONE,
+             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (raw == MAP_FAILED) LetoReport(failed_buffer);
+
+    uint8_t* base =
+        (uint8_t*)ALIGN_UP((uintptr_t)raw, (uintptr_t)ARENA_COMMIT_SIZE);
+    if (base != raw) (void)munmap(raw, (size_t)(base - raw));
+    if (raw + padded != base + size)
+        (void)munmap(base + size, (size_t)(raw + padded - (base + size)));
+    return base;
+#elif defined(__LETO__WINDOWS__)
+    // Windows reservations are already 64KB aligned, and large pages need
+    // a privilege most users won't have, so there's nothing to align to.
+    uint8_t* base = VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+    if (base == NULL) LetoReport(failed_buffer);
+    return base;
+#endif
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Commit the next chunk of an arena's range. We first ask for
+ * explicit huge pages, which fails up front if the system's huge page pool
+ * is empty. Once that fails we stop asking, and commit regular pages with
+ * a transparent huge page hint instead.
+ *
+ * PARAMETERS
+ *
+ * @param arena The arena to grow.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * One error can be thrown by this function.
+ * @exception failed_buffer -- If the chunk can't be committed at all, this
+ * error is thrown and the process exits.
+ *
+ */
+static void CommitChunk_(arena_t* arena)
+{
+    uint8_t* chunk = arena->base + arena->committed;
+
+#if defined(__LETO__LINUX__)
+    static bool hugetlb_exhausted = false;
+    #if defined(MAP_HUGETLB)
+    if (!hugetlb_exhausted)
+    {
+        void* mapped =
+            mmap(chunk, ARENA_COMMIT_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | MAP_HUGETLB, -1,
+                 0);
+        if (mapped != MAP_FAILED)
+        {
+            arena->hugetlb_committed += ARENA_COMMIT_SIZE;
+            return;
+        }
+        hugetlb_exhausted = true;
+    }
+    #endif
+
+    // Map over the chunk again, which works whether the failed attempt
+    // above left our reservation in place or not.
+    void* mapped = mmap(chunk, ARENA_COMMIT_SIZE, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+    if (mapped == MAP_FAILED) LetoReport(failed_buffer);
+    #if defined(MADV_HUGEPAGE)
+    // Failing this just means transparent huge pages are disabled.
+    (void)madvise(chunk, ARENA_COMMIT_SIZE, MADV_HUGEPAGE);
+    #endif
+#elif defined(__LETO__WINDOWS__)
+    if (VirtualAlloc(chunk, ARENA_COMMIT_SIZE, MEM_COMMIT,
+                     PAGE_READWRITE) == NULL)
+        LetoReport(failed_buffer);
+#endif
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Sum how much of a range is backed by transparent huge pages, as
+ * reported by the kernel. Every mapping in /proc/self/smaps that overlaps
+ * the range contributes its AnonHugePages count.
+ *
+ * PARAMETERS
+ *
+ * @param start The start of the range.
+ * @param size The size of the range.
+ *
+ * RETURN VALUE
+ *
+ * @return The amount of bytes backed by transparent huge pages, or 0 if
+ * the information isn't available.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static size_t GetTransparentHugeBytes_(const uint8_t* start, size_t size)
+{
+#if defined(__LETO__LINUX__)
+    FILE* smaps = fopen("/proc/self/smaps", "r");
+    if (smaps == NULL) return 0;
+
+    const uintptr_t range_start = (uintptr_t)start,
+                    range_end = range_start + size;
+    bool overlapping = false;
+    size_t huge_bytes = 0;
+    char line[256];
+
+    while (fgets(line, sizeof(line), smaps) != NULL)
+    {
+        uintptr_t mapping_start, mapping_end;
+        size_t kilobytes;
+
+        // Mapping headers are the only lines that start with an address
+        // range, so this doubles as the line type check.
+        if (sscanf(line, "%" SCNxPTR "-%" SCNxPTR, &mapping_start,
+                   &mapping_end) == 2)
+            overlapping =
+                mapping_start < range_end && mapping_end > range_start;
+        else if (overlapping &&
+                 sscanf(line, "AnonHugePages: %zu kB", &kilobytes) == 1)
+            huge_bytes += kilobytes * 1024;
+    }
+
+    (void)fclose(smaps);
+    return huge_bytes;
+#elif defined(__LETO__WINDOWS__)
+    (void)start;
+    (void)size;
+    return 0;
+#endif
+}
+
+arena_t* LetoCreateArena(memory_tag_t tag, size_t reserve_size)
+{
+    if (reserve_size == 0)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+
+    arena_t* arena = LetoMalloc(tag, sizeof(arena_t));
+    *arena = (arena_t){NULL, ALIGN_UP(reserve_size, ARENA_COMMIT_SIZE), 0,
+                       0, 0, tag};
+    arena->base = ReserveRange_(arena->reserved);
+    return arena;
+}
+
+void LetoDestroyArena(arena_t* arena)
+{
+    if (arena == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+#if defined(__LETO__LINUX__)
+    (void)munmap(arena->base, arena->reserved);
+#elif defined(__LETO__WINDOWS__)
+    (void)VirtualFree(arena->base, 0, MEM_RELEASE);
+#endif
+    for (size_t i = 0; i < arena->committed; i += ARENA_COMMIT_SIZE)
+        LetoRefundMemory(arena->tag, ARENA_COMMIT_SIZE);
+    LetoFree(arena);
+}
+
+void* LetoArenaAllocate(arena_t* arena, size_t size, size_t alignment)
+{
+    if (arena == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+    if (alignment == 0) alignment = 1;
+
+    const size_t offset = ALIGN_UP(arena->used, alignment);
+    if (offset > arena->reserved || size > arena->reserved - offset)
+    {
+        LetoReport(array_full);
+        return NULL;
+    }
+
+    const size_t end = offset + size;
+    while (arena->committed < end)
+    {
+        CommitChunk_(arena);
+        arena->committed += ARENA_COMMIT_SIZE;
+        LetoChargeMemory(arena->tag, ARENA_COMMIT_SIZE);
+    }
+
+    arena->used = end;
+    return arena->base + offset;
+}
+
+void LetoResetArena(arena_t* arena)
+{
+    if (arena == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+    arena->used = 0;
+}
+
+void LetoGetArenaStats(const arena_t* arena, arena_stats_t* stats)
+{
+    if (arena == NULL || stats == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    *stats = (arena_stats_t){
+        arena->reserved, arena->committed, arena->used,
+        arena->hugetlb_committed +
+            GetTransparentHugeBytes_(arena->base, arena->committed)};
+}
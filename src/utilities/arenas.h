@@ -0,0 +1,246 @@
+/**
+ * @file Arenas.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides bump-pointer arenas over large reserved virtual ranges.
+ * Memory is committed lazily in huge-page-sized chunks, each of which is
+ * backed by huge pages where the platform allows it. These are meant for
+ * big, long-lived asset buffers like mesh data and streamed world chunks.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__ARENAS__
+#define __LETO__ARENAS__
+
+// Standard macro definitions, like size_t.
+#include <stddef.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+// Memory tags for usage accounting.
+#include <utilities/memory.h>
+
+/**
+ * @brief The granularity arenas commit memory in. This is the size of a
+ * huge page on x86_64, so each chunk can be backed by exactly one.
+ */
+#define ARENA_COMMIT_SIZE (2u * 1024u * 1024u)
+
+/**
+ * @brief A structure describing a reserved range of address space that is
+ * handed out front to back.
+ */
+typedef struct
+{
+    /**
+     * @brief The start of the reserved range. This is aligned to @ref
+     * ARENA_COMMIT_SIZE.
+     */
+    uint8_t* base;
+    /**
+     * @brief The size of the reserved range.
+     */
+    size_t reserved;
+    /**
+     * @brief The amount of bytes committed from the start of the range.
+     */
+    size_t committed;
+    /**
+     * @brief The amount of bytes handed out from the start of the range.
+     */
+    size_t used;
+    /**
+     * @brief The amount of committed bytes explicitly backed by hugetlbfs
+     * pages (MAP_HUGETLB). Transparent huge pages are polled separately,
+     * see @ref LetoGetArenaStats.
+     */
+    size_t hugetlb_committed;
+    /**
+     * @brief The subsystem committed memory is charged to.
+     */
+    memory_tag_t tag;
+} arena_t;
+
+/**
+ * @brief A snapshot of an arena's state.
+ */
+typedef struct
+{
+    /**
+     * @brief The size of the reserved range.
+     */
+    size_t reserved;
+    /**
+     * @brief The amount of bytes committed.
+     */
+    size_t committed;
+    /**
+     * @brief The amount of bytes handed out.
+     */
+    size_t used;
+    /**
+     * @brief The amount of committed bytes the kernel actually backs with
+     * huge pages, be they hugetlbfs or transparent.
+     */
+    size_t huge_backed;
+} arena_stats_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Reserve a range of address space for an arena. Nothing is
+ * committed (and no physical memory is used) until it's allocated from.
+ *
+ * PARAMETERS
+ *
+ * @param tag The subsystem committed memory is charged to.
+ * @param reserve_size The size of the range to reserve. This is rounded
+ * up to @ref ARENA_COMMIT_SIZE, and is the most the arena can ever hold.
+ *
+ * RETURN VALUE
+ *
+ * @return The newly created arena, to be freed with @ref
+ * LetoDestroyArena.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the reserve size is 0, this warning is thrown
+ * and NULL is returned.
+ *
+ * ERRORS
+ *
+ * One error can be thrown by this function.
+ * @exception failed_buffer -- If the address space can't be reserved, this
+ * error is thrown and the process exits.
+ *
+ */
+arena_t* LetoCreateArena(memory_tag_t tag, size_t reserve_size);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Release an arena's reserved range and everything allocated from
+ * it.
+ *
+ * PARAMETERS
+ *
+ * @param arena The arena to destroy.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the arena is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoDestroyArena(arena_t* arena);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Allocate from an arena, committing more of its range if needed.
+ * Each newly committed chunk first tries explicit huge pages, and falls
+ * back to regular pages with a transparent huge page hint.
+ *
+ * PARAMETERS
+ *
+ * @param arena The arena to allocate from.
+ * @param size The size of the allocation.
+ * @param alignment The alignment of the allocation. This must be a power
+ * of two.
+ *
+ * RETURN VALUE
+ *
+ * @return The allocated block, or NULL if the arena is exhausted. Freshly
+ * committed memory is zeroed.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If the arena is NULL, this warning is thrown and
+ * NULL is returned.
+ * @warning array_full -- If the allocation doesn't fit in the reserved
+ * range, this warning is thrown and NULL is returned.
+ *
+ * ERRORS
+ *
+ * One error can be thrown by this function.
+ * @exception failed_buffer -- If the platform refuses to commit memory,
+ * this error is thrown and the process exits.
+ *
+ */
+void* LetoArenaAllocate(arena_t* arena, size_t size, size_t alignment);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Rewind an arena to empty. Committed memory stays committed, so
+ * refilling the arena doesn't fault its pages in again.
+ *
+ * PARAMETERS
+ *
+ * @param arena The arena to reset.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the arena is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoResetArena(arena_t* arena);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Get a snapshot of an arena's state. On Linux, how much of the
+ * arena is backed by transparent huge pages is read from
+ * /proc/self/smaps, so this isn't something to call every frame.
+ *
+ * PARAMETERS
+ *
+ * @param arena The arena to poll.
+ * @param stats The storage to write the snapshot into.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If either parameter is NULL, this warning is
+ * thrown and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoGetArenaStats(const arena_t* arena, arena_stats_t* stats);
+
+#endif // __LETO__ARENAS__
@@ -0,0 +1,265 @@
+/**
+ * @file Memory.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Memory.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "memory.h"            // Public interface parent
+#include <io/reporter.h>       // Error / warning reporter
+#include <stdbool.h>           // Boolean type
+#include <stdio.h>             // Standard I/O functionality
+#include <stdlib.h>            // Malloc, realloc, free
+#include <string.h>            // Memcpy, memset
+#include <utilities/threads.h> // Atomic counters
+
+/**
+ * @brief The size reserved in front of every block for its header. This
+ * is kept at 16 so blocks stay as aligned as malloc made them.
+ */
+#define HEADER_SIZE 16
+
+/**
+ * @brief The header stored directly in front of every block.
+ */
+typedef struct
+{
+    /**
+     * @brief The size of the block as requested by the caller.
+     */
+    size_t size;
+    /**
+     * @brief The tag the block is charged to.
+     */
+    uint16_t tag;
+    /**
+     * @brief The alignment the block was requested with, or 0 if it came
+     * from plain @ref LetoMalloc.
+     */
+    uint16_t alignment;
+    /**
+     * @brief The distance between the start of the underlying allocation
+     * and the block. This is @ref HEADER_SIZE for everything but aligned
+     * blocks.
+     */
+    uint32_t offset;
+} header_t;
+
+/**
+ * @brief The counters of a single tag. These are only ever touched
+ * atomically, so allocation from any thread is safe.
+ */
+typedef struct
+{
+    volatile int64_t bytes;
+    volatile int64_t count;
+    volatile int64_t peak;
+    volatile int64_t allocations;
+    volatile int64_t budget;
+} tag_counters_t;
+
+/**
+ * @brief The counters of every tag.
+ */
+static tag_counters_t counters[memory_tag_count] = {0};
+
+/**
+ * @brief The printable names of every tag.
+ */
+static const char* const tag_names[memory_tag_count] = {
+    "general", "strings", "files", "shaders", "meshes", "renderer",
+};
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Get the header of a block.
+ *
+ * PARAMETERS
+ *
+ * @param block The block whose header we want.
+ *
+ * RETURN VALUE
+ *
+ * @return A pointer to the block's header.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static header_t* GetHeader_(void* block)
+{
+    return (header_t*)((uint8_t*)block - HEADER_SIZE);
+}
+
+/**
+ * @brief Add to or take from the bytes held under a tag, keeping its peak
+ * and warning the first time its budget is crossed.
+ */
+static void AddBytes_(tag_counters_t* tag_counters, int64_t change)
+{
+    const int64_t bytes = LetoAtomicAdd(&tag_counters->bytes, change);
+    LetoAtomicMax(&tag_counters->peak, bytes);
+
+    const int64_t budget = LetoAtomicLoad(&tag_counters->budget);
+    if (budget != 0 && bytes > budget && bytes - change <= budget)
+        LetoReport(memory_budget);
+}
+
+void LetoChargeMemory(memory_tag_t tag, size_t size)
+{
+    if (tag >= memory_tag_count) tag = memory_general;
+
+    tag_counters_t* tag_counters = &counters[tag];
+    (void)LetoAtomicAdd(&tag_counters->count, 1);
+    (void)LetoAtomicAdd(&tag_counters->allocations, 1);
+    AddBytes_(tag_counters, (int64_t)size);
+}
+
+void LetoRefundMemory(memory_tag_t tag, size_t size)
+{
+    if (tag >= memory_tag_count) tag = memory_general;
+
+    (void)LetoAtomicAdd(&counters[tag].bytes, -(int64_t)size);
+    (void)LetoAtomicAdd(&counters[tag].count, -1);
+}
+
+void* LetoMalloc(memory_tag_t tag, size_t size)
+{
+    if (tag >= memory_tag_count) tag = memory_general;
+
+    uint8_t* allocation = malloc(size + HEADER_SIZE);
+    if (allocation == NULL) LetoReport(failed_buffer);
+
+    void* block = allocation + HEADER_SIZE;
+    *GetHeader_(block) = (header_t){size, (uint16_t)tag, 0, HEADER_SIZE};
+    LetoChargeMemory(tag, size);
+    return block;
+}
+
+void* LetoCalloc(memory_tag_t tag, size_t count, size_t size)
+{
+    if (size != 0 && count > SIZE_MAX / size) LetoReport(failed_buffer);
+
+    void* block = LetoMalloc(tag, count * size);
+    (void)memset(block, 0, count * size);
+    return block;
+}
+
+void* LetoMallocAligned(memory_tag_t tag, size_t size, size_t alignment)
+{
+    if (tag >= memory_tag_count) tag = memory_general;
+    if (alignment < HEADER_SIZE) alignment = HEADER_SIZE;
+    if (alignment > UINT16_MAX) LetoReport(failed_buffer);
+
+    uint8_t* allocation = malloc(size + alignment + HEADER_SIZE);
+    if (allocation == NULL) LetoReport(failed_buffer);
+
+    // Leave room for the header, then round up to the alignment.
+    uintptr_t address = (uintptr_t)allocation + HEADER_SIZE;
+    address = (address + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+    void* block = (void*)address;
+    *GetHeader_(block) =
+        (header_t){size, (uint16_t)tag, (uint16_t)alignment,
+                   (uint32_t)(address - (uintptr_t)allocation)};
+    LetoChargeMemory(tag, size);
+    return block;
+}
+
+void* LetoRealloc(void* block, size_t size)
+{
+    if (block == NULL) return LetoMalloc(memory_general, size);
+
+    header_t header = *GetHeader_(block);
+    uint8_t* allocation = (uint8_t*)block - header.offset;
+
+    // Aligned blocks can't be handed to realloc, as it may not preserve
+    // their alignment. These are rare enough to just copy.
+    if (header.alignment != 0)
+    {
+        void* resized =
+            LetoMallocAligned(header.tag, size, header.alignment);
+        (void)memcpy(resized, block,
+                     size < header.size ? size : header.size);
+        LetoFree(block);
+        // The copy is still the same block, not another allocation.
+        (void)LetoAtomicAdd(&counters[header.tag].allocations, -1);
+        return resized;
+    }
+
+    uint8_t* resized = realloc(allocation, size + HEADER_SIZE);
+    if (resized == NULL) LetoReport(failed_buffer);
+
+    AddBytes_(&counters[header.tag], (int64_t)size - (int64_t)header.size);
+    GetHeader_(resized + HEADER_SIZE)->size = size;
+    return resized + HEADER_SIZE;
+}
+
+void LetoFree(void* block)
+{
+    if (block == NULL) return;
+
+    const header_t* header = GetHeader_(block);
+    LetoRefundMemory(header->tag, header->size);
+    free((uint8_t*)block - header->offset);
+}
+
+void LetoSetMemoryBudget(memory_tag_t tag, size_t budget)
+{
+    if (tag >= memory_tag_count) return;
+    counters[tag].budget = (int64_t)budget;
+}
+
+void LetoGetMemoryStats(memory_tag_t tag, memory_stats_t* stats)
+{
+    if (stats == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+    if (tag >= memory_tag_count) tag = memory_general;
+
+    tag_counters_t* tag_counters = &counters[tag];
+    *stats = (memory_stats_t){
+        (size_t)LetoAtomicLoad(&tag_counters->bytes),
+        (size_t)LetoAtomicLoad(&tag_counters->count),
+        (size_t)LetoAtomicLoad(&tag_counters->peak),
+        (size_t)LetoAtomicLoad(&tag_counters->allocations),
+        (size_t)LetoAtomicLoad(&tag_counters->budget),
+    };
+}
+
+void LetoReportMemory(void)
+{
+    bool leaked = false;
+
+    printf("\n%-10s %12s %8s %12s %12s %12s\n", "tag", "bytes", "blocks",
+           "peak", "allocations", "budget");
+    for (size_t i = 0; i < memory_tag_count; i++)
+    {
+        memory_stats_t stats;
+        LetoGetMemoryStats((memory_tag_t)i, &stats);
+        printf("%-10s %12zu %8zu %12zu %12zu %12zu\n", tag_names[i],
+               stats.bytes, stats.count, stats.peak, stats.allocations,
+               stats.budget);
+        if (stats.count != 0) leaked = true;
+    }
+
+    if (leaked) LetoReport(memory_leak);
+}
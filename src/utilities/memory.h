@@ -0,0 +1,348 @@
+/**
+ * @file Memory.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides Leto's tracking allocator. Every engine allocation is
+ * tagged with the subsystem that owns it, so usage, peaks, budgets and
+ * leaks can be reported per subsystem.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__MEMORY__
+#define __LETO__MEMORY__
+
+// Standard macro definitions, like size_t.
+#include <stddef.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+
+/**
+ * @brief An enumerator describing each subsystem memory can be charged to.
+ */
+typedef enum
+{
+    memory_general,
+    memory_strings,
+    memory_files,
+    memory_shaders,
+    memory_meshes,
+    memory_renderer,
+    /**
+     * @defgroup Tag counter.
+     */
+    memory_tag_count,
+} memory_tag_t;
+
+/**
+ * @brief A snapshot of the statistics recorded for a single tag.
+ */
+typedef struct
+{
+    /**
+     * @brief The amount of bytes currently allocated.
+     */
+    size_t bytes;
+    /**
+     * @brief The amount of blocks currently allocated.
+     */
+    size_t count;
+    /**
+     * @brief The largest amount of bytes ever allocated at once.
+     */
+    size_t peak;
+    /**
+     * @brief The amount of allocations made over the whole session.
+     */
+    size_t allocations;
+    /**
+     * @brief The budget of the tag in bytes, or 0 if it has none.
+     */
+    size_t budget;
+} memory_stats_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Allocate a block of memory charged to the given tag. Every block
+ * carries a small header recording its size and tag, so it can be freed
+ * and accounted for without the caller remembering either.
+ *
+ * PARAMETERS
+ *
+ * @param tag The subsystem the block is charged to.
+ * @param size The size of the block in bytes.
+ *
+ * RETURN VALUE
+ *
+ * @return The allocated block, to be freed with @ref LetoFree.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning memory_budget -- If this allocation pushes the tag over its
+ * budget, this warning is thrown. The allocation still succeeds.
+ *
+ * ERRORS
+ *
+ * One error can be thrown by this function.
+ * @exception failed_buffer -- If the allocation fails, this error is
+ * thrown and the process exits.
+ *
+ */
+void* LetoMalloc(memory_tag_t tag, size_t size);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Allocate a zeroed array charged to the given tag.
+ *
+ * PARAMETERS
+ *
+ * @param tag The subsystem the block is charged to.
+ * @param count The amount of elements in the array.
+ * @param size The size of a single element.
+ *
+ * RETURN VALUE
+ *
+ * @return The allocated block, to be freed with @ref LetoFree.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ * @note For warnings unhandled by this function, see @ref LetoMalloc.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For errors unhandled by this function, see @ref LetoMalloc.
+ *
+ */
+void* LetoCalloc(memory_tag_t tag, size_t count, size_t size);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Allocate a block aligned to the given boundary, charged to the
+ * given tag.
+ *
+ * PARAMETERS
+ *
+ * @param tag The subsystem the block is charged to.
+ * @param size The size of the block in bytes.
+ * @param alignment The alignment of the block. This must be a power of
+ * two.
+ *
+ * RETURN VALUE
+ *
+ * @return The allocated block, to be freed with @ref LetoFree.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ * @note For warnings unhandled by this function, see @ref LetoMalloc.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For errors unhandled by this function, see @ref LetoMalloc.
+ *
+ */
+void* LetoMallocAligned(memory_tag_t tag, size_t size, size_t alignment);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Resize a block allocated by this interface. The block keeps its
+ * tag, and a resize changes its tag's bytes and peak without counting as
+ * another allocation. Passing NULL allocates a new block charged to @ref
+ * memory_general, so blocks owned by another tag start with @ref
+ * LetoMalloc.
+ *
+ * PARAMETERS
+ *
+ * @param block The block to resize.
+ * @param size The new size of the block in bytes.
+ *
+ * RETURN VALUE
+ *
+ * @return The resized block. The old pointer must no longer be used.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ * @note For warnings unhandled by this function, see @ref LetoMalloc.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For errors unhandled by this function, see @ref LetoMalloc.
+ *
+ */
+void* LetoRealloc(void* block, size_t size);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Free a block allocated by this interface. NULL is ignored.
+ *
+ * PARAMETERS
+ *
+ * @param block The block to free.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoFree(void* block);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Charge memory that didn't come from this allocator, like mapped
+ * address ranges, to a tag. Every call counts as one block.
+ *
+ * PARAMETERS
+ *
+ * @param tag The tag to charge.
+ * @param size The amount of bytes to charge.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning memory_budget -- If this charge pushes the tag over its
+ * budget, this warning is thrown.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoChargeMemory(memory_tag_t tag, size_t size);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Refund memory previously charged with @ref LetoChargeMemory.
+ *
+ * PARAMETERS
+ *
+ * @param tag The tag to refund.
+ * @param size The amount of bytes to refund.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoRefundMemory(memory_tag_t tag, size_t size);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Set the budget of a tag. Allocations that push the tag over its
+ * budget report a warning, but are never refused.
+ *
+ * PARAMETERS
+ *
+ * @param tag The tag to budget.
+ * @param budget The budget in bytes, or 0 to remove it.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoSetMemoryBudget(memory_tag_t tag, size_t budget);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Get a snapshot of the statistics recorded for a tag.
+ *
+ * PARAMETERS
+ *
+ * @param tag The tag to poll.
+ * @param stats The storage to write the snapshot into.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the storage is NULL, this warning is thrown
+ * and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoGetMemoryStats(memory_tag_t tag, memory_stats_t* stats);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Print the statistics of every tag. When called at shutdown, any
+ * bytes still allocated are leaks and are reported as such.
+ *
+ * PARAMETERS
+ *
+ * Nothing of note.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning memory_leak -- If any tag still has memory allocated, this
+ * warning is thrown after the report is printed.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoReportMemory(void);
+
+#endif // __LETO__MEMORY__
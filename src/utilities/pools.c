@@ -0,0 +1,416 @@
+/**
+ * @file Pools.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Pools.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "pools.h"       // Public interface parent
+#include <io/reporter.h> // Error / warning reporter
+#include <stdalign.h>    // alignof
+#include <string.h>      // Memset
+
+/**
+ * @brief Round a value up to the next multiple of a power-of-two
+ * alignment.
+ */
+#define ALIGN_UP(value, alignment)                                        \
+    (((value) + ((alignment) - 1)) & ~((size_t)(alignment) - 1))
+
+/**
+ * @brief Get the slab a slot index lives in.
+ */
+#define SLAB_OF(pool, index)                                              \
+    (&(pool)->slabs[(index) >> (pool)->slab_shift])
+
+/**
+ * @brief Get the offset of a slot index within its slab.
+ */
+#define SLOT_OF(pool, index)                                              \
+    ((index) & ((UINT32_C(1) << (pool)->slab_shift) - 1))
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Allocate a new slab and push all of its slots onto the free
+ * list. The pool lock must be held.
+ *
+ * PARAMETERS
+ *
+ * @param pool The pool to grow.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not a slab could be added.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning array_full -- If the pool already owns @ref POOL_MAX_SLABS
+ * slabs, this warning is thrown and false is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For errors unhandled by this function, see @ref
+ * LetoMallocAligned.
+ *
+ */
+static bool AddSlab_(pool_t* pool)
+{
+    if (pool->slab_count == POOL_MAX_SLABS)
+    {
+        LetoReport(array_full);
+        return false;
+    }
+
+    const uint32_t capacity = UINT32_C(1) << pool->slab_shift;
+    const size_t objects_size =
+        ALIGN_UP(pool->stride * capacity, LETO_CACHE_LINE_SIZE);
+    const size_t metadata_size = sizeof(uint32_t) * capacity * 2;
+
+    uint8_t* block = LetoMallocAligned(
+        pool->tag, objects_size + metadata_size, LETO_CACHE_LINE_SIZE);
+    pool_slab_t* slab = &pool->slabs[pool->slab_count];
+    slab->objects = block;
+    slab->generations = (uint32_t*)(block + objects_size);
+    slab->next_free = slab->generations + capacity;
+
+    // Link the slots in ascending order so allocations walk the slab
+    // front to back.
+    const uint32_t base = pool->slab_count << pool->slab_shift;
+    for (uint32_t i = 0; i < capacity; i++)
+    {
+        slab->generations[i] = 1;
+        slab->next_free[i] = base + i + 1;
+    }
+    slab->next_free[capacity - 1] = pool->free_head;
+    pool->free_head = base;
+
+    // Lock-free readers only look at slabs below the count, so it's
+    // published after the slab is filled in.
+    LetoAtomicRelease(&pool->slab_count, pool->slab_count + 1);
+    return true;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Pop a slot off of the pool's free list, growing the pool if
+ * needed. The pool lock must be held.
+ *
+ * PARAMETERS
+ *
+ * @param pool The pool to pop from.
+ *
+ * RETURN VALUE
+ *
+ * @return The popped slot index, or @ref POOL_END_OF_LIST if the pool is
+ * full.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ * @note For warnings unhandled by this function, see @ref AddSlab_.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For errors unhandled by this function, see @ref AddSlab_.
+ *
+ */
+static uint32_t PopSlot_(pool_t* pool)
+{
+    if (pool->free_head == POOL_END_OF_LIST && !AddSlab_(pool))
+        return POOL_END_OF_LIST;
+
+    const uint32_t slot = pool->free_head;
+    pool->free_head =
+        SLAB_OF(pool, slot)->next_free[SLOT_OF(pool, slot)];
+    pool->occupied += 1;
+    return slot;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Push a slot back onto the pool's free list. The pool lock must be
+ * held.
+ *
+ * PARAMETERS
+ *
+ * @param pool The pool to push to.
+ * @param slot The slot index to push.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static void PushSlot_(pool_t* pool, uint32_t slot)
+{
+    SLAB_OF(pool, slot)->next_free[SLOT_OF(pool, slot)] = pool->free_head;
+    pool->free_head = slot;
+    pool->occupied -= 1;
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Hand out a popped slot: zero its object and build its handle.
+ *
+ * PARAMETERS
+ *
+ * @param pool The pool the slot belongs to.
+ * @param slot The slot index.
+ *
+ * RETURN VALUE
+ *
+ * @return The handle of the slot's object.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static pool_handle_t ClaimSlot_(pool_t* pool, uint32_t slot)
+{
+    pool_slab_t* slab = SLAB_OF(pool, slot);
+    const uint32_t offset = SLOT_OF(pool, slot);
+
+    (void)memset(slab->objects + pool->stride * offset, 0, pool->stride);
+    return (pool_handle_t){slot, slab->generations[offset]};
+}
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Invalidate a handle by bumping its slot's generation. Generation
+ * 0 is skipped on wraparound so it stays reserved for @ref
+ * POOL_NULL_HANDLE.
+ *
+ * PARAMETERS
+ *
+ * @param pool The pool the handle belongs to.
+ * @param handle The handle to retire.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the handle was live before retiring it.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning stale_handle -- If the handle was already dead, this warning is
+ * thrown and false is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+static bool RetireHandle_(pool_t* pool, pool_handle_t handle)
+{
+    if (!LetoPoolValid(pool, handle))
+    {
+        LetoReport(stale_handle);
+        return false;
+    }
+
+    uint32_t* generation = &SLAB_OF(pool, handle.index)
+                                ->generations[SLOT_OF(pool, handle.index)];
+    uint32_t next = *generation + 1;
+    if (next == 0) next = 1;
+    LetoAtomicRelease(generation, next);
+    return true;
+}
+
+pool_t* LetoCreatePool(memory_tag_t tag, size_t object_size,
+                       uint32_t slab_capacity)
+{
+    if (object_size == 0 || slab_capacity == 0)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+
+    pool_t* pool = LetoCalloc(tag, 1, sizeof(pool_t));
+    pool->tag = tag;
+    pool->stride = ALIGN_UP(object_size, alignof(max_align_t));
+    while ((UINT32_C(1) << pool->slab_shift) < slab_capacity &&
+           pool->slab_shift < 31)
+        pool->slab_shift += 1;
+    pool->free_head = POOL_END_OF_LIST;
+    LetoCreateMutex(&pool->lock);
+
+    return pool;
+}
+
+void LetoDestroyPool(pool_t* pool)
+{
+    if (pool == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    for (uint32_t i = 0; i < pool->slab_count; i++)
+        LetoFree(pool->slabs[i].objects);
+    LetoDestroyMutex(&pool->lock);
+    LetoFree(pool);
+}
+
+pool_handle_t LetoPoolAllocate(pool_t* pool)
+{
+    if (pool == NULL)
+    {
+        LetoReport(null_param);
+        return POOL_NULL_HANDLE;
+    }
+
+    LetoLockMutex(&pool->lock);
+    const uint32_t slot = PopSlot_(pool);
+    LetoUnlockMutex(&pool->lock);
+
+    if (slot == POOL_END_OF_LIST) return POOL_NULL_HANDLE;
+    return ClaimSlot_(pool, slot);
+}
+
+void LetoPoolFree(pool_t* pool, pool_handle_t handle)
+{
+    if (pool == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+    if (!RetireHandle_(pool, handle)) return;
+
+    LetoLockMutex(&pool->lock);
+    PushSlot_(pool, handle.index);
+    LetoUnlockMutex(&pool->lock);
+}
+
+void* LetoPoolGet(const pool_t* pool, pool_handle_t handle)
+{
+    if (pool == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+    if (!LetoPoolValid(pool, handle))
+    {
+        LetoReport(stale_handle);
+        return NULL;
+    }
+
+    return SLAB_OF(pool, handle.index)->objects +
+           pool->stride * SLOT_OF(pool, handle.index);
+}
+
+bool LetoPoolValid(const pool_t* pool, pool_handle_t handle)
+{
+    if (pool == NULL || handle.generation == 0) return false;
+    // Pairs with the release in AddSlab_, so the slab's pointers and
+    // generations are seen filled in even while another thread grows the
+    // pool.
+    if ((handle.index >> pool->slab_shift) >=
+        LetoAtomicAcquire(&pool->slab_count))
+        return false;
+
+    return LetoAtomicAcquire(&SLAB_OF(pool, handle.index)
+                                  ->generations[SLOT_OF(
+                                      pool, handle.index)]) ==
+           handle.generation;
+}
+
+void LetoCreatePoolCache(pool_t* pool, pool_cache_t* cache)
+{
+    if (pool == NULL || cache == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    cache->pool = pool;
+    cache->count = 0;
+}
+
+pool_handle_t LetoPoolAllocateC(pool_cache_t* cache)
+{
+    if (cache == NULL || cache->pool == NULL)
+    {
+        LetoReport(null_param);
+        return POOL_NULL_HANDLE;
+    }
+
+    if (cache->count == 0)
+    {
+        LetoLockMutex(&cache->pool->lock);
+        while (cache->count < POOL_CACHE_SIZE / 2)
+        {
+            const uint32_t slot = PopSlot_(cache->pool);
+            if (slot == POOL_END_OF_LIST) break;
+            cache->slots[cache->count++] = slot;
+        }
+        LetoUnlockMutex(&cache->pool->lock);
+
+        if (cache->count == 0) return POOL_NULL_HANDLE;
+    }
+
+    cache->count -= 1;
+    return ClaimSlot_(cache->pool, cache->slots[cache->count]);
+}
+
+void LetoPoolFreeC(pool_cache_t* cache, pool_handle_t handle)
+{
+    if (cache == NULL || cache->pool == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+    if (!RetireHandle_(cache->pool, handle)) return;
+
+    cache->slots[cache->count++] = handle.index;
+    if (cache->count < POOL_CACHE_SIZE) return;
+
+    LetoLockMutex(&cache->pool->lock);
+    while (cache->count > POOL_CACHE_SIZE / 2)
+        PushSlot_(cache->pool, cache->slots[--cache->count]);
+    LetoUnlockMutex(&cache->pool->lock);
+}
+
+void LetoFlushPoolCache(pool_cache_t* cache)
+{
+    if (cache == NULL || cache->pool == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    LetoLockMutex(&cache->pool->lock);
+    while (cache->count > 0)
+        PushSlot_(cache->pool, cache->slots[--cache->count]);
+    LetoUnlockMutex(&cache->pool->lock);
+}
@@ -0,0 +1,472 @@
+/**
+ * @file Pools.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides a fixed-size object pool allocator. Objects live in
+ * cache-line-aligned slabs and are referred to by generation-counted
+ * handles, so a handle to a freed object is caught instead of silently
+ * aliasing whatever took its place.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__POOLS__
+#define __LETO__POOLS__
+
+// The boolean type as described by the C standard.
+#include <stdbool.h>
+// Standard macro definitions, like size_t.
+#include <stddef.h>
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+// Tagged allocations for slab storage.
+#include <utilities/memory.h>
+// Mutexes for the shared free list.
+#include <utilities/threads.h>
+
+/**
+ * @brief The assumed size of a cache line on the host machine. Slabs are
+ * aligned to this boundary.
+ */
+#define LETO_CACHE_LINE_SIZE 64
+
+/**
+ * @brief The maximum amount of slabs a single pool can own. A pool's
+ * capacity is this multiplied by its slab capacity.
+ */
+#define POOL_MAX_SLABS 256
+
+/**
+ * @brief The amount of free slots a per-thread pool cache can hold. Caches
+ * refill and flush half of this at a time.
+ */
+#define POOL_CACHE_SIZE 32
+
+/**
+ * @brief The free list link marking the end of the list.
+ */
+#define POOL_END_OF_LIST UINT32_MAX
+
+/**
+ * @brief A handle to an object within a pool. The generation is bumped
+ * every time the slot is freed, so stale handles can be detected.
+ * Generation 0 is never handed out, making a zeroed handle invalid.
+ */
+typedef struct
+{
+    /**
+     * @brief The slot index of the object within its pool.
+     */
+    uint32_t index;
+    /**
+     * @brief The generation of the slot when this handle was created.
+     */
+    uint32_t generation;
+} pool_handle_t;
+
+/**
+ * @brief A handle guaranteed to never refer to a live object.
+ */
+#define POOL_NULL_HANDLE                                                  \
+    (pool_handle_t) { 0, 0 }
+
+/**
+ * @brief A single slab of pool storage. The object array, generation
+ * counters and free list links are all carved out of one cache-aligned
+ * allocation.
+ */
+typedef struct
+{
+    /**
+     * @brief The densely packed objects of the slab.
+     */
+    uint8_t* objects;
+    /**
+     * @brief The generation counter of each slot within the slab.
+     */
+    uint32_t* generations;
+    /**
+     * @brief The intrusive free list link of each slot within the slab.
+     */
+    uint32_t* next_free;
+} pool_slab_t;
+
+/**
+ * @brief A structure describing a pool of identically sized objects.
+ */
+typedef struct
+{
+    /**
+     * @brief Every slab the pool has allocated. Slabs are never moved or
+     * freed until the pool is destroyed, so object pointers stay valid for
+     * the lifetime of their handle.
+     */
+    pool_slab_t slabs[POOL_MAX_SLABS];
+    /**
+     * @brief The size of each object, rounded up to keep every object
+     * suitably aligned.
+     */
+    size_t stride;
+    /**
+     * @brief The base-2 logarithm of the amount of objects in a slab.
+     */
+    uint32_t slab_shift;
+    /**
+     * @brief The amount of slabs currently allocated. It's only raised
+     * under the lock, and with release semantics after the new slab is
+     * filled in, so lock-free readers that load it with acquire semantics
+     * only ever see complete slabs.
+     */
+    uint32_t slab_count;
+    /**
+     * @brief The first slot of the free list, or @ref POOL_END_OF_LIST.
+     */
+    uint32_t free_head;
+    /**
+     * @brief The amount of slots currently handed out, including those
+     * sitting in per-thread caches.
+     */
+    uint32_t occupied;
+    /**
+     * @brief The subsystem the pool's memory is charged to.
+     */
+    memory_tag_t tag;
+    /**
+     * @brief The lock guarding the free list and slab table.
+     */
+    mutex_t lock;
+} pool_t;
+
+/**
+ * @brief A per-thread cache of free slots. Allocating and freeing through
+ * a cache only touches the shared pool (and its lock) once every @ref
+ * POOL_CACHE_SIZE / 2 operations. A cache must only be used by one thread.
+ */
+typedef struct
+{
+    /**
+     * @brief The pool this cache draws from.
+     */
+    pool_t* pool;
+    /**
+     * @brief The amount of cached free slots.
+     */
+    uint32_t count;
+    /**
+     * @brief The cached free slot indices.
+     */
+    uint32_t slots[POOL_CACHE_SIZE];
+} pool_cache_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Create a pool of fixed-size objects. No slabs are allocated until
+ * the first object is.
+ *
+ * PARAMETERS
+ *
+ * @param tag The subsystem the pool's memory is charged to.
+ * @param object_size The size of every object within the pool.
+ * @param slab_capacity The amount of objects per slab. This is rounded up
+ * to the next power of two.
+ *
+ * RETURN VALUE
+ *
+ * @return The newly created pool, to be freed with @ref LetoDestroyPool.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If either parameter is 0, this warning is thrown
+ * and NULL is returned.
+ *
+ * ERRORS
+ *
+ * One error can be thrown by this function.
+ * @exception failed_buffer -- If we fail to allocate the pool, this error
+ * is thrown and the process exits.
+ *
+ */
+pool_t* LetoCreatePool(memory_tag_t tag, size_t object_size,
+                       uint32_t slab_capacity);
+
+/**
+ * @brief Create a pool whose objects are of the given type.
+ */
+#define LetoCreatePoolT(tag, type, slab_capacity)                         \
+    LetoCreatePool(tag, sizeof(type), slab_capacity)
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Destroy a pool and every slab it owns. All handles into the pool
+ * become invalid, and all pointers into it dangle.
+ *
+ * PARAMETERS
+ *
+ * @param pool The pool to destroy.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the pool is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoDestroyPool(pool_t* pool);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Allocate a zeroed object from the pool in O(1). A new slab is
+ * allocated if the free list is empty.
+ *
+ * PARAMETERS
+ *
+ * @param pool The pool to allocate from.
+ *
+ * RETURN VALUE
+ *
+ * @return A handle to the new object, or @ref POOL_NULL_HANDLE if
+ * something went wrong.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If the pool is NULL, this warning is thrown and
+ * a null handle is returned.
+ * @warning array_full -- If the pool already owns @ref POOL_MAX_SLABS
+ * slabs, this warning is thrown and a null handle is returned.
+ *
+ * ERRORS
+ *
+ * One error can be thrown by this function.
+ * @exception failed_buffer -- If we fail to allocate a new slab, this
+ * error is thrown and the process exits.
+ *
+ */
+pool_handle_t LetoPoolAllocate(pool_t* pool);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Return an object to its pool in O(1). The handle, and any other
+ * copies of it, are invalidated.
+ *
+ * PARAMETERS
+ *
+ * @param pool The pool the object was allocated from.
+ * @param handle The handle of the object to free.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If the pool is NULL, this warning is thrown and
+ * nothing is done.
+ * @warning stale_handle -- If the handle has already been freed (or never
+ * came from this pool), this warning is thrown and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoPoolFree(pool_t* pool, pool_handle_t handle);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Resolve a handle into a pointer to its object. This takes no
+ * lock, and is safe while other threads allocate from (and grow) the
+ * pool; freeing the same handle on another thread at the same time is
+ * not, as the object is gone either way.
+ *
+ * PARAMETERS
+ *
+ * @param pool The pool the object was allocated from.
+ * @param handle The handle of the object.
+ *
+ * RETURN VALUE
+ *
+ * @return A pointer to the object, or NULL if the handle is stale.
+ *
+ * WARNINGS
+ *
+ * Two warnings can be thrown by this function.
+ * @warning null_param -- If the pool is NULL, this warning is thrown and
+ * NULL is returned.
+ * @warning stale_handle -- If the handle's object has been freed, this
+ * warning is thrown and NULL is returned.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void* LetoPoolGet(const pool_t* pool, pool_handle_t handle);
+
+/**
+ * @brief Resolve a handle into a pointer of the pool's object type.
+ */
+#define LetoPoolGetT(type, pool, handle)                                  \
+    ((type*)LetoPoolGet(pool, handle))
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Check whether or not a handle still refers to a live object,
+ * without reporting anything.
+ *
+ * PARAMETERS
+ *
+ * @param pool The pool the object was allocated from.
+ * @param handle The handle to check.
+ *
+ * RETURN VALUE
+ *
+ * @return Whether or not the handle is live.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+bool LetoPoolValid(const pool_t* pool, pool_handle_t handle);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Bind a per-thread cache to a pool. The cache starts empty.
+ *
+ * PARAMETERS
+ *
+ * @param pool The pool the cache will draw from.
+ * @param cache The cache to initialize.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If either parameter is NULL, this warning is
+ * thrown and nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoCreatePoolCache(pool_t* pool, pool_cache_t* cache);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Allocate a zeroed object through a per-thread cache. This is the
+ * same as @ref LetoPoolAllocate, except the pool lock is only taken when
+ * the cache runs dry.
+ *
+ * PARAMETERS
+ *
+ * @param cache The cache to allocate through.
+ *
+ * RETURN VALUE
+ *
+ * @return A handle to the new object, or @ref POOL_NULL_HANDLE if
+ * something went wrong.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ * @note For warnings unhandled by this function, see @ref
+ * LetoPoolAllocate.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ * @note For errors unhandled by this function, see @ref LetoPoolAllocate.
+ *
+ */
+pool_handle_t LetoPoolAllocateC(pool_cache_t* cache);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Free an object through a per-thread cache. The slot is kept in
+ * the cache for reuse, and only returned to the pool when the cache
+ * overflows or is flushed.
+ *
+ * PARAMETERS
+ *
+ * @param cache The cache to free through.
+ * @param handle The handle of the object to free.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ * @note For warnings unhandled by this function, see @ref LetoPoolFree.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoPoolFreeC(pool_cache_t* cache, pool_handle_t handle);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Return every slot held by a per-thread cache to its pool. This
+ * must be called before the owning thread exits or the pool is destroyed.
+ *
+ * PARAMETERS
+ *
+ * @param cache The cache to flush.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the cache is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoFlushPoolCache(pool_cache_t* cache);
+
+#endif // __LETO__POOLS__
@@ -1,27 +1,25 @@
 #include "strings.h"
 #include <io/reporter.h>
 #include <stdio.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <utilities/memory.h>
 
 char* LetoStringMalloc(size_t string_length)
 {
-    void* allocated = malloc(string_length + 1);
-    if (allocated == NULL) LetoReport(failed_buffer);
-    return allocated;
+    return LetoMalloc(memory_strings, string_length + 1);
 }
 
 char* LetoStringCalloc(size_t string_length)
 {
-    void* allocated = calloc(string_length + 1, 1);
-    if (allocated == NULL) LetoReport(failed_buffer);
-    return allocated;
+    return LetoCalloc(memory_strings, string_length + 1, 1);
 }
 
 void LetoStringFree(char** string)
 {
     if (*string == NULL) return;
-    free(*string);
+    LetoFree(*string);
     *string = NULL;
 }
 
@@ -40,11 +38,11 @@ void LetoSetStringF(bool warn_overcat, char** buffer,
         warn_overcat)
         LetoReport(small_buffer);
 
-    if (*buffer != NULL) free(*buffer);
+    if (*buffer != NULL) LetoFree(*buffer);
     *buffer = LetoStringMalloc(strlen(temp_buffer));
     strcpy(*buffer, temp_buffer);
 
-    free(temp_buffer);
+    LetoFree(temp_buffer);
     va_end(args);
 }
 
@@ -62,10 +60,7 @@ char* LetoStringCreate(size_t max_buffer_size, const char* format, ...)
         LetoReport(small_buffer);
     va_end(args);
 
-    // This whole block is to satisfy MSVC.
-    char* temp_buffer = realloc(buffer, strlen(buffer) + 1);
-    if (temp_buffer == NULL) LetoReport(failed_buffer);
-    buffer = temp_buffer;
+    buffer = LetoRealloc(buffer, strlen(buffer) + 1);
 
     return buffer;
 }
@@ -87,10 +82,7 @@ char* LetoStringCreateV(size_t max_buffer_size, const char* format,
         (size_t)attempted_characters > max_buffer_size)
         LetoReport(small_buffer);
 
-    // This whole block is to satisfy MSVC.
-    char* temp_buffer = realloc(buffer, strlen(buffer) + 1);
-    if (temp_buffer == NULL) LetoReport(failed_buffer);
-    buffer = temp_buffer;
+    buffer = LetoRealloc(buffer, strlen(buffer) + 1);
     return buffer;
 }
 
@@ -117,8 +109,8 @@ char** LetoStringSplit(char* string, char delimiter)
     // null string terminator
     delimiter_count++;
 
-    split_strings = malloc(sizeof(char*) * delimiter_count);
-    if (split_strings == NULL) LetoReport(failed_buffer);
+    split_strings =
+        LetoMalloc(memory_strings, sizeof(char*) * delimiter_count);
 
     size_t current_index = 0;
     char terminated_delimiter[2] = {delimiter, 0};
@@ -136,3 +128,109 @@ char** LetoStringSplit(char* string, char delimiter)
 
     return split_strings;
 }
+
+/**
+ * @brief An entry of the intern table. The hash is kept so that the table
+ * can grow without rehashing every string.
+ */
+typedef struct
+{
+    uint64_t hash;
+    char* string;
+} intern_entry_t;
+
+/**
+ * @brief The intern table, an open addressing hash set whose capacity is
+ * a power of two (or zero before the first string is interned).
+ */
+static intern_entry_t* intern_entries = NULL;
+static size_t intern_capacity = 0, intern_count = 0;
+
+static uint64_t HashString_(const char* string, size_t length)
+{
+    // FNV-1a, which is plenty for the short names we intern.
+    uint64_t hash = UINT64_C(0xCBF29CE484222325);
+    for (size_t i = 0; i < length; i++)
+        hash = (hash ^ (uint8_t)string[i]) * UINT64_C(0x100000001B3);
+    return hash;
+}
+
+static intern_entry_t* FindInternEntry_(const char* string, size_t length,
+                                        uint64_t hash)
+{
+    const size_t mask = intern_capacity - 1;
+    for (size_t i = (size_t)hash & mask;; i = (i + 1) & mask)
+    {
+        intern_entry_t* entry = &intern_entries[i];
+        if (entry->string == NULL) return entry;
+        if (entry->hash == hash &&
+            strncmp(entry->string, string, length) == 0 &&
+            entry->string[length] == '\0')
+            return entry;
+    }
+}
+
+static void GrowInternTable_(void)
+{
+    intern_entry_t* old_entries = intern_entries;
+    const size_t old_capacity = intern_capacity;
+
+    intern_capacity = old_capacity == 0 ? 64 : old_capacity * 2;
+    intern_entries = LetoCalloc(memory_strings, intern_capacity,
+                                sizeof(intern_entry_t));
+    for (size_t i = 0; i < old_capacity; i++)
+    {
+        if (old_entries[i].string == NULL) continue;
+        const size_t mask = intern_capacity - 1;
+        size_t slot = (size_t)old_entries[i].hash & mask;
+        while (intern_entries[slot].string != NULL)
+            slot = (slot + 1) & mask;
+        intern_entries[slot] = old_entries[i];
+    }
+    LetoFree(old_entries);
+}
+
+const char* LetoStringIntern(const char* string, size_t length)
+{
+    if (string == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+
+    // Keep the table under three quarters full.
+    if ((intern_count + 1) * 4 > intern_capacity * 3) GrowInternTable_();
+
+    const uint64_t hash = HashString_(string, length);
+    intern_entry_t* entry = FindInternEntry_(string, length, hash);
+    if (entry->string != NULL) return entry->string;
+
+    entry->hash = hash;
+    entry->string = LetoStringMalloc(length);
+    (void)memcpy(entry->string, string, length);
+    entry->string[length] = '\0';
+    intern_count++;
+    return entry->string;
+}
+
+const char* LetoStringFindInterned(const char* string, size_t length)
+{
+    if (string == NULL)
+    {
+        LetoReport(null_param);
+        return NULL;
+    }
+    if (intern_count == 0) return NULL;
+
+    return FindInternEntry_(string, length, HashString_(string, length))
+        ->string;
+}
+
+void LetoStringFreeInterned(void)
+{
+    for (size_t i = 0; i < intern_capacity; i++)
+        LetoFree(intern_entries[i].string);
+    LetoFree(intern_entries);
+    intern_entries = NULL;
+    intern_capacity = intern_count = 0;
+}
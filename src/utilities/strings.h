@@ -27,4 +27,22 @@ char* LetoStringCreateV(size_t max_buffer_size, const char* format,
 
 char** LetoStringSplit(char* string, char delimiter);
 
+/**
+ * @brief Get the one shared copy of a string, creating it if this is the
+ * first time it's been seen. Interned strings are equal if and only if
+ * their pointers are, and live until @ref LetoStringFreeInterned.
+ */
+const char* LetoStringIntern(const char* string, size_t length);
+
+/**
+ * @brief Get the shared copy of a string if it has been interned, without
+ * interning it. This returns NULL otherwise.
+ */
+const char* LetoStringFindInterned(const char* string, size_t length);
+
+/**
+ * @brief Free every interned string. None may be used afterward.
+ */
+void LetoStringFreeInterned(void);
+
 #endif // __LETO__STRINGS__
@@ -0,0 +1,200 @@
+/**
+ * @file Threads.c
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides the implementation of the public interface defined in
+ * @file Threads.h.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#include "threads.h"     // Public interface parent
+#include <io/reporter.h> // Error / warning reporter
+
+#if defined(__LETO__LINUX__)
+    #include <unistd.h> // Sysconf
+#elif defined(__LETO__WINDOWS__)
+    #define WIN32_LEAN_AND_MEAN
+    #include <Windows.h>
+#endif
+
+/**
+ * @brief Adapt the platform's thread entry point signature to @ref
+ * thread_function_t.
+ */
+#if defined(__LETO__LINUX__)
+static void* ThreadEntry_(void* thread)
+{
+    ((thread_t*)thread)->function(((thread_t*)thread)->argument);
+    return NULL;
+}
+#elif defined(__LETO__WINDOWS__)
+static DWORD WINAPI ThreadEntry_(LPVOID thread)
+{
+    ((thread_t*)thread)->function(((thread_t*)thread)->argument);
+    return 0;
+}
+#endif
+
+void LetoCreateMutex(mutex_t* mutex)
+{
+    if (mutex == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+#if defined(__LETO__LINUX__)
+    if (pthread_mutex_init(mutex, NULL) != 0) LetoReport(thread_error);
+#elif defined(__LETO__WINDOWS__)
+    InitializeSRWLock((PSRWLOCK)mutex);
+#endif
+}
+
+void LetoDestroyMutex(mutex_t* mutex)
+{
+    if (mutex == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+#if defined(__LETO__LINUX__)
+    (void)pthread_mutex_destroy(mutex);
+#elif defined(__LETO__WINDOWS__)
+    // SRW locks don't need to be destroyed.
+    (void)mutex;
+#endif
+}
+
+void LetoLockMutex(mutex_t* mutex)
+{
+#if defined(__LETO__LINUX__)
+    (void)pthread_mutex_lock(mutex);
+#elif defined(__LETO__WINDOWS__)
+    AcquireSRWLockExclusive((PSRWLOCK)mutex);
+#endif
+}
+
+void LetoUnlockMutex(mutex_t* mutex)
+{
+#if defined(__LETO__LINUX__)
+    (void)pthread_mutex_unlock(mutex);
+#elif defined(__LETO__WINDOWS__)
+    ReleaseSRWLockExclusive((PSRWLOCK)mutex);
+#endif
+}
+
+int64_t LetoAtomicAdd(volatile int64_t* target, int64_t value)
+{
+#if defined(__LETO__LINUX__)
+    return __atomic_add_fetch(target, value, __ATOMIC_RELAXED);
+#elif defined(__LETO__WINDOWS__)
+    return InterlockedExchangeAdd64((volatile LONG64*)target, value) +
+           value;
+#endif
+}
+
+void LetoAtomicMax(volatile int64_t* target, int64_t value)
+{
+    int64_t current = LetoAtomicLoad(target);
+    while (current < value)
+    {
+#if defined(__LETO__LINUX__)
+        if (__atomic_compare_exchange_n(target, &current, value, true,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED))
+            return;
+#elif defined(__LETO__WINDOWS__)
+        int64_t previous = InterlockedCompareExchange64(
+            (volatile LONG64*)target, value, current);
+        if (previous == current) return;
+        current = previous;
+#endif
+    }
+}
+
+int64_t LetoAtomicLoad(volatile int64_t* target)
+{
+#if defined(__LETO__LINUX__)
+    return __atomic_load_n(target, __ATOMIC_RELAXED);
+#elif defined(__LETO__WINDOWS__)
+    return InterlockedCompareExchange64((volatile LONG64*)target, 0, 0);
+#endif
+}
+
+uint32_t LetoAtomicAcquire(const volatile uint32_t* target)
+{
+#if defined(__LETO__LINUX__)
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#elif defined(__LETO__WINDOWS__)
+    return (uint32_t)InterlockedCompareExchange(
+        (volatile LONG*)target, 0, 0);
+#endif
+}
+
+void LetoAtomicRelease(volatile uint32_t* target, uint32_t value)
+{
+#if defined(__LETO__LINUX__)
+    __atomic_store_n(target, value, __ATOMIC_RELEASE);
+#elif defined(__LETO__WINDOWS__)
+    (void)InterlockedExchange((volatile LONG*)target, (LONG)value);
+#endif
+}
+
+void LetoCreateThread(thread_t* thread, thread_function_t function,
+                      void* argument)
+{
+    if (thread == NULL || function == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+    thread->function = function;
+    thread->argument = argument;
+#if defined(__LETO__LINUX__)
+    if (pthread_create(&thread->handle, NULL, ThreadEntry_, thread) != 0)
+        LetoReport(thread_error);
+#elif defined(__LETO__WINDOWS__)
+    thread->handle = CreateThread(NULL, 0, ThreadEntry_, thread, 0, NULL);
+    if (thread->handle == NULL) LetoReport(thread_error);
+#endif
+}
+
+void LetoJoinThread(thread_t* thread)
+{
+    if (thread == NULL)
+    {
+        LetoReport(null_param);
+        return;
+    }
+
+#if defined(__LETO__LINUX__)
+    (void)pthread_join(thread->handle, NULL);
+#elif defined(__LETO__WINDOWS__)
+    (void)WaitForSingleObject(thread->handle, INFINITE);
+    (void)CloseHandle(thread->handle);
+#endif
+}
+
+uint32_t LetoGetHardwareThreads(void)
+{
+#if defined(__LETO__LINUX__)
+    const long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count < 1 ? 1 : (uint32_t)count;
+#elif defined(__LETO__WINDOWS__)
+    SYSTEM_INFO information;
+    GetSystemInfo(&information);
+    return information.dwNumberOfProcessors < 1
+               ? 1
+               : (uint32_t)information.dwNumberOfProcessors;
+#endif
+}
@@ -0,0 +1,388 @@
+/**
+ * @file Threads.h
+ * @author Israfiel (https://github.com/israfiel-a)
+ * @brief Provides a thin, platform-independent wrapper around the
+ * threading primitives Leto needs, like mutexes. These should @b always be
+ * used in place of platform-specific versions.
+ * @date 2026-10-18
+ *
+ * @copyright (c) 2024 - the Leto Team
+ * This document is under the GNU Affero General Public License v3.0. It
+ * can be modified and distributed (commercially or otherwise) freely, and
+ * can be used privately and within patents. No liability or warranty is
+ * guaranteed. However, on use, the user must state license and copyright,
+ * any changes made, and disclose the source of the document. For more
+ * information see the @file LICENSE.md file included with this
+ * distribution of the Leto source code.
+ */
+
+#ifndef __LETO__THREADS__
+#define __LETO__THREADS__
+
+// Platform-decision macros.
+#include <diagnostic/platform.h>
+
+#if defined(__LETO__LINUX__)
+    #include <pthread.h>
+#endif
+
+// Fixed-width integers as described by the C standard.
+#include <stdint.h>
+
+/**
+ * @brief A mutual exclusion lock. On Linux this is a pthread mutex, on
+ * Windows it mirrors the layout of an SRWLOCK so we don't have to drag
+ * Windows.h into every file that includes this header.
+ */
+#if defined(__LETO__LINUX__)
+typedef pthread_mutex_t mutex_t;
+#elif defined(__LETO__WINDOWS__)
+typedef struct
+{
+    void* _p;
+} mutex_t;
+#endif
+
+/**
+ * @brief The entry point of a thread.
+ */
+typedef void (*thread_function_t)(void* argument);
+
+/**
+ * @brief A thread of execution. The structure must stay alive (and in
+ * place) until the thread is joined, as the thread reads its entry point
+ * out of it.
+ */
+typedef struct
+{
+    /**
+     * @brief The platform's handle to the thread.
+     */
+#if defined(__LETO__LINUX__)
+    pthread_t handle;
+#elif defined(__LETO__WINDOWS__)
+    void* handle;
+#endif
+    /**
+     * @brief The function the thread runs.
+     */
+    thread_function_t function;
+    /**
+     * @brief The argument passed to the function.
+     */
+    void* argument;
+} thread_t;
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Initialize a mutex. The mutex starts unlocked.
+ *
+ * PARAMETERS
+ *
+ * @param mutex The mutex to initialize.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * One error can be thrown by this function.
+ * @exception thread_error -- If the platform fails to create the mutex,
+ * this error is thrown and the process exits.
+ *
+ */
+void LetoCreateMutex(mutex_t* mutex);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Destroy a mutex previously initialized by @ref LetoCreateMutex.
+ * The mutex must not be locked.
+ *
+ * PARAMETERS
+ *
+ * @param mutex The mutex to destroy.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoDestroyMutex(mutex_t* mutex);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Lock a mutex, blocking until it becomes available.
+ *
+ * PARAMETERS
+ *
+ * @param mutex The mutex to lock.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoLockMutex(mutex_t* mutex);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Unlock a mutex previously locked by @ref LetoLockMutex on the
+ * same thread.
+ *
+ * PARAMETERS
+ *
+ * @param mutex The mutex to unlock.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoUnlockMutex(mutex_t* mutex);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Atomically add a value to a 64-bit integer. The operation is
+ * relaxed; it synchronizes nothing but the integer itself, which is all
+ * statistics counters need.
+ *
+ * PARAMETERS
+ *
+ * @param target The integer to add to.
+ * @param value The value to add. This may be negative.
+ *
+ * RETURN VALUE
+ *
+ * @return The value of the integer after the addition.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+int64_t LetoAtomicAdd(volatile int64_t* target, int64_t value);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Atomically raise a 64-bit integer to the given value, if the
+ * value is larger. This is used for high-water marks.
+ *
+ * PARAMETERS
+ *
+ * @param target The integer to raise.
+ * @param value The candidate maximum.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoAtomicMax(volatile int64_t* target, int64_t value);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Atomically load a 64-bit integer.
+ *
+ * PARAMETERS
+ *
+ * @param target The integer to load.
+ *
+ * RETURN VALUE
+ *
+ * @return The current value of the integer.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+int64_t LetoAtomicLoad(volatile int64_t* target);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Atomically load a 32-bit integer with acquire semantics. Every
+ * write made before the matching @ref LetoAtomicRelease store is seen
+ * after this load, which is how a lock-free reader sees a structure
+ * another thread published.
+ *
+ * PARAMETERS
+ *
+ * @param target The integer to load.
+ *
+ * RETURN VALUE
+ *
+ * @return The current value of the integer.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+uint32_t LetoAtomicAcquire(const volatile uint32_t* target);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Atomically store a 32-bit integer with release semantics,
+ * publishing every write made before it to threads that load the integer
+ * through @ref LetoAtomicAcquire.
+ *
+ * PARAMETERS
+ *
+ * @param target The integer to store to.
+ * @param value The value to store.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoAtomicRelease(volatile uint32_t* target, uint32_t value);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Start a thread running the given function.
+ *
+ * PARAMETERS
+ *
+ * @param thread The storage for the thread.
+ * @param function The function to run.
+ * @param argument The argument to pass to the function.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the thread or function is NULL, this warning
+ * is thrown and nothing is done.
+ *
+ * ERRORS
+ *
+ * One error can be thrown by this function.
+ * @exception thread_error -- If the platform fails to create the thread,
+ * this error is thrown and the process exits.
+ *
+ */
+void LetoCreateThread(thread_t* thread, thread_function_t function,
+                      void* argument);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Wait for a thread to finish and release it.
+ *
+ * PARAMETERS
+ *
+ * @param thread The thread to join.
+ *
+ * RETURN VALUE
+ *
+ * Nothing of note.
+ *
+ * WARNINGS
+ *
+ * One warning can be thrown by this function.
+ * @warning null_param -- If the thread is NULL, this warning is thrown and
+ * nothing is done.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+void LetoJoinThread(thread_t* thread);
+
+/**
+ * DESCRIPTION
+ *
+ * @brief Get the amount of hardware threads the process can run on.
+ *
+ * PARAMETERS
+ *
+ * Nothing of note.
+ *
+ * RETURN VALUE
+ *
+ * @return The amount of hardware threads. This is always at least 1.
+ *
+ * WARNINGS
+ *
+ * Nothing of note.
+ *
+ * ERRORS
+ *
+ * Nothing of note.
+ *
+ */
+uint32_t LetoGetHardwareThreads(void);
+
+#endif // __LETO__THREADS__